@@ -4,19 +4,25 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/Memory/AddressHash.cpp \
 ../src/Memory/IPKCacheBase.cpp \
 ../src/Memory/IPKCacheDirectMapped.cpp \
-../src/Memory/IPKCacheFullyAssociative.cpp 
+../src/Memory/IPKCacheFullyAssociative.cpp \
+../src/Memory/IPKCacheSetAssociative.cpp 
 
 OBJS += \
+./src/Memory/AddressHash.o \
 ./src/Memory/IPKCacheBase.o \
 ./src/Memory/IPKCacheDirectMapped.o \
-./src/Memory/IPKCacheFullyAssociative.o 
+./src/Memory/IPKCacheFullyAssociative.o \
+./src/Memory/IPKCacheSetAssociative.o 
 
 CPP_DEPS += \
+./src/Memory/AddressHash.d \
 ./src/Memory/IPKCacheBase.d \
 ./src/Memory/IPKCacheDirectMapped.d \
-./src/Memory/IPKCacheFullyAssociative.d 
+./src/Memory/IPKCacheFullyAssociative.d \
+./src/Memory/IPKCacheSetAssociative.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -5,16 +5,19 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../src/Tile/Core/Fetch/FetchStage.cpp \
+../src/Tile/Core/Fetch/IPKPrefetcher.cpp \
 ../src/Tile/Core/Fetch/InstructionPacketCache.cpp \
 ../src/Tile/Core/Fetch/InstructionPacketFIFO.cpp 
 
 OBJS += \
 ./src/Tile/Core/Fetch/FetchStage.o \
+./src/Tile/Core/Fetch/IPKPrefetcher.o \
 ./src/Tile/Core/Fetch/InstructionPacketCache.o \
 ./src/Tile/Core/Fetch/InstructionPacketFIFO.o 
 
 CPP_DEPS += \
 ./src/Tile/Core/Fetch/FetchStage.d \
+./src/Tile/Core/Fetch/IPKPrefetcher.d \
 ./src/Tile/Core/Fetch/InstructionPacketCache.d \
 ./src/Tile/Core/Fetch/InstructionPacketFIFO.d 
 
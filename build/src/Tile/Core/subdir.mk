@@ -8,6 +8,7 @@ CPP_SRCS += \
 ../src/Tile/Core/ControlRegisters.cpp \
 ../src/Tile/Core/Core.cpp \
 ../src/Tile/Core/MagicMemoryConnection.cpp \
+../src/Tile/Core/MemoryTraceInjector.cpp \
 ../src/Tile/Core/PipelineRegister.cpp \
 ../src/Tile/Core/PipelineStage.cpp \
 ../src/Tile/Core/PredicateRegister.cpp \
@@ -18,6 +19,7 @@ OBJS += \
 ./src/Tile/Core/ControlRegisters.o \
 ./src/Tile/Core/Core.o \
 ./src/Tile/Core/MagicMemoryConnection.o \
+./src/Tile/Core/MemoryTraceInjector.o \
 ./src/Tile/Core/PipelineRegister.o \
 ./src/Tile/Core/PipelineStage.o \
 ./src/Tile/Core/PredicateRegister.o \
@@ -28,6 +30,7 @@ CPP_DEPS += \
 ./src/Tile/Core/ControlRegisters.d \
 ./src/Tile/Core/Core.d \
 ./src/Tile/Core/MagicMemoryConnection.d \
+./src/Tile/Core/MemoryTraceInjector.d \
 ./src/Tile/Core/PipelineRegister.d \
 ./src/Tile/Core/PipelineStage.d \
 ./src/Tile/Core/PredicateRegister.d \
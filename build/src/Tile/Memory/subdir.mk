@@ -4,28 +4,37 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/Tile/Memory/DMAEngine.cpp \
 ../src/Tile/Memory/Directory.cpp \
 ../src/Tile/Memory/L2Logic.cpp \
 ../src/Tile/Memory/L2RequestFilter.cpp \
+../src/Tile/Memory/LastLevelCache.cpp \
 ../src/Tile/Memory/MemoryBank.cpp \
 ../src/Tile/Memory/MissHandlingLogic.cpp \
-../src/Tile/Memory/ReservationHandler.cpp 
+../src/Tile/Memory/ReservationHandler.cpp \
+../src/Tile/Memory/WriteBuffer.cpp 
 
 OBJS += \
+./src/Tile/Memory/DMAEngine.o \
 ./src/Tile/Memory/Directory.o \
 ./src/Tile/Memory/L2Logic.o \
 ./src/Tile/Memory/L2RequestFilter.o \
+./src/Tile/Memory/LastLevelCache.o \
 ./src/Tile/Memory/MemoryBank.o \
 ./src/Tile/Memory/MissHandlingLogic.o \
-./src/Tile/Memory/ReservationHandler.o 
+./src/Tile/Memory/ReservationHandler.o \
+./src/Tile/Memory/WriteBuffer.o 
 
 CPP_DEPS += \
+./src/Tile/Memory/DMAEngine.d \
 ./src/Tile/Memory/Directory.d \
 ./src/Tile/Memory/L2Logic.d \
 ./src/Tile/Memory/L2RequestFilter.d \
+./src/Tile/Memory/LastLevelCache.d \
 ./src/Tile/Memory/MemoryBank.d \
 ./src/Tile/Memory/MissHandlingLogic.d \
-./src/Tile/Memory/ReservationHandler.d 
+./src/Tile/Memory/ReservationHandler.d \
+./src/Tile/Memory/WriteBuffer.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -4,13 +4,16 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/Utility/Trace/Callgrind.cpp 
+../src/Utility/Trace/Callgrind.cpp \
+../src/Utility/Trace/MemoryTrace.cpp 
 
 OBJS += \
-./src/Utility/Trace/Callgrind.o 
+./src/Utility/Trace/Callgrind.o \
+./src/Utility/Trace/MemoryTrace.o 
 
 CPP_DEPS += \
-./src/Utility/Trace/Callgrind.d 
+./src/Utility/Trace/Callgrind.d \
+./src/Utility/Trace/MemoryTrace.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -32,6 +32,11 @@ uint Chip::computeTileIndex(TileID id) const {
   return ((id.y - 1) * (tiles.size() - 2)) + (id.x - 1);
 }
 
+TileID Chip::computeTileID(uint index) const {
+  uint columns = tiles.size() - 2;
+  return TileID((index % columns) + 1, (index / columns) + 1);
+}
+
 bool Chip::isCore(ComponentID id) const {
   return getTile(id.tile).isCore(id);
 }
@@ -74,10 +79,23 @@ void Chip::storeInstructions(vector<Word>& instructions, const ComponentID& comp
 }
 
 void Chip::storeData(const DataBlock& data) {
-  if (data.component() == ComponentID(2,0,0))
-    mainMemory.storeData(data.payload(), data.position(), data.readOnly());
-  else
+  if (data.component() == ComponentID(2,0,0)) {
+    if (data.hasPayload())
+      mainMemory.storeData(data.payload(), data.position(), data.readOnly(),
+                           data.executable());
+    else
+      mainMemory.storeData(data.rawData(), data.rawSize(), data.position(),
+                           data.readOnly(), data.executable());
+  }
+  else {
+    // Only main memory accepts raw data blocks.
+    loki_assert(data.hasPayload());
     getTile(data.component().tile).storeData(data);
+  }
+}
+
+void Chip::setUncached(MemoryAddr start, MemoryAddr end) {
+  mainMemory.setPageAttributes(start, end, MainMemory::PAGE_UNCACHED);
 }
 
 void Chip::print(const ComponentID& component, MemoryAddr start, MemoryAddr end) {
@@ -119,6 +137,10 @@ int Chip::readRegisterInternal(const ComponentID& component, RegisterIndex reg)
   return getTile(component.tile).readRegisterInternal(component, reg);
 }
 
+void Chip::countCoreEvent(const ComponentID& core, uint event) {
+  getTile(core.tile).countCoreEvent(core, event);
+}
+
 bool Chip::readPredicateInternal(const ComponentID& component) const {
   return getTile(component.tile).readPredicateInternal(component);
 }
@@ -148,7 +170,7 @@ bool Chip::backedByMainMemory(TileID tile, MemoryAddr address) const {
   // If the given tile is a memory controller, the result is trivial.
   // Otherwise, query the tile's directory to find details of the next level of
   // memory hierarchy.
-  if (memoryControllerPositions.find(tile) != memoryControllerPositions.end()) {
+  if (isMemoryController(tile)) {
     return true;
   }
   else if (isComputeTile(tile)) {
@@ -160,9 +182,41 @@ bool Chip::backedByMainMemory(TileID tile, MemoryAddr address) const {
   }
 }
 
+bool Chip::recallCacheLine(TileID tile, MemoryAddr address, bool invalidate) {
+  loki_assert(isComputeTile(tile));
+  Tile& t = getTile(tile);
+  return static_cast<ComputeTile&>(t).recallCacheLine(address, invalidate);
+}
 
-void Chip::magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload) {
-  magicMemory.operate(opcode, address, returnChannel, payload);
+void Chip::invalidateLastLevelCaches(MemoryAddr address) {
+  for (std::set<TileID>::iterator it=memoryControllerPositions.begin(); it!=memoryControllerPositions.end(); it++) {
+    Tile& t = getTile(*it);
+    static_cast<MemoryControllerTile&>(t).invalidateCachedLine(address);
+  }
+}
+
+
+void Chip::magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload,
+                             MemoryAccessMode mode, ComponentID bank) {
+  magicMemory.operate(opcode, address, returnChannel, payload, mode, bank);
+}
+
+MemoryBase& Chip::magicScratchpad(const ComponentID& bank) const {
+  loki_assert(isComputeTile(bank.tile));
+  Tile& t = getTile(bank.tile);
+  return static_cast<ComputeTile&>(t).memoryBank(bank);
+}
+
+void Chip::updateDirectoryEntry(TileID tile, MemoryAddr address, uint data) {
+  loki_assert(isComputeTile(tile));
+  Tile& t = getTile(tile);
+  static_cast<ComputeTile&>(t).updateDirectoryEntry(address, data);
+}
+
+void Chip::updateDirectoryMask(TileID tile, uint maskLSB) {
+  loki_assert(isComputeTile(tile));
+  Tile& t = getTile(tile);
+  static_cast<ComputeTile&>(t).updateDirectoryMask(maskLSB);
 }
 
 TileID Chip::nearestMemoryController(TileID tile) const {
@@ -184,6 +238,23 @@ TileID Chip::nearestMemoryController(TileID tile) const {
   return closest;
 }
 
+TileID Chip::memoryController(TileID tile, MemoryAddr address) const {
+  if (!mainMemory.interleaved())
+    return nearestMemoryController(tile);
+
+  uint channel = mainMemory.channel(address);
+  loki_assert(channel < memoryChannels.size());
+  return memoryChannels[channel];
+}
+
+bool Chip::isMemoryController(TileID tile) const {
+  return memoryControllerPositions.find(tile) != memoryControllerPositions.end();
+}
+
+bool Chip::memoryInterleaved() const {
+  return mainMemory.interleaved();
+}
+
 Tile& Chip::getTile(TileID tile) const {
   return tiles[tile.x][tile.y];
 }
@@ -223,9 +294,10 @@ void Chip::makeComponents(const chip_parameters_t& params) {
         t = new ComputeTile(name.str().c_str(), tileID, params.tile);
       }
       else if (memoryControllerPositions.find(TileID(col,row)) != memoryControllerPositions.end()) {
-        t = new MemoryControllerTile(name.str().c_str(), tileID);
+        t = new MemoryControllerTile(name.str().c_str(), tileID, params.memory);
 
         uint memoryPort = memoryControllersMade++;
+        memoryChannels.push_back(tileID);
         ((MemoryControllerTile*)t)->oRequestToMainMemory(mainMemory.iData[memoryPort]);
         ((MemoryControllerTile*)t)->iResponseFromMainMemory(mainMemory.oData[memoryPort]);
       }
@@ -266,7 +338,7 @@ Chip::Chip(const sc_module_name& name, const chip_parameters_t& params) :
     LokiComponent(name),
     memoryControllerPositions(getMemoryControllerPositions(params)),
     mainMemory("main_memory", memoryControllerPositions.size(), params.memory),
-    magicMemory("magic_memory", mainMemory),
+    magicMemory("magic_memory", mainMemory, params),
     dataNet("data_net", params.allTiles(), params.router),
     creditNet("credit_net", params.allTiles(), params.router),
     requestNet("request_net", params.allTiles(), params.router),
@@ -55,6 +55,7 @@ public:
   bool isComputeTile(TileID id) const;
   uint overallTileIndex(TileID id) const;
   uint computeTileIndex(TileID id) const;
+  TileID computeTileID(uint index) const;
   bool isCore(ComponentID id) const;
   bool isMemory(ComponentID id) const;
   uint globalComponentIndex(ComponentID id) const;
@@ -67,10 +68,21 @@ public:
   // given tile. This must happen after makeComponents().
   TileID  nearestMemoryController(TileID tile) const;
 
+  // The memory controller which should serve a request from `tile` to
+  // `address`. If main memory is interleaved, this is the controller which
+  // owns the address's channel, otherwise it is the nearest controller.
+  TileID  memoryController(TileID tile, MemoryAddr address) const;
+  bool    isMemoryController(TileID tile) const;
+  bool    memoryInterleaved() const;
+
   // Store the given instructions or data into the component at the given index.
   void    storeInstructions(vector<Word>& instructions, const ComponentID& component);
   void    storeData(const DataBlock& data);
 
+  // Perform word accesses and atomics to main memory addresses in
+  // [start, end) at main memory, bypassing the caches.
+  void    setUncached(MemoryAddr start, MemoryAddr end);
+
   void    print(const ComponentID& component, MemoryAddr start, MemoryAddr end);
   Word    readWordInternal(const ComponentID& component, MemoryAddr addr);
   Word    readByteInternal(const ComponentID& component, MemoryAddr addr);
@@ -81,6 +93,11 @@ public:
   void    networkSendDataInternal(const NetworkData& flit);
   void    networkSendCreditInternal(const NetworkCredit& flit);
 
+  // Notify a core's performance counters of an event which happened outside
+  // the core (e.g. in its L1 cache). `event` is a
+  // ControlRegisters::PerformanceEvent.
+  void    countCoreEvent(const ComponentID& core, uint event);
+
   // Each tile modifies the address of outgoing memory addresses. Determine the
   // ultimate address in main memory that this address maps to.
   MemoryAddr getAddressTranslation(TileID tile, MemoryAddr address) const;
@@ -90,7 +107,22 @@ public:
   // memory hierarchy.
   bool    backedByMainMemory(TileID tile, MemoryAddr address) const;
 
-  void    magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload = 0);
+  // Coherence: write back any dirty copy of the given main memory cache line
+  // held by a tile, and optionally invalidate it. Returns whether any dirty
+  // data was found.
+  bool    recallCacheLine(TileID tile, MemoryAddr address, bool invalidate);
+
+  // Discard all copies of a cache line held in last-level caches at the
+  // memory controllers.
+  void    invalidateLastLevelCaches(MemoryAddr address);
+
+  void    magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload = 0,
+                            MemoryAccessMode mode = MEMORY_CACHE, ComponentID bank = ComponentID());
+
+  // Zero-latency access to tile state, for use by magic memory.
+  MemoryBase& magicScratchpad(const ComponentID& bank) const;
+  void    updateDirectoryEntry(TileID tile, MemoryAddr address, uint data);
+  void    updateDirectoryMask(TileID tile, uint maskLSB);
 
 private:
 
@@ -114,6 +146,9 @@ private:
 
   const std::set<TileID> memoryControllerPositions;
 
+  // The memory controller connected to each of main memory's ports.
+  vector<TileID>         memoryChannels;
+
 //============================================================================//
 // Components
 //============================================================================//
@@ -134,6 +169,7 @@ private:
 
   friend class Tile;
   friend class ComputeTile;
+  friend class MemoryControllerTile;
 
 //============================================================================//
 // Signals (wires)
@@ -74,6 +74,7 @@ const ChannelID DecodedInst::networkDestination() const {
 
 MemoryAddr    DecodedInst::location()        const {return location_;}
 InstructionSource DecodedInst::source()      const {return source_;}
+ThreadIndex   DecodedInst::thread()          const {return thread_;}
 
 
 bool    DecodedInst::predicated() const {
@@ -197,6 +198,7 @@ void DecodedInst::portClaim(const bool val)               {portClaim_ = val;}
 
 void DecodedInst::location(const MemoryAddr val)          {location_ = val;}
 void DecodedInst::source(const InstructionSource val)     {source_ = val;}
+void DecodedInst::thread(const ThreadIndex val)           {thread_ = val;}
 
 
 Instruction DecodedInst::toInstruction() const {
@@ -340,6 +342,7 @@ void DecodedInst::init() {
   networkInfo       = 0;
   location_         = 0;
   source_           = UNKNOWN;
+  thread_           = 0;
   hasResult_        = false;
 }
 
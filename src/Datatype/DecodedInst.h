@@ -62,6 +62,7 @@ public:
   int64_t       result() const;
   MemoryAddr    location() const;
   InstructionSource source() const;
+  ThreadIndex   thread() const;
 
   EncodedCMTEntry cmtEntry() const;
   const ChannelID networkDestination() const;
@@ -100,6 +101,7 @@ public:
   void    result(const int64_t val);
   void    location(const MemoryAddr val);
   void    source(const InstructionSource val);
+  void    thread(const ThreadIndex val);
 
   void    persistent(const bool val);
   void    remoteExecute(const bool val);
@@ -206,6 +208,7 @@ private:
 
   MemoryAddr          location_;  // The position in memory that this instruction comes from.
   InstructionSource   source_;    // Was the instruction from L0 cache or FIFO?
+  ThreadIndex         thread_;    // The hardware thread which fetched this instruction.
 
   bool                persistent_;
   bool                forRemoteExecution_;
@@ -61,17 +61,18 @@ struct CoreMetadata {
 };
 
 struct MemoryMetadata {
-  unsigned int padding : 15;
+  unsigned int padding : 14;
   unsigned int returnTileX : 3;   // L2 mode only: tile of requesting L1 bank.
   unsigned int returnTileY : 3;   // L2 mode only: tile of requesting L1 bank.
-  unsigned int returnChannel : 3; // L1 mode: channel of core. L2 mode: bank of L1 tile.
+  unsigned int returnChannel : 4; // L1 mode: channel of core. L2 mode: bank of
+                                  // L1 tile, or DMA buffer after the banks.
   unsigned int scratchpad : 1;    // Treat memory as cache (0) or scratchpad (1).
   unsigned int skipL2 : 1;        // Bypass L2 and go straight to main memory.
   unsigned int skipL1 : 1;        // Bypass L1 and go straight to L2.
   MemoryOpcode opcode : 5;        // Operation to perform at memory.
 
   uint32_t flatten() const {
-    return (padding << 17) | (returnTileX << 14) | (returnTileY << 11) |
+    return (padding << 18) | (returnTileX << 15) | (returnTileY << 12) |
       (returnChannel << 8) | (scratchpad << 7) |
       (skipL2 << 6) | (skipL1 << 5) | (opcode << 0);
   }
@@ -83,10 +84,10 @@ struct MemoryMetadata {
   MemoryMetadata() : MemoryMetadata(0) {}
 
   MemoryMetadata(uint32_t flattened) {
-    padding = (flattened >> 17) & 0x7FFF;
-    returnTileX = (flattened >> 14) & 0x7;
-    returnTileY = (flattened >> 11) & 0x7;
-    returnChannel = (flattened >> 8) & 0x7;
+    padding = (flattened >> 18) & 0x3FFF;
+    returnTileX = (flattened >> 15) & 0x7;
+    returnTileY = (flattened >> 12) & 0x7;
+    returnChannel = (flattened >> 8) & 0xF;
     scratchpad = (flattened >> 7) & 0x1;
     skipL2 = (flattened >> 6) & 0x1;
     skipL1 = (flattened >> 5) & 0x1;
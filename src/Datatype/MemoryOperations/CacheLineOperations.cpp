@@ -237,3 +237,52 @@ void PushLine::assignToMemory(MemoryBase& memory, MemoryLevel level) {
 NetworkRequest PushLine::toFlit() const {
   return NetworkRequest(address+targetBank, ChannelID(), metadata.flatten());
 }
+
+
+// Drains are reported as STORE_LINE operations for statistics purposes.
+static MemoryMetadata drainMetadata(MemoryMetadata metadata) {
+  metadata.opcode = STORE_LINE;
+  return metadata;
+}
+
+DrainWriteBuffer::DrainWriteBuffer(const WriteBuffer::Entry& entry) :
+    MemoryOperation(entry.line, drainMetadata(entry.metadata),
+                    entry.returnAddress, MEMORY_WORD, ALIGN_CACHE_LINE,
+                    entry.words(), true, true),
+    entry(entry) {
+  // Nothing
+}
+
+void DrainWriteBuffer::prepare() {
+  // Old data is only needed if part of the line is being kept.
+  if (entry.complete())
+    validateLine();
+  else
+    allocateLine();
+}
+
+bool DrainWriteBuffer::preconditionsMet() const {
+  return inCache();
+}
+
+uint DrainWriteBuffer::payloadFlitsRemaining() const {
+  return 0;
+}
+
+uint DrainWriteBuffer::resultFlitsRemaining() const {
+  return 0;
+}
+
+bool DrainWriteBuffer::oneIteration() {
+  uint32_t mask = entry.mask(iterationsComplete);
+
+  // Words with no buffered data are left untouched.
+  if (mask != 0) {
+    uint32_t data = entry.word(iterationsComplete);
+    if (mask != 0xFFFFFFFF)
+      data = (readMemory(true) & ~mask) | (data & mask);
+    writeMemory(data);
+  }
+
+  return true;
+}
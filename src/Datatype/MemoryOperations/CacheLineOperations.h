@@ -13,6 +13,7 @@
 #include "../Identifier.h"
 #include "BasicOperations.h"
 #include "MemoryOperation.h"
+#include "../../Tile/Memory/WriteBuffer.h"
 
 // Operation which only works on metadata (e.g. valid, dirty, ...).
 class MetadataOperation : public MemoryOperation {
@@ -131,4 +132,22 @@ private:
   unsigned int targetBank; // Bank in the remote tile to receive data.
 };
 
+// Write one line of a memory bank's write buffer into the cache. This is
+// generated internally by the bank, rather than arriving over the network.
+class DrainWriteBuffer : public MemoryOperation {
+public:
+  DrainWriteBuffer(const WriteBuffer::Entry& entry);
+
+  virtual void prepare();
+  virtual bool preconditionsMet() const;
+  virtual uint payloadFlitsRemaining() const;
+  virtual uint resultFlitsRemaining() const;
+
+protected:
+  virtual bool oneIteration();
+
+private:
+  const WriteBuffer::Entry entry;  // The data to be written.
+};
+
 #endif /* SRC_TILE_MEMORY_OPERATIONS_CACHELINEOPERATIONS_H_ */
@@ -62,3 +62,9 @@ UpdateDirectoryMask::UpdateDirectoryMask(MemoryAddr address, MemoryMetadata meta
     DirectoryOperation(address, metadata, returnAddr, 1) {
   // Nothing
 }
+
+
+DMACommand::DMACommand(MemoryAddr reg, MemoryMetadata metadata, ChannelID returnAddr) :
+    DirectoryOperation(reg, metadata, returnAddr, 1) {
+  // Nothing
+}
@@ -37,4 +37,11 @@ public:
   UpdateDirectoryMask(MemoryAddr address, MemoryMetadata metadata, ChannelID returnAddr);
 };
 
+// Write one of the tile's DMA engine registers. The DMA engine sits alongside
+// the directory, so these commands are forwarded in the same way.
+class DMACommand : public DirectoryOperation {
+public:
+  DMACommand(MemoryAddr reg, MemoryMetadata metadata, ChannelID returnAddr);
+};
+
 #endif /* SRC_TILE_MEMORY_OPERATIONS_DIRECTORYOPERATIONS_H_ */
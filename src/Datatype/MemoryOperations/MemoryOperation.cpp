@@ -43,6 +43,7 @@ MemoryOperation::MemoryOperation(MemoryAddr address,
   level = MEMORY_L1; // Add "unknown" option?
   cacheMiss = false;
   endOfPacketSeen = false;
+  bypassCaches = false;
 
   iterationsComplete = 0;
   addressOffset = 0;
@@ -63,6 +64,10 @@ void MemoryOperation::assignToMemory(MemoryBase& memory, MemoryLevel level) {
   if (level != MEMORY_OFF_CHIP) {
     MemoryBank& bank = static_cast<MemoryBank&>(memory);
 
+    // Data in uncached pages is accessed at main memory, not in any cache.
+    if (level == MEMORY_L1)
+      bypassCaches = bank.bypassesCaches(*this);
+
     Instrumentation::L1Cache::startOperation(bank,
                                              metadata.opcode,
                                              address,
@@ -79,11 +84,15 @@ void MemoryOperation::assignToMemory(MemoryBase& memory, MemoryLevel level) {
   // Make sure we're allowed to write to this address.
   if (writesMemory)
     preWriteCheck();
+
+  // Make sure we're allowed to execute from this address.
+  if (datatype == MEMORY_INSTRUCTION)
+    preExecuteCheck();
 }
 
 bool MemoryOperation::needsForwarding() const {
   assert(memoryAssigned());
-  return (level == MEMORY_L1 && metadata.skipL1)
+  return (level == MEMORY_L1 && (metadata.skipL1 || bypassCaches))
       || (level == MEMORY_L2 && metadata.skipL2);
 }
 
@@ -146,6 +155,12 @@ void MemoryOperation::preWriteCheck() const {
     memory->preWriteCheck(*this);
 }
 
+void MemoryOperation::preExecuteCheck() const {
+  assert(memoryAssigned());
+  if (getAccessMode() != MEMORY_SCRATCHPAD)
+    memory->preExecuteCheck(*this);
+}
+
 MemoryAccessMode MemoryOperation::getAccessMode() const {
   assert(memoryAssigned());
   if (metadata.scratchpad || (level == MEMORY_OFF_CHIP))
@@ -288,7 +303,14 @@ string MemoryOperation::toString() const {
 }
 
 NetworkRequest MemoryOperation::toFlit() const {
-  return NetworkRequest(address, returnAddress, metadata.flatten());
+  if (bypassCaches) {
+    MemoryMetadata forwarded = metadata;
+    forwarded.skipL1 = 1;
+    forwarded.skipL2 = 1;
+    return NetworkRequest(address, returnAddress, forwarded.flatten());
+  }
+  else
+    return NetworkRequest(address, returnAddress, metadata.flatten());
 }
 
 bool MemoryOperation::memoryAssigned() const {
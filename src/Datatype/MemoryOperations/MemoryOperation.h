@@ -185,6 +185,9 @@ private:
   // Perform safety checks before writing any data.
   void preWriteCheck() const;
 
+  // Perform safety checks before fetching any instructions.
+  void preExecuteCheck() const;
+
   // Determine whether `assignToMemory` has been called yet. This must happen
   // before any processing can occur.
   bool memoryAssigned() const;
@@ -227,6 +230,7 @@ private:
   SRAMAddress           addressOffset;  // Amount to add to address/sramAddress
   bool                  cacheMiss;      // Did this operation miss in the cache?
   bool                  endOfPacketSeen;// Have we seen an EOP instruction?
+  bool                  bypassCaches;   // Accesses an uncached page
 
   static uint           operationCount; // Counter used to generate unique IDs
 };
@@ -78,6 +78,8 @@ inline MemoryOperation* decodeMemoryRequest(const NetworkRequest& request,
       op = new UpdateDirectoryEntry(address, metadata, returnAddress); break;
     case UPDATE_DIRECTORY_MASK:
       op = new UpdateDirectoryMask(address, metadata, returnAddress); break;
+    case DMA_COMMAND:
+      op = new DMACommand(address, metadata, returnAddress); break;
 
     default:
       throw InvalidOptionException("memory request opcode", (int)metadata.opcode);
@@ -16,6 +16,7 @@
 #include "Utility/Instrumentation/Operations.h"
 #include "Utility/Instrumentation/Stalls.h"
 #include "Utility/Trace/Callgrind.h"
+#include "Utility/Trace/MemoryTrace.h"
 #include "Utility/StartUp/CodeLoader.h"
 #include "Utility/Statistics.h"
 
@@ -106,7 +107,9 @@ void simulate(Chip& chip, const chip_parameters_t& params) {
         timestep(cyclesPerStep);
         cycle += cyclesPerStep;
 
-        if (cycle % 100000 < cyclesPerStep) {
+        // No instructions are executed while replaying a memory trace, so
+        // progress can't be measured this way.
+        if ((cycle % 100000 < cyclesPerStep) && !Arguments::memoryReplay()) {
           bool progress = checkProgress(100000);
           if (!progress)
             break;
@@ -174,6 +177,9 @@ void presimulation(Chip& chip, const chip_parameters_t& params) {
 
   CodeLoader::makeExecutable(chip);
 
+  // Mark any regions of memory which should not be cached.
+  Arguments::setMemoryAttributes(chip);
+
   if (Arguments::summarise() || ENERGY_TRACE)
     Instrumentation::start();
 }
@@ -208,6 +214,7 @@ void postsimulation(Chip& chip, const chip_parameters_t& params) {
 
   // Stop traces
   Callgrind::endTrace();
+  MemoryTrace::endTrace();
 }
 
 // Entry point of my part of the program.
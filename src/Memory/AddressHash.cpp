@@ -0,0 +1,100 @@
+/*
+ * AddressHash.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "AddressHash.h"
+
+#include <assert.h>
+
+AddressHash::AddressHash() :
+    function_(HASH_LOW_BITS),
+    permutation(0),
+    groupBits(0) {
+  // Nothing
+}
+
+AddressHash::AddressHash(uint function, uint permutation, uint groupBits) :
+    function_((Function)function),
+    permutation(permutation),
+    groupBits(groupBits) {
+  assert(function <= HASH_GROUP_XOR);
+}
+
+uint AddressHash::map(uint line, uint positions) const {
+  assert((positions & (positions - 1)) == 0);
+
+  if (positions <= 1)
+    return 0;
+
+  uint bits = __builtin_ctz(positions);
+
+  switch (function_) {
+    case HASH_LOW_BITS:
+      return line & (positions - 1);
+    case HASH_XOR_FOLD:
+      return xorFold(line, bits);
+    case HASH_PRIME_MODULO:
+      return line % largestPrime(positions);
+    case HASH_PERMUTATION:
+      return permute(line, bits);
+    case HASH_GROUP_XOR:
+      return groupXor(line, bits);
+    default:
+      assert(false);
+      return 0;
+  }
+}
+
+AddressHash::Function AddressHash::function() const {
+  return function_;
+}
+
+uint AddressHash::xorFold(uint line, uint bits) const {
+  uint mask = (1 << bits) - 1;
+  uint result = 0;
+
+  while (line != 0) {
+    result ^= line & mask;
+    line >>= bits;
+  }
+
+  return result;
+}
+
+uint AddressHash::permute(uint line, uint bits) const {
+  uint result = 0;
+
+  for (uint bit=0; bit<bits; bit++) {
+    uint source = (bit < 8) ? ((permutation >> (bit * 4)) & 0xF) : bit;
+    result |= ((line >> source) & 1) << bit;
+  }
+
+  return result;
+}
+
+uint AddressHash::groupXor(uint line, uint bits) const {
+  uint group = (groupBits < bits) ? groupBits : bits;
+  uint position = line & ((1 << group) - 1);
+  uint index = (line >> group) & ((1 << bits) - 1);
+  return index ^ (position << (bits - group));
+}
+
+uint AddressHash::largestPrime(uint value) {
+  for (uint candidate = value; candidate > 2; candidate--) {
+    bool prime = true;
+    for (uint divisor = 2; divisor * divisor <= candidate; divisor++) {
+      if (candidate % divisor == 0) {
+        prime = false;
+        break;
+      }
+    }
+
+    if (prime)
+      return candidate;
+  }
+
+  return 2;
+}
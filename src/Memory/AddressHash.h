@@ -0,0 +1,92 @@
+/*
+ * AddressHash.h
+ *
+ * Map cache line addresses onto a power-of-two number of positions: memory
+ * banks within a group, or cache lines within a bank.
+ *
+ * Hash functions:
+ *   HASH_LOW_BITS     Use the least significant bits of the line address.
+ *   HASH_XOR_FOLD     XOR together all bits of the line address in chunks of
+ *                     the output width.
+ *   HASH_PRIME_MODULO Take the line address modulo the largest prime no
+ *                     larger than the number of positions. Some positions are
+ *                     left unused, but power-of-two strides spread evenly.
+ *   HASH_PERMUTATION  Select a user-specified bit of the line address for each
+ *                     output bit. Bit i of the output comes from the line
+ *                     address bit named in bits 4i+3..4i of the permutation.
+ *                     Only the first eight output bits can be selected; any
+ *                     higher bits use the line address bit in that position.
+ *   HASH_GROUP_XOR    Treat the low bits of the line address as a position
+ *                     within a group (e.g. the bank within a memory group), and
+ *                     XOR them into the top of the next-higher bits. This is
+ *                     the traditional mapping of cache lines to sets within a
+ *                     bank. With no group bits it is the same as HASH_LOW_BITS.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_MEMORY_ADDRESSHASH_H_
+#define SRC_MEMORY_ADDRESSHASH_H_
+
+#include "../Types.h"
+
+class AddressHash {
+
+//============================================================================//
+// Local types
+//============================================================================//
+
+public:
+
+  enum Function {
+    HASH_LOW_BITS     = 0,
+    HASH_XOR_FOLD     = 1,
+    HASH_PRIME_MODULO = 2,
+    HASH_PERMUTATION  = 3,
+    HASH_GROUP_XOR    = 4
+  };
+
+//============================================================================//
+// Constructors and destructors
+//============================================================================//
+
+public:
+
+  AddressHash();
+  AddressHash(uint function, uint permutation, uint groupBits = 0);
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  // Map a line address (a byte address with the offset bits removed) onto one
+  // of `positions` positions. `positions` must be a power of two.
+  uint map(uint line, uint positions) const;
+
+  Function function() const;
+
+private:
+
+  uint xorFold(uint line, uint bits) const;
+  uint permute(uint line, uint bits) const;
+  uint groupXor(uint line, uint bits) const;
+
+  // The largest prime which is no larger than `value`.
+  static uint largestPrime(uint value);
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+private:
+
+  Function function_;
+  uint     permutation;
+  uint     groupBits;   // HASH_GROUP_XOR only
+
+};
+
+#endif /* SRC_MEMORY_ADDRESSHASH_H_ */
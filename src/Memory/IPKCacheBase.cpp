@@ -25,7 +25,8 @@ IPKCacheBase::IPKCacheBase(const std::string& name, size_t size, size_t numTags,
     data(size),
     fresh(size, false),
     readPointer(size),
-    writePointer(size) {
+    writePointer(size),
+    loadTime(numTags, 0) {
 
   assert(size > 0);
   assert(numTags > 0);
@@ -96,6 +97,10 @@ void IPKCacheBase::setTag(MemoryAddr tag) {
   tagActivity();
 }
 
+void IPKCacheBase::startPacket(MemoryAddr tag) {
+  // Do nothing: packets are written wherever the write pointer is.
+}
+
 /* Jump to a new instruction at a given offset. */
 void IPKCacheBase::jump(const JumpOffset offset) {
   // Store the offset. The jump will be made next time an instruction is read
@@ -143,10 +148,33 @@ bool IPKCacheBase::canFetch() const {
   return (remainingSpace() > maxIPKLength + 1);
 }
 
+bool IPKCacheBase::canFetch(MemoryAddr tag) const {
+  return canFetch();
+}
+
 void IPKCacheBase::cancelPacket() {
   finishedPacketRead = true;
 }
 
+void IPKCacheBase::markAsRead(CacheIndex position) {
+  bool consumed = false;
+
+  for (uint i=0; i<size(); i++) {
+    CacheIndex pos = (position + i) % size();
+
+    if (fresh[pos]) {
+      fresh[pos] = false;
+      consumed = true;
+    }
+
+    if (data[pos].endOfPacket())
+      break;
+  }
+
+  if (consumed)
+    dataConsumed.notify();
+}
+
 /* Store some initial instructions in the cache. */
 CacheIndex IPKCacheBase::storeCode(const std::vector<Instruction>& code) {
   if (code.size() > size())
@@ -210,6 +238,21 @@ size_t IPKCacheBase::getFillCount() const {
   return fillCount;
 }
 
+void IPKCacheBase::packetLoaded(TagIndex index, MemoryAddr tag) {
+  packetEvicted(index);
+
+  loadTime[index] = Instrumentation::currentCycle();
+  Instrumentation::IPKCache::packetLoaded(tag);
+}
+
+void IPKCacheBase::packetEvicted(TagIndex index) {
+  if (tags[index] == DEFAULT_TAG)
+    return;
+
+  cycle_count_t residency = Instrumentation::currentCycle() - loadTime[index];
+  Instrumentation::IPKCache::packetEvicted(tags[index], residency);
+}
+
 void IPKCacheBase::tagActivity() {
   if (!ENERGY_TRACE)
     return;
@@ -47,6 +47,10 @@ public:
   // Set the tag of the most recently written instruction to the given value.
   virtual void setTag(MemoryAddr tag);
 
+  // A new packet with the given tag is about to be written. Caches which
+  // choose a location for each packet do so here.
+  virtual void startPacket(MemoryAddr tag);
+
   // Jump to a new instruction at a given offset.
   virtual void jump(const JumpOffset offset);
 
@@ -70,10 +74,19 @@ public:
   // size packet.
   virtual bool canFetch() const;
 
+  // Return whether a new packet with the given tag can be fetched. Caches
+  // which choose a location for each packet may not have room for every tag.
+  virtual bool canFetch(MemoryAddr tag) const;
+
   // Abort execution of this instruction packet, and resume when the next packet
   // arrives.
   virtual void cancelPacket();
 
+  // Treat the packet starting at the given position as though it has been
+  // read, so it can be overwritten without warning. Used for packets which
+  // were fetched speculatively and may never execute.
+  virtual void markAsRead(CacheIndex position);
+
   // Store some initial instructions in the cache. Returns the cache location
   // to which the first instruction was written.
   virtual CacheIndex storeCode(const std::vector<Instruction>& code);
@@ -112,6 +125,11 @@ protected:
 
   virtual size_t getFillCount() const;
 
+  // Statistics on how long packets stay in the cache. Call when the tag at
+  // the given index is written or invalidated.
+  void packetLoaded(TagIndex index, MemoryAddr tag);
+  void packetEvicted(TagIndex index);
+
 private:
 
   // Instrumentation helper methods.
@@ -153,6 +171,9 @@ private:
 
   sc_event dataConsumed;
 
+  // The cycle at which each tag was last written.
+  std::vector<cycle_count_t> loadTime;
+
   // Keep track of which cycles the tag and data arrays were active so we can
   // estimate potential savings of clock gating.
   cycle_count_t lastTagActivity, lastDataActivity;
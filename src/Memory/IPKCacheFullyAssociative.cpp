@@ -27,8 +27,10 @@ CacheIndex IPKCacheFullyAssociative::write(const Instruction inst) {
 
   CacheIndex entry = writePointer.value();
   for (unsigned int i=0; i<packetPointers.size(); i++) {
-    if (packetPointers[i] == entry)
+    if (packetPointers[i] == entry) {
+      packetEvicted(i);
       tags[i] = NOT_IN_CACHE;
+    }
   }
 
   return returnVal;
@@ -53,6 +55,7 @@ void IPKCacheFullyAssociative::setTag(const CacheIndex position, const MemoryAdd
   if (ENERGY_TRACE)
     Instrumentation::IPKCache::tagWrite(tags[tagIndex], tag);
 
+  packetLoaded(tagIndex, tag);
   tags[tagIndex] = tag;
   packetPointers[tagIndex] = position;
 }
@@ -0,0 +1,209 @@
+/*
+ * IPKCacheSetAssociative.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "IPKCacheSetAssociative.h"
+
+#include <assert.h>
+
+#include "../Utility/Instrumentation/IPKCache.h"
+
+IPKCacheSetAssociative::IPKCacheSetAssociative(const std::string& name,
+                                               size_t size,
+                                               size_t ways,
+                                               size_t maxIPKLength,
+                                               uint replacement) :
+    IPKCacheBase(name, size, size / maxIPKLength, maxIPKLength),
+    blockSize(maxIPKLength),
+    ways(ways),
+    sets(tags.size() / ways),
+    replacement((Replacement)replacement),
+    lastUsed(tags.size(), 0),
+    accesses(0),
+    plruBits(tags.size() / ways, 0),
+    newPacket(false),
+    newPacketPosition(0) {
+
+  assert(size % maxIPKLength == 0);
+  assert(ways >= 2);
+  assert(tags.size() % ways == 0);
+  assert(replacement <= REPLACE_PLRU);
+
+  if (replacement == REPLACE_PLRU)
+    assert(((ways & (ways - 1)) == 0) && (ways <= 16));
+}
+
+CacheIndex IPKCacheSetAssociative::lookup(const MemoryAddr tag) {
+  CacheIndex position = IPKCacheBase::lookup(tag);
+
+  if (position != NOT_IN_CACHE)
+    touch(position / blockSize);
+
+  return position;
+}
+
+void IPKCacheSetAssociative::startPacket(MemoryAddr tag) {
+  uint block = victim(set(tag));
+
+  invalidate(block);
+  touch(block);
+
+  newPacket = true;
+  newPacketPosition = block * blockSize;
+}
+
+bool IPKCacheSetAssociative::full() const {
+  // The first instruction of a packet goes to the block chosen by
+  // startPacket, which canFetch has already checked.
+  if (finishedPacketWrite || newPacket || writePointer.isNull())
+    return false;
+
+  // Continuing within the same block is always safe.
+  CacheIndex next = (writePointer.value() + 1) % size();
+  if (next % blockSize != 0)
+    return false;
+
+  return isProtected(next / blockSize);
+}
+
+bool IPKCacheSetAssociative::canFetch() const {
+  return !full();
+}
+
+bool IPKCacheSetAssociative::canFetch(MemoryAddr tag) const {
+  uint first = set(tag) * ways;
+
+  for (uint block = first; block < first + ways; block++)
+    if (!isProtected(block))
+      return true;
+
+  return false;
+}
+
+CacheIndex IPKCacheSetAssociative::cacheIndex(const MemoryAddr address) const {
+  uint first = set(address) * ways;
+
+  for (uint block = first; block < first + ways; block++) {
+    if (tags[block] == address)
+      return block * blockSize;
+  }
+
+  return NOT_IN_CACHE;
+}
+
+void IPKCacheSetAssociative::setTag(const CacheIndex position, const MemoryAddr tag) {
+  TagIndex block = position / blockSize;
+
+  if (ENERGY_TRACE)
+    Instrumentation::IPKCache::tagWrite(tags[block], tag);
+
+  packetLoaded(block, tag);
+  tags[block] = tag;
+}
+
+void IPKCacheSetAssociative::updateReadPointer() {
+  if (jumpAmount != 0) {
+    readPointer += jumpAmount;
+    jumpAmount = 0;
+  }
+  else
+    incrementReadPos();
+}
+
+void IPKCacheSetAssociative::updateWritePointer() {
+  if (newPacket) {
+    writePointer = newPacketPosition;
+    newPacket = false;
+  }
+  else {
+    incrementWritePos();
+
+    // Only code stored directly, or an oversized packet, can reach the next
+    // block. Whatever was there is no longer valid.
+    if (writePointer.value() % blockSize == 0)
+      invalidate(writePointer.value() / blockSize);
+  }
+}
+
+uint IPKCacheSetAssociative::set(MemoryAddr address) const {
+  return (address / BYTES_PER_WORD) % sets;
+}
+
+bool IPKCacheSetAssociative::isProtected(uint block) const {
+  if (!readPointer.isNull() && block == readPointer.value() / blockSize)
+    return true;
+
+  for (uint i = block * blockSize; i < (block + 1) * blockSize; i++)
+    if (fresh[i])
+      return true;
+
+  return false;
+}
+
+uint IPKCacheSetAssociative::victim(uint set) const {
+  uint first = set * ways;
+
+  // Use an empty block if there is one.
+  for (uint block = first; block < first + ways; block++)
+    if (tags[block] == DEFAULT_TAG && !isProtected(block))
+      return block;
+
+  if (replacement == REPLACE_PLRU) {
+    uint block = plruVictim(set);
+    if (!isProtected(block))
+      return block;
+  }
+
+  // LRU, or PLRU chose a protected block.
+  uint oldest = NO_BLOCK;
+  for (uint block = first; block < first + ways; block++)
+    if (!isProtected(block) && (oldest == NO_BLOCK || lastUsed[block] < lastUsed[oldest]))
+      oldest = block;
+
+  assert(oldest != NO_BLOCK);
+  return oldest;
+}
+
+uint IPKCacheSetAssociative::plruVictim(uint set) const {
+  uint node = 1;
+  uint way = 0;
+
+  for (uint level = 1; level < ways; level <<= 1) {
+    uint bit = (plruBits[set] >> node) & 1;
+    way = (way << 1) | bit;
+    node = (node << 1) | bit;
+  }
+
+  return set * ways + way;
+}
+
+void IPKCacheSetAssociative::touch(uint block) {
+  lastUsed[block] = ++accesses;
+
+  if (replacement != REPLACE_PLRU)
+    return;
+
+  uint set = block / ways;
+  uint way = block % ways;
+  uint node = 1;
+
+  // Walk from the root to this block, pointing each node at the other half.
+  for (uint half = ways >> 1; half > 0; half >>= 1) {
+    uint bit = (way & half) ? 1 : 0;
+
+    if (bit)
+      plruBits[set] &= ~(1 << node);
+    else
+      plruBits[set] |= (1 << node);
+
+    node = (node << 1) | bit;
+  }
+}
+
+void IPKCacheSetAssociative::invalidate(uint block) {
+  packetEvicted(block);
+  tags[block] = DEFAULT_TAG;
+}
@@ -0,0 +1,123 @@
+/*
+ * IPKCacheSetAssociative.h
+ *
+ * An instruction packet cache which allocates storage a whole packet at a
+ * time. The cache is divided into blocks of maxIPKLength instructions, and
+ * each packet is stored at the start of one block. Blocks are grouped into
+ * sets, and a packet may only be stored in a block of the set selected by its
+ * address. Within a set, the block to replace is chosen by least-recently-used
+ * or tree pseudo-LRU order, so a packet which executes often stays resident
+ * even if many other packets pass through the cache.
+ *
+ * The block holding the packet currently being read is never replaced, and
+ * nor is any block holding instructions which have not been read yet. If every
+ * block of a packet's set is protected, the fetch must wait.
+ *
+ * Packets must be no longer than maxIPKLength. Any packet which overflows its
+ * block invalidates the next block.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_MEMORY_IPKCACHESETASSOCIATIVE_H_
+#define SRC_MEMORY_IPKCACHESETASSOCIATIVE_H_
+
+#include "IPKCacheBase.h"
+
+class IPKCacheSetAssociative: public IPKCacheBase {
+
+//============================================================================//
+// Local types
+//============================================================================//
+
+public:
+
+  enum Replacement {
+    REPLACE_LRU  = 0,
+    REPLACE_PLRU = 1
+  };
+
+//============================================================================//
+// Constructors and destructors
+//============================================================================//
+
+public:
+
+  // `ways` must be at least 2 and divide the number of blocks. For PLRU,
+  // `ways` must also be a power of two no larger than 16.
+  IPKCacheSetAssociative(const std::string& name, size_t size, size_t ways,
+                         size_t maxIPKLength, uint replacement);
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  virtual CacheIndex lookup(const MemoryAddr tag);
+  virtual void startPacket(MemoryAddr tag);
+
+  // Space is allocated when each packet arrives, so the only way to run out of
+  // room is for an oversized packet to reach a protected block.
+  virtual bool full() const;
+  virtual bool canFetch() const;
+
+  // There is room for a new packet if its set has an unprotected block.
+  virtual bool canFetch(MemoryAddr tag) const;
+
+protected:
+
+  virtual CacheIndex cacheIndex(const MemoryAddr address) const;
+  virtual void setTag(const CacheIndex position, const MemoryAddr tag);
+  virtual void updateReadPointer();
+  virtual void updateWritePointer();
+
+private:
+
+  uint set(MemoryAddr address) const;
+
+  // Whether the given block must not be replaced: it is being read, or holds
+  // instructions which have not been read yet.
+  bool isProtected(uint block) const;
+
+  // The block in the given set which should be replaced next. The set must
+  // have at least one unprotected block.
+  uint victim(uint set) const;
+  uint plruVictim(uint set) const;
+
+  // Record that a block has been accessed.
+  void touch(uint block);
+
+  void invalidate(uint block);
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+private:
+
+  static const uint NO_BLOCK = -1;
+
+  const size_t blockSize;
+  const size_t ways;
+  const size_t sets;
+  const Replacement replacement;
+
+  // LRU: the time at which each block was last accessed.
+  std::vector<count_t> lastUsed;
+  count_t accesses;
+
+  // PLRU: a binary tree of bits for each set. Node n has children 2n and
+  // 2n+1, and the root is node 1. Each bit points towards the half of the set
+  // which was used less recently.
+  std::vector<uint32_t> plruBits;
+
+  // The position chosen for the next packet, if startPacket has been called
+  // and the packet has not yet started arriving.
+  bool       newPacket;
+  CacheIndex newPacketPosition;
+
+};
+
+#endif /* SRC_MEMORY_IPKCACHESETASSOCIATIVE_H_ */
@@ -105,6 +105,9 @@ public:
   // Check whether it is safe for the given operation to modify memory.
   virtual void preWriteCheck(const MemoryOperation& operation) const = 0;
 
+  // Check whether instructions may be fetched by the given operation.
+  virtual void preExecuteCheck(const MemoryOperation& operation) const = 0;
+
   // Data access.
   // A "magic" access does not consume any bandwidth, and happens instantly.
   virtual uint32_t readWord(SRAMAddress position, MemoryAccessMode mode, bool magic=false) {
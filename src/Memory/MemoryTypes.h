@@ -54,6 +54,7 @@ enum MemoryOpcode {
   STORE_LINE              = ( 4 << 1) | 0, // Target any bank
   MEMSET_LINE             = ( 5 << 1) | 0, // Target any bank
   PUSH_LINE               = ( 6 << 1) | 0, // Target a particular bank
+  DMA_COMMAND             = ( 7 << 1) | 0, // Target any bank
 
   LOAD_AND_ADD            = ( 8 << 1) | 0,
   LOAD_AND_OR             = ( 9 << 1) | 0,
@@ -72,7 +73,7 @@ inline const std::string& memoryOpName(MemoryOpcode op) {
     "STORE_W",               "LOAD_W",          "STORE_CONDITIONAL",      "LOAD_LINKED",
     "STORE_HW",              "LOAD_HW",         "STORE_B",                "LOAD_B",
     "STORE_LINE",            "FETCH_LINE",      "MEMSET_LINE",            "IPK_READ",
-    "PUSH_LINE",             "VALIDATE_LINE",   "INVALID14",              "PREFETCH_LINE",
+    "PUSH_LINE",             "VALIDATE_LINE",   "DMA_COMMAND",            "PREFETCH_LINE",
     "LOAD_AND_ADD",          "FLUSH_LINE",      "LOAD_AND_OR",            "INVALIDATE_LINE",
     "LOAD_AND_AND",          "FLUSH_ALL_LINES", "LOAD_AND_XOR",           "INVALIDATE_ALL_LINES",
     "EXCHANGE",              "INVALID25",       "UPDATE_DIRECTORY_ENTRY", "INVALID27",
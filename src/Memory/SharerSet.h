@@ -0,0 +1,105 @@
+/*
+ * SharerSet.h
+ *
+ * A compact set of tile indices, used to record which tiles hold a copy of a
+ * cache line. Unlike a single machine word, there is no limit on the number
+ * of tiles, and storage grows only as far as the highest tile added.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_MEMORY_SHARERSET_H_
+#define SRC_MEMORY_SHARERSET_H_
+
+#include <inttypes.h>
+#include <vector>
+
+class SharerSet {
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  // Add a tile to the set.
+  void add(uint tile) {
+    uint word = tile / bitsPerWord;
+    if (word >= bits.size())
+      bits.resize(word + 1, 0);
+    bits[word] |= bit(tile);
+  }
+
+  // Remove a tile from the set.
+  void remove(uint tile) {
+    uint word = tile / bitsPerWord;
+    if (word < bits.size())
+      bits[word] &= ~bit(tile);
+  }
+
+  // Make the given tile the only member of the set.
+  void setOnly(uint tile) {
+    clear();
+    add(tile);
+  }
+
+  void clear() {
+    for (uint i=0; i<bits.size(); i++)
+      bits[i] = 0;
+  }
+
+  bool contains(uint tile) const {
+    uint word = tile / bitsPerWord;
+    return (word < bits.size()) && (bits[word] & bit(tile));
+  }
+
+  bool empty() const {
+    for (uint i=0; i<bits.size(); i++)
+      if (bits[i] != 0)
+        return false;
+    return true;
+  }
+
+  // The number of tiles in the set.
+  uint count() const {
+    uint total = 0;
+    for (uint i=0; i<bits.size(); i++)
+      total += __builtin_popcountll(bits[i]);
+    return total;
+  }
+
+  // Call `f(tile)` for every tile in the set, in ascending order.
+  template<typename Function>
+  void forEach(Function f) const {
+    for (uint i=0; i<bits.size(); i++) {
+      uint64_t remaining = bits[i];
+      while (remaining != 0) {
+        uint offset = __builtin_ctzll(remaining);
+        f(i * bitsPerWord + offset);
+        remaining &= remaining - 1;
+      }
+    }
+  }
+
+private:
+
+  static uint64_t bit(uint tile) {
+    return 1ULL << (tile % bitsPerWord);
+  }
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+private:
+
+  static const uint bitsPerWord = 64;
+
+  // One bit per tile. Most lines are held by low-numbered tiles only, so this
+  // is usually a single word.
+  std::vector<uint64_t> bits;
+
+};
+
+#endif /* SRC_MEMORY_SHARERSET_H_ */
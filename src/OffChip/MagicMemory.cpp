@@ -14,66 +14,118 @@
 #include "../Utility/Assert.h"
 #include "../Utility/Parameters.h"
 
-MagicMemory::MagicMemory(const sc_module_name& name, MainMemory& mainMemory) :
+MagicMemory::MagicMemory(const sc_module_name& name, MainMemory& mainMemory,
+                         const chip_parameters_t& params) :
     LokiComponent(name),
-    mainMemory(mainMemory) {
+    mainMemory(mainMemory),
+    target(&mainMemory) {
   // Nothing
 }
 
 void MagicMemory::operate(MemoryOpcode opcode,
                           MemoryAddr address,
                           ChannelID returnChannel,
-                          Word data) {
+                          Word data,
+                          MemoryAccessMode mode,
+                          ComponentID bank) {
   LOKI_LOG(1) << this->name() << " performing " << memoryOpName(opcode) << " "
       << LOKI_HEX(address) << " for " << returnChannel << endl;
 
+  TileID tile = returnChannel.component.tile;
+  ComponentID requester = returnChannel.component;
+
+  // Directory updates do not access any data.
   switch (opcode) {
-    case LOAD_W: {
-      Word result = mainMemory.readWord(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
+    case UPDATE_DIRECTORY_ENTRY:
+      chip().updateDirectoryEntry(tile, address, data.toUInt());
+      return;
+    case UPDATE_DIRECTORY_MASK:
+      chip().updateDirectoryMask(tile, data.toUInt());
+      return;
+    case DMA_COMMAND:
+      LOKI_WARN << "DMA engines are not available with magic memory" << endl;
+      return;
+    default:
       break;
-    }
+  }
 
-    case LOAD_HW: {
-      Word result = mainMemory.readHalfword(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
+  if (mode == MEMORY_SCRATCHPAD) {
+    target = &chip().magicScratchpad(bank);
+  }
+  else {
+    // If the directory points to a scratchpad at the next level, there is no
+    // main memory copy. Use the translated address in main memory instead.
+    if (!chip().backedByMainMemory(tile, address))
+      LOKI_LOG(2) << this->name() << ": " << LOKI_HEX(address)
+          << " is not backed by main memory" << endl;
+
+    target = &mainMemory;
+    address = chip().getAddressTranslation(tile, address);
+  }
+
+  switch (opcode) {
+    case LOAD_W:
+      sendResult(readWord(address), returnChannel);
       break;
-    }
 
-    case LOAD_B: {
-      Word result = mainMemory.readByte(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
+    case LOAD_LINKED:
+      makeReservation(requester, address);
+      sendResult(readWord(address), returnChannel);
+      break;
+
+    case LOAD_HW:
+      sendResult(readHalfword(address), returnChannel);
+      break;
+
+    case LOAD_B:
+      sendResult(readByte(address), returnChannel);
       break;
-    }
 
     case STORE_W:
-      mainMemory.writeWord(address, data.toUInt(), MEMORY_SCRATCHPAD, true);
+      writeWord(address, data.toUInt());
       break;
 
+    case STORE_CONDITIONAL: {
+      // Unlike a memory bank, there is no cache to miss in, so the operation
+      // succeeds as long as the reservation is still held.
+      bool success = checkReservation(requester, address);
+      sendResult(Word(success ? 1 : 0), returnChannel);
+      if (success)
+        writeWord(address, data.toUInt());
+      break;
+    }
+
     case STORE_HW:
-      mainMemory.writeHalfword(address, data.toUInt(), MEMORY_SCRATCHPAD, true);
+      writeHalfword(address, data.toUInt());
       break;
 
     case STORE_B:
-      mainMemory.writeByte(address, data.toUInt(), MEMORY_SCRATCHPAD, true);
+      writeByte(address, data.toUInt());
       break;
 
+    case FETCH_LINE: {
+      MemoryAddr addr = address & ~(CACHE_LINE_BYTES - 1);
+      for (uint i=0; i<CACHE_LINE_WORDS; i++, addr += BYTES_PER_WORD)
+        sendResult(readWord(addr), returnChannel, i == CACHE_LINE_WORDS - 1);
+      break;
+    }
+
     case IPK_READ: {
       MemoryAddr cursor = address;
 
+      if (WARN_NO_EXECUTE && target == &mainMemory && mainMemory.noExecute(address))
+        LOKI_WARN << this->name() << " fetching instructions from no-execute address "
+                  << LOKI_HEX(address) << endl;
+
       while (true) {
-        Instruction result = static_cast<Instruction>(mainMemory.readWord(cursor, MEMORY_SCRATCHPAD, true));
+        Instruction result = static_cast<Instruction>(readWord(cursor));
         cursor += BYTES_PER_WORD;
 
         // Stop fetching instructions at the end of the packet or the end
         // of the cache line.
-        bool endOfPacket = result.endOfPacket() || ((cursor & 0x1F) == 0);
+        bool endOfPacket = result.endOfPacket() || ((cursor & (CACHE_LINE_BYTES - 1)) == 0);
 
-        NetworkData flit(result, returnChannel, endOfPacket);
-        chip().networkSendDataInternal(flit);
+        sendResult(result, returnChannel, endOfPacket);
 
         if (endOfPacket)
           break;
@@ -82,71 +134,111 @@ void MagicMemory::operate(MemoryOpcode opcode,
     }
 
     case MEMSET_LINE: {
-      MemoryAddr addr = address & ~0x1f;
-      MemoryAddr end = addr + 0x20;
+      MemoryAddr addr = address & ~(CACHE_LINE_BYTES - 1);
+      MemoryAddr end = addr + CACHE_LINE_BYTES;
       for (; addr < end; addr += BYTES_PER_WORD)
-        mainMemory.writeWord(addr, data.toUInt(), MEMORY_SCRATCHPAD, true);
+        writeWord(addr, data.toUInt());
       break;
     }
 
     case LOAD_AND_ADD: {
-      Word result = mainMemory.readWord(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
-      mainMemory.writeWord(address, result.toUInt() + data.toUInt(), MEMORY_SCRATCHPAD, true);
+      uint32_t result = readWord(address);
+      sendResult(result, returnChannel);
+      writeWord(address, result + data.toUInt());
       break;
     }
 
     case LOAD_AND_OR: {
-      Word result = mainMemory.readWord(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
-      mainMemory.writeWord(address, result.toUInt() | data.toUInt(), MEMORY_SCRATCHPAD, true);
+      uint32_t result = readWord(address);
+      sendResult(result, returnChannel);
+      writeWord(address, result | data.toUInt());
       break;
     }
 
     case LOAD_AND_AND: {
-      Word result = mainMemory.readWord(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
-      mainMemory.writeWord(address, result.toUInt() & data.toUInt(), MEMORY_SCRATCHPAD, true);
+      uint32_t result = readWord(address);
+      sendResult(result, returnChannel);
+      writeWord(address, result & data.toUInt());
       break;
     }
 
     case LOAD_AND_XOR: {
-      Word result = mainMemory.readWord(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
-      mainMemory.writeWord(address, result.toUInt() ^ data.toUInt(), MEMORY_SCRATCHPAD, true);
+      uint32_t result = readWord(address);
+      sendResult(result, returnChannel);
+      writeWord(address, result ^ data.toUInt());
       break;
     }
 
     case EXCHANGE: {
-      Word result = mainMemory.readWord(address, MEMORY_SCRATCHPAD, true);
-      NetworkData flit(result, returnChannel, true);
-      chip().networkSendDataInternal(flit);
-      mainMemory.writeWord(address, data.toUInt(), MEMORY_SCRATCHPAD, true);
+      uint32_t result = readWord(address);
+      sendResult(result, returnChannel);
+      writeWord(address, data.toUInt());
       break;
     }
 
+    // Line stores arrive as a sequence of STORE_Ws, so only the head flit
+    // reaches this point.
+    case STORE_LINE:
+    case PUSH_LINE:
+
+    // There are no caches, so these operations have no visible effect.
     case VALIDATE_LINE:
     case PREFETCH_LINE:
     case FLUSH_LINE:
     case INVALIDATE_LINE:
     case FLUSH_ALL_LINES:
     case INVALIDATE_ALL_LINES:
-    case PUSH_LINE:
-    case UPDATE_DIRECTORY_ENTRY:
-    case UPDATE_DIRECTORY_MASK:
       LOKI_LOG(2) << this->name() << ": " << memoryOpName(opcode) << " has no effect" << endl;
       break;
 
     default:
-      loki_assert_with_message(false, "Magic memory doesn't yet support %s", memoryOpName(opcode).c_str());
+      loki_assert_with_message(false, "Magic memory doesn't support %s", memoryOpName(opcode).c_str());
       break;
   }
 }
 
+uint32_t MagicMemory::readWord(MemoryAddr address) {
+  return target->readWord(target->getPosition(address, MEMORY_SCRATCHPAD), MEMORY_SCRATCHPAD, true);
+}
+
+uint32_t MagicMemory::readHalfword(MemoryAddr address) {
+  return target->readHalfword(target->getPosition(address, MEMORY_SCRATCHPAD), MEMORY_SCRATCHPAD, true);
+}
+
+uint32_t MagicMemory::readByte(MemoryAddr address) {
+  return target->readByte(target->getPosition(address, MEMORY_SCRATCHPAD), MEMORY_SCRATCHPAD, true);
+}
+
+void MagicMemory::writeWord(MemoryAddr address, uint32_t data) {
+  SRAMAddress position = target->getPosition(address, MEMORY_SCRATCHPAD);
+  target->writeWord(position, data, MEMORY_SCRATCHPAD, true);
+}
+
+void MagicMemory::writeHalfword(MemoryAddr address, uint32_t data) {
+  SRAMAddress position = target->getPosition(address, MEMORY_SCRATCHPAD);
+  target->writeHalfword(position, data, MEMORY_SCRATCHPAD, true);
+}
+
+void MagicMemory::writeByte(MemoryAddr address, uint32_t data) {
+  SRAMAddress position = target->getPosition(address, MEMORY_SCRATCHPAD);
+  target->writeByte(position, data, MEMORY_SCRATCHPAD, true);
+}
+
+void MagicMemory::makeReservation(ComponentID requester, MemoryAddr address) {
+  // Main memory and memory banks both hold their own reservations, and clear
+  // them when their data is written.
+  target->makeReservation(requester, address, MEMORY_SCRATCHPAD);
+}
+
+bool MagicMemory::checkReservation(ComponentID requester, MemoryAddr address) const {
+  return target->checkReservation(requester, address, MEMORY_SCRATCHPAD);
+}
+
+void MagicMemory::sendResult(Word data, ChannelID returnChannel, bool endOfPacket) {
+  NetworkData flit(data, returnChannel, endOfPacket);
+  chip().networkSendDataInternal(flit);
+}
+
 Chip& MagicMemory::chip() const {
   return *static_cast<Chip*>(this->get_parent_object());
 }
@@ -7,6 +7,11 @@
  * Note that this may change the ordering of memory operations, but is still
  * sequentially consistent.
  *
+ * Cache-mode accesses go to main memory, after applying the address
+ * translations of the requesting tile's directory. Scratchpad-mode accesses go
+ * to the private address space of the target memory bank, so they see the same
+ * data as they would in a normal simulation.
+ *
  *  Created on: 15 Oct 2015
  *      Author: db434
  */
@@ -21,6 +26,7 @@
 
 class Chip;
 class MainMemory;
+class MemoryBase;
 
 class MagicMemory: public LokiComponent {
 
@@ -30,7 +36,8 @@ class MagicMemory: public LokiComponent {
 
 public:
 
-  MagicMemory(const sc_module_name& name, MainMemory& mainMemory);
+  MagicMemory(const sc_module_name& name, MainMemory& mainMemory,
+              const chip_parameters_t& params);
 
 //============================================================================//
 // Methods
@@ -38,16 +45,34 @@ public:
 
 public:
 
-  // Perform an operation on the data in main memory. Any results are returned
+  // Perform an operation on the data in memory. Any results are returned
   // immediately to returnChannel.
-  // Only operations with 0 to 1 payload flits are currently supported.
+  // Operations may have at most one payload flit. Operations with more
+  // payloads must be split into a sequence of single-payload operations.
+  // `bank` is only used for scratchpad-mode accesses.
   void operate(MemoryOpcode opcode,
                MemoryAddr address,
                ChannelID returnChannel,
-               Word data = 0);
+               Word data = 0,
+               MemoryAccessMode mode = MEMORY_CACHE,
+               ComponentID bank = ComponentID());
 
 private:
 
+  // Data access within the memory selected for the current operation.
+  uint32_t readWord(MemoryAddr address);
+  uint32_t readHalfword(MemoryAddr address);
+  uint32_t readByte(MemoryAddr address);
+  void writeWord(MemoryAddr address, uint32_t data);
+  void writeHalfword(MemoryAddr address, uint32_t data);
+  void writeByte(MemoryAddr address, uint32_t data);
+
+  // Load-linked/store-conditional support.
+  void makeReservation(ComponentID requester, MemoryAddr address);
+  bool checkReservation(ComponentID requester, MemoryAddr address) const;
+
+  void sendResult(Word data, ChannelID returnChannel, bool endOfPacket=true);
+
   Chip& chip() const;
 
 
@@ -59,6 +84,10 @@ private:
 
   MainMemory& mainMemory;
 
+  // The memory accessed by the current operation: either main memory, or a
+  // memory bank in scratchpad mode.
+  MemoryBase* target;
+
 };
 
 #endif /* SRC_TILE_MEMORY_MAGICMEMORY_H_ */
@@ -10,8 +10,13 @@
 #include "MainMemory.h"
 #include "../Chip.h"
 #include "../Datatype/MemoryOperations/MemoryOperationDecode.h"
+#include "../Memory/AddressHash.h"
 #include "../Utility/Assert.h"
+#include "../Utility/Instrumentation/Coherence.h"
 #include "../Utility/Instrumentation/MainMemory.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <ios>
 
@@ -27,13 +32,23 @@ MainMemory::MainMemory(sc_module_name name, uint controllers,
     iData("iData", controllers),
     oData("oData", controllers),
     mData(params.size/BYTES_PER_WORD, 0),
-    cacheLineValid(params.size / params.cacheLineSize, 0) {
+    activeChannelRequests(controllers, 0),
+    channelBandwidth(params.bandwidth),
+    pageAttributes_((params.size + (1 << log2PageSize) - 1) >> log2PageSize, 0),
+    coherence((CoherenceProtocol)params.coherence),
+    interleaving((Interleaving)params.interleaving),
+    reservations(params.reservations),
+    numCacheLines(params.size / params.cacheLineSize) {
 
   loki_assert(controllers >= 1);
+  loki_assert_with_message(coherence <= COHERENCE_MESI, "Protocol = %d", coherence);
+  loki_assert_with_message(interleaving <= INTERLEAVE_XOR, "Interleaving = %d", interleaving);
+  loki_assert_with_message(interleaving != INTERLEAVE_XOR || (controllers & (controllers - 1)) == 0,
+      "XOR interleaving needs a power of two memory controllers, not %d", controllers);
 
   for (uint i=0; i<controllers; i++) {
     MainMemoryRequestHandler* handler =
-        new MainMemoryRequestHandler(sc_gen_unique_name("handler"), *this, params);
+        new MainMemoryRequestHandler(sc_gen_unique_name("handler"), *this, i, params);
 
     handler->iClock(iClock);
     iData[i](handler->iData);
@@ -44,6 +59,8 @@ MainMemory::MainMemory(sc_module_name name, uint controllers,
 
   activeRequests = 0;
 
+  Instrumentation::MainMemory::setNumChannels(controllers);
+
 }
 
 
@@ -111,13 +128,12 @@ void MainMemory::sendResponse(NetworkResponse response, MemoryLevel level) {
 
 // Make a load-linked reservation.
 void MainMemory::makeReservation(ComponentID requester, MemoryAddr address, MemoryAccessMode mode) {
-  // Do nothing.
+  reservations.makeReservation(requester, address, getPosition(address, mode));
 }
 
 // Return whether a load-linked reservation is still valid.
 bool MainMemory::checkReservation(ComponentID requester, MemoryAddr address, MemoryAccessMode mode) const {
-  // Do nothing.
-  return false;
+  return reservations.checkReservation(requester, address);
 }
 
 // Check whether it is safe for the given operation to modify memory.
@@ -128,44 +144,222 @@ void MainMemory::preWriteCheck(const MemoryOperation& operation) const {
   }
 }
 
+// Check whether instructions may be fetched by the given operation.
+void MainMemory::preExecuteCheck(const MemoryOperation& operation) const {
+  if (WARN_NO_EXECUTE && noExecute(operation.getAddress())) {
+     LOKI_WARN << this->name() << " fetching instructions from no-execute address" << endl;
+     LOKI_WARN << "  " << operation.toString() << endl;
+  }
+}
+
+void MainMemory::writeWord(SRAMAddress position, uint32_t data, MemoryAccessMode mode, bool magic) {
+  MemoryBase::writeWord(position, data, mode, magic);
+  reservations.clearReservation(position);
+}
+
 
 bool MainMemory::readOnly(MemoryAddr addr) const {
-  for (uint i=0; i<readOnlyBase.size(); i++) {
-    if ((addr >= readOnlyBase[i]) && (addr < readOnlyLimit[i])) {
-      return true;
+  page_attributes_t attributes = pageAttributes(addr);
+
+  if (attributes & PAGE_READ_ONLY)
+    return true;
+  else if (!(attributes & PAGE_PARTIAL_READ_ONLY))
+    return false;
+
+  // Find the last region starting at or before addr.
+  std::map<MemoryAddr, MemoryAddr>::const_iterator it = partialReadOnly.upper_bound(addr);
+  if (it == partialReadOnly.begin())
+    return false;
+  --it;
+  return addr < it->second;
+}
+
+bool MainMemory::noExecute(MemoryAddr addr) const {
+  return pageAttributes(addr) & PAGE_NO_EXECUTE;
+}
+
+bool MainMemory::uncached(MemoryAddr addr) const {
+  return pageAttributes(addr) & PAGE_UNCACHED;
+}
+
+MainMemory::page_attributes_t MainMemory::pageAttributes(MemoryAddr addr) const {
+  size_t page = pageIndex(addr);
+  return (page < pageAttributes_.size()) ? pageAttributes_[page] : 0;
+}
+
+void MainMemory::setPageAttributes(MemoryAddr start, MemoryAddr end,
+                                   page_attributes_t attributes) {
+  if (end <= start)
+    return;
+
+  loki_assert_with_message(pageIndex(end - 1) < pageAttributes_.size(),
+                           "Upper limit = 0x%x", end);
+
+  // Read-only status is tracked exactly. Pages only partly covered are
+  // flagged so that lookups consult the list of regions.
+  if (attributes & PAGE_READ_ONLY) {
+    attributes &= ~PAGE_READ_ONLY;
+
+    MemoryAddr pageSize = 1 << log2PageSize;
+    MemoryAddr firstWhole = (start + pageSize - 1) & ~(pageSize - 1);
+    MemoryAddr lastWhole = end & ~(pageSize - 1);
+
+    if (firstWhole >= lastWhole) {
+      addReadOnlyRegion(start, end);
+    }
+    else {
+      if (start < firstWhole)
+        addReadOnlyRegion(start, firstWhole);
+      if (lastWhole < end)
+        addReadOnlyRegion(lastWhole, end);
+      for (size_t page = pageIndex(firstWhole); page < pageIndex(lastWhole); page++)
+        pageAttributes_[page] |= PAGE_READ_ONLY;
     }
   }
 
-  return false;
+  if (attributes != 0)
+    for (size_t page = pageIndex(start); page <= pageIndex(end - 1); page++)
+      pageAttributes_[page] |= attributes;
 }
 
-void MainMemory::claimCacheLine(ComponentID bank, MemoryAddr address) {
-  uint tile = parent().computeTileIndex(bank.tile);
-  uint cacheLine = MemoryBase::getLine(address);
+void MainMemory::addReadOnlyRegion(MemoryAddr start, MemoryAddr end) {
+  // Regions are kept disjoint so a lookup only needs to check the nearest
+  // region starting before the address. Absorb any which overlap or touch
+  // this one.
+  std::map<MemoryAddr, MemoryAddr>::iterator it = partialReadOnly.upper_bound(start);
+  if (it != partialReadOnly.begin()) {
+    --it;
+    if (it->second < start)
+      ++it;
+  }
+
+  while (it != partialReadOnly.end() && it->first <= end) {
+    start = std::min(start, it->first);
+    end = std::max(end, it->second);
+    partialReadOnly.erase(it++);
+  }
 
-  loki_assert_with_message(cacheLine < cacheLineValid.size(), "Address = 0x%x", address);
+  partialReadOnly[start] = end;
+  markPartialReadOnly(start, end);
+}
+
+void MainMemory::markPartialReadOnly(MemoryAddr start, MemoryAddr end) {
+  for (size_t page = pageIndex(start); page <= pageIndex(end - 1); page++)
+    pageAttributes_[page] |= PAGE_PARTIAL_READ_ONLY;
+}
+
+size_t MainMemory::pageIndex(MemoryAddr address) const {
+  return address >> log2PageSize;
+}
+
+cycle_count_t MainMemory::claimCacheLine(ComponentID bank, MemoryAddr address) {
+  uint tile = parent().computeTileIndex(bank.tile);
+  DirectoryEntry& entry = directoryEntry(address);
+  RecallCost cost(parent().memoryController(bank.tile, address));
 
   // This is now the only tile with an up-to-date copy of the data.
-  cacheLineValid[cacheLine] = (1 << tile);
+  if (coherent()) {
+    if (entry.state != LINE_MODIFIED || !entry.sharers.contains(tile))
+      Instrumentation::Coherence::upgrade();
+    takeOwnership(entry, tile, address, cost);
+  }
+  else
+    entry.sharers.setOnly(tile);
+
+  return recallDelay(cost);
+}
+
+bool MainMemory::coherent() const {
+  return coherence != COHERENCE_NONE;
+}
+
+bool MainMemory::interleaved() const {
+  return interleaving != INTERLEAVE_NONE;
+}
+
+uint MainMemory::numChannels() const {
+  return handlers.size();
+}
+
+uint MainMemory::channel(MemoryAddr address) const {
+  switch (interleaving) {
+    case INTERLEAVE_LINE:
+      return getLine(address) % numChannels();
+    case INTERLEAVE_PAGE:
+      return (address >> log2PageSize) % numChannels();
+    case INTERLEAVE_XOR:
+      return AddressHash(AddressHash::HASH_XOR_FOLD, 0).map(getLine(address), numChannels());
+    case INTERLEAVE_NONE:
+    default:
+      return 0;
+  }
+}
+
+cycle_count_t MainMemory::requestWritePermission(ComponentID bank, MemoryAddr address) {
+  if (!coherent())
+    return 0;
+
+  uint tile = parent().computeTileIndex(bank.tile);
+  DirectoryEntry& entry = directoryEntry(address);
+  RecallCost cost(parent().memoryController(bank.tile, address));
+  bool owner = (entry.state == LINE_EXCLUSIVE || entry.state == LINE_MODIFIED)
+            && entry.sharers.contains(tile);
+
+  // This tile already holds the only copy, so no other tiles need to be
+  // contacted.
+  if (owner) {
+    if (entry.state == LINE_EXCLUSIVE)
+      Instrumentation::Coherence::silentUpgrade();
+    entry.state = LINE_MODIFIED;
+  }
+  else {
+    LOKI_LOG(2) << this->name() << " tile " << bank.tile << " upgrading "
+        << LOKI_HEX(address) << endl;
+    Instrumentation::Coherence::upgrade();
+    takeOwnership(entry, tile, address, cost);
+  }
+
+  return recallDelay(cost);
 }
 
-void MainMemory::storeData(vector<Word>& data, MemoryAddr location, bool readOnly) {
-  size_t count = data.size();
+void MainMemory::storeData(vector<Word>& data, MemoryAddr location,
+                           bool readOnly, bool executable) {
+  prepareStore(data.size(), location, readOnly, executable);
+
   uint32_t address = location / BYTES_PER_WORD;
+  for (size_t i = 0; i < data.size(); i++)
+    mData[address + i] = data[i].toUInt();
+}
 
+void MainMemory::storeData(const uint32_t* data, size_t count,
+                           MemoryAddr location, bool readOnly,
+                           bool executable) {
+  prepareStore(count, location, readOnly, executable);
+
+  uint32_t address = location / BYTES_PER_WORD;
+  memcpy(&mData[address], data, count*BYTES_PER_WORD);
+}
+
+void MainMemory::prepareStore(size_t count, MemoryAddr location, bool readOnly,
+                              bool executable) {
   checkAlignment(location, BYTES_PER_WORD);
   loki_assert_with_message(location + count*BYTES_PER_WORD < mData.size()*BYTES_PER_WORD, "Upper limit = 0x%x", location + count*BYTES_PER_WORD);
 
-  for (size_t i = 0; i < count; i++) {
-    LOKI_LOG(3) << this->name() << " wrote to " << LOKI_HEX((address+i)*BYTES_PER_WORD) << ": " << data[i].toUInt() << endl;
+  LOKI_LOG(3) << this->name() << " storing " << count << " words at "
+      << LOKI_HEX(location) << (readOnly ? " (read-only)" : "") << endl;
 
-    loki_assert(address+i < mData.size());
-    mData[address + i] = data[i].toUInt();
-  }
+  MemoryAddr end = location + count*BYTES_PER_WORD;
 
-  if (readOnly) {
-    readOnlyBase.push_back(location);
-    readOnlyLimit.push_back(location + count*BYTES_PER_WORD);
+  if (readOnly)
+    setPageAttributes(location, end, PAGE_READ_ONLY);
+
+  // Code and data may share a page, so only mark pages which are entirely
+  // non-executable.
+  if (!executable) {
+    MemoryAddr pageSize = 1 << log2PageSize;
+    MemoryAddr firstWhole = (location + pageSize - 1) & ~(pageSize - 1);
+    MemoryAddr lastWhole = end & ~(pageSize - 1);
+    setPageAttributes(firstWhole, lastWhole, PAGE_NO_EXECUTE);
   }
 }
 
@@ -189,21 +383,26 @@ void MainMemory::print(MemoryAddr start, MemoryAddr end) const {
   }
 }
 
-bool MainMemory::canStartRequest() const {
-  return activeRequests < oData.size();
+bool MainMemory::canStartRequest(uint channel) const {
+  if (interleaved())
+    return activeChannelRequests[channel] < channelBandwidth;
+  else
+    return activeRequests < oData.size();
 }
 
 const sc_event& MainMemory::canStartRequestEvent() const {
   return bandwidthAvailableEvent;
 }
 
-void MainMemory::notifyRequestStart() {
-  assert(canStartRequest());
+void MainMemory::notifyRequestStart(uint channel) {
+  assert(canStartRequest(channel));
   activeRequests++;
+  activeChannelRequests[channel]++;
 }
 
-void MainMemory::notifyRequestComplete() {
+void MainMemory::notifyRequestComplete(uint channel) {
   activeRequests--;
+  activeChannelRequests[channel]--;
   bandwidthAvailableEvent.notify(sc_core::SC_ZERO_TIME);
 }
 
@@ -215,28 +414,171 @@ vector<uint32_t>& MainMemory::dataArray() {
   return mData;
 }
 
-void MainMemory::checkSafeRead(MemoryAddr address, TileID requester) {
+cycle_count_t MainMemory::checkSafeRead(MemoryAddr address, TileID requester) {
   uint tile = parent().computeTileIndex(requester);
-  uint cacheLine = MemoryBase::getLine(address);
+  DirectoryEntry& entry = directoryEntry(address);
+  RecallCost cost(parent().memoryController(requester, address));
+
+  if (coherent()) {
+    // An exclusive owner on another tile must give up write permission and
+    // provide any data it has modified before the read can proceed.
+    bool exclusive = (entry.state == LINE_EXCLUSIVE || entry.state == LINE_MODIFIED);
+    if (exclusive && !entry.sharers.contains(tile)) {
+      entry.sharers.forEach([&](uint owner) {
+        bool dirty = recallCacheLine(owner, address, false, cost);
+        Instrumentation::Coherence::downgrade(dirty);
+      });
+    }
 
-  loki_assert_with_message(cacheLine < cacheLineValid.size(), "Address = 0x%x", address);
+    entry.sharers.add(tile);
 
-  // After reading, this tile has an up-to-date copy of the data.
-  cacheLineValid[cacheLine] |= (1 << tile);
+    // With MESI, a tile which is the only reader may later write without
+    // consulting the directory.
+    if (coherence == COHERENCE_MESI && entry.sharers.count() == 1)
+      entry.state = LINE_EXCLUSIVE;
+    else
+      entry.state = LINE_SHARED;
+  }
+  else {
+    // After reading, this tile has an up-to-date copy of the data.
+    entry.sharers.add(tile);
+  }
+
+  return recallDelay(cost);
 }
 
 void MainMemory::checkSafeWrite(MemoryAddr address, TileID requester) {
   uint tile = parent().computeTileIndex(requester);
-  uint cacheLine = MemoryBase::getLine(address);
+  DirectoryEntry& entry = directoryEntry(address);
 
-  loki_assert_with_message(cacheLine < cacheLineValid.size(), "Address = 0x%x", address);
-
-  if (WARN_INCOHERENCE && !(cacheLineValid[cacheLine] & (1 << tile)))
+  if (WARN_INCOHERENCE && !entry.sharers.contains(tile))
     LOKI_WARN << "Tile " << requester << " overwrote cache line "
     << LOKI_HEX(address) << " in main memory using potentially stale data." << endl;
 
-  // After writing, this is the only tile with an up-to-date copy of the data.
-  cacheLineValid[cacheLine] = (1 << tile);
+  if (coherent()) {
+    // The writer keeps a clean copy. Under MESI it is still the only holder,
+    // so may write again without asking.
+    if (entry.sharers.contains(tile) && entry.state == LINE_MODIFIED)
+      entry.state = (coherence == COHERENCE_MESI) ? LINE_EXCLUSIVE : LINE_SHARED;
+  }
+  else {
+    // After writing, this is the only tile with an up-to-date copy of the data.
+    entry.sharers.setOnly(tile);
+  }
+}
+
+bool MainMemory::nearMemoryOperation(MemoryOpcode opcode) {
+  switch (opcode) {
+    case LOAD_W:
+    case LOAD_HW:
+    case LOAD_B:
+    case STORE_W:
+    case STORE_HW:
+    case STORE_B:
+    case LOAD_LINKED:
+    case STORE_CONDITIONAL:
+    case LOAD_AND_ADD:
+    case LOAD_AND_OR:
+    case LOAD_AND_AND:
+    case LOAD_AND_XOR:
+    case EXCHANGE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+cycle_count_t MainMemory::prepareDirectAccess(MemoryAddr address, TileID requester, bool modify) {
+  DirectoryEntry& entry = directoryEntry(address);
+  RecallCost cost(parent().memoryController(requester, address));
+
+  if (coherent()) {
+    // Retrieve modified data from its owner. Copies must be discarded if they
+    // are about to become stale.
+    entry.sharers.forEach([&](uint sharer) {
+      if (modify || entry.state == LINE_EXCLUSIVE || entry.state == LINE_MODIFIED) {
+        bool dirty = recallCacheLine(sharer, address, modify, cost);
+        if (modify)
+          Instrumentation::Coherence::invalidation(dirty);
+        else
+          Instrumentation::Coherence::downgrade(dirty);
+      }
+    });
+
+    if (modify) {
+      entry.sharers.clear();
+      entry.state = LINE_INVALID;
+    }
+    else if (!entry.sharers.empty())
+      entry.state = LINE_SHARED;
+  }
+  else if (modify) {
+    // Software is responsible for keeping caches coherent, but any cached
+    // copies are now out of date.
+    if (WARN_INCOHERENCE && !entry.sharers.empty())
+      LOKI_WARN << "Tile " << requester << " modified cache line "
+      << LOKI_HEX(address) << " in main memory while it was cached." << endl;
+
+    entry.sharers.clear();
+  }
+
+  // Copies in the last-level cache never hold modified data, so can simply be
+  // dropped.
+  if (modify)
+    parent().invalidateLastLevelCaches(getTag(address));
+
+  return recallDelay(cost);
+}
+
+MainMemory::DirectoryEntry& MainMemory::directoryEntry(MemoryAddr address) {
+  uint cacheLine = MemoryBase::getLine(address);
+  loki_assert_with_message(cacheLine < numCacheLines, "Address = 0x%x", address);
+  return directory[cacheLine];
+}
+
+void MainMemory::takeOwnership(DirectoryEntry& entry, uint tile, MemoryAddr address,
+                               RecallCost& cost) {
+  entry.sharers.forEach([&](uint sharer) {
+    if (sharer != tile) {
+      bool dirty = recallCacheLine(sharer, address, true, cost);
+      Instrumentation::Coherence::invalidation(dirty);
+    }
+  });
+
+  entry.sharers.setOnly(tile);
+  entry.state = LINE_MODIFIED;
+}
+
+bool MainMemory::recallCacheLine(uint tile, MemoryAddr address, bool invalidate,
+                                 RecallCost& cost) {
+  TileID tileID = parent().computeTileID(tile);
+
+  LOKI_LOG(2) << this->name() << (invalidate ? " invalidating " : " downgrading ")
+      << LOKI_HEX(getTag(address)) << " on tile " << tileID << endl;
+
+  bool dirty = parent().recallCacheLine(tileID, getTag(address), invalidate);
+
+  // Any copies between the tiles and main memory are now out of date.
+  if (dirty)
+    parent().invalidateLastLevelCaches(getTag(address));
+
+  // The recall and its acknowledgement each take one cycle per router
+  // crossed, and the bank takes a cycle to respond. Written-back data follows
+  // the acknowledgement, one flit per cycle.
+  uint hops = std::abs((int)tileID.x - (int)cost.home.x)
+            + std::abs((int)tileID.y - (int)cost.home.y);
+  cycle_count_t roundTrip = 2*hops + 1 + (dirty ? cacheLineWords() : 0);
+
+  cost.cycles = std::max(cost.cycles, cost.sent + roundTrip);
+  cost.sent++;
+
+  return dirty;
+}
+
+cycle_count_t MainMemory::recallDelay(const RecallCost& cost) const {
+  if (cost.cycles > 0)
+    Instrumentation::Coherence::recallDelay(cost.cycles);
+  return cost.cycles;
 }
 
 Chip& MainMemory::parent() const {
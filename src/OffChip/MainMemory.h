@@ -3,8 +3,14 @@
  *
  * Main memory model.
  *
- * Accepts one request at a time, and only supports FETCH_LINE and STORE_LINE
- * operations.
+ * Accepts one request at a time on each memory controller's interface.
+ * Addresses may optionally be interleaved across the controllers, so each
+ * controller owns one independent channel of memory and serves all requests
+ * for its addresses.
+ * Caches fetch and store whole lines; word accesses and atomic operations
+ * which bypass all caches are performed directly on the data here, so that
+ * synchronisation variables shared by many tiles need not be homed in a
+ * single memory bank.
  *
  *  Created on: 21 Apr 2016
  *      Author: db434
@@ -13,7 +19,11 @@
 #ifndef SRC_TILE_MEMORY_MAINMEMORY_H_
 #define SRC_TILE_MEMORY_MAINMEMORY_H_
 
+#include <map>
+#include <unordered_map>
 #include "../Memory/MemoryBase.h"
+#include "../Memory/SharerSet.h"
+#include "../Tile/Memory/ReservationHandler.h"
 #include "../Utility/LokiVector.h"
 #include "MainMemoryRequestHandler.h"
 
@@ -41,6 +51,34 @@ public:
 
 public:
 
+  // Protection attributes which can be applied to each page of memory.
+  enum PageAttribute {
+    PAGE_READ_ONLY         = 1 << 0, // Writes are not allowed
+    PAGE_NO_EXECUTE        = 1 << 1, // Instructions may not be fetched
+    PAGE_UNCACHED          = 1 << 2, // Accesses should bypass the caches
+    PAGE_PARTIAL_READ_ONLY = 1 << 3  // Only part of the page is read-only
+  };
+  typedef uint8_t page_attributes_t;
+
+  // Granularity at which attributes are recorded.
+  static const uint log2PageSize = 12;
+
+  // Hardware cache coherence options. With no protocol, software is
+  // responsible for flushing and invalidating cache lines.
+  enum CoherenceProtocol {
+    COHERENCE_NONE = 0,
+    COHERENCE_MSI  = 1,
+    COHERENCE_MESI = 2
+  };
+
+  // How addresses are divided between memory channels.
+  enum Interleaving {
+    INTERLEAVE_NONE = 0, // One shared channel, reached through any controller
+    INTERLEAVE_LINE = 1, // Consecutive cache lines on consecutive channels
+    INTERLEAVE_PAGE = 2, // Consecutive pages on consecutive channels
+    INTERLEAVE_XOR  = 3  // Cache line address XOR-folded to pick a channel
+  };
+
   MainMemory(sc_module_name name, uint controllers,
              const main_memory_parameters_t& params);
 
@@ -93,15 +131,74 @@ public:
   // Check whether it is safe for the given operation to modify memory.
   virtual void preWriteCheck(const MemoryOperation& operation) const;
 
+  // Check whether instructions may be fetched by the given operation.
+  virtual void preExecuteCheck(const MemoryOperation& operation) const;
+
+  // Override writeWord so conflicting reservations are cleared.
+  virtual void writeWord(SRAMAddress position, uint32_t data, MemoryAccessMode mode, bool magic=false);
+
   // Check whether a memory location is read-only.
   bool readOnly(MemoryAddr addr) const;
 
+  // Check other protection attributes of a memory location.
+  bool noExecute(MemoryAddr addr) const;
+  bool uncached(MemoryAddr addr) const;
+
+  // All attributes of the page containing the given address.
+  page_attributes_t pageAttributes(MemoryAddr addr) const;
+
+  // Apply attributes to all pages overlapping [start, end).
+  // PAGE_READ_ONLY is tracked exactly, even when the region does not cover
+  // whole pages.
+  void setPageAttributes(MemoryAddr start, MemoryAddr end, page_attributes_t attributes);
+
   // Update coherence information in cases where data doesn't need to be loaded
   // from main memory (e.g. memset).
-  void claimCacheLine(ComponentID bank, MemoryAddr address);
+  //
+  // This and the other coherence methods below return the number of cycles
+  // the caller must wait for other tiles to acknowledge recall messages
+  // before the line is granted (0 if no other tiles were involved).
+  cycle_count_t claimCacheLine(ComponentID bank, MemoryAddr address);
+
+  // Is a hardware coherence protocol in use?
+  bool coherent() const;
+
+  // Is each memory controller responsible for a subset of addresses?
+  bool interleaved() const;
+
+  // The number of independent memory channels: one per memory controller.
+  uint numChannels() const;
+
+  // The channel (memory controller port) responsible for `address`. Only
+  // meaningful if memory is interleaved.
+  uint channel(MemoryAddr address) const;
+
+  // `bank` is about to modify a clean cached copy of `address`. If a coherence
+  // protocol is in use, all copies on other tiles are invalidated first.
+  cycle_count_t requestWritePermission(ComponentID bank, MemoryAddr address);
+
+  // Keep track of which tiles have valid copies of which data. This is used
+  // to enforce coherence if a protocol is in use, or to detect incoherent
+  // memory use otherwise. Caches between the tiles and main memory must call
+  // these for any requests they serve themselves.
+  cycle_count_t checkSafeRead(MemoryAddr address, TileID requester);
+  void checkSafeWrite(MemoryAddr address, TileID requester);
+
+  // Returns whether an operation is performed directly on the data in main
+  // memory, rather than moving a cache line to or from a cache.
+  static bool nearMemoryOperation(MemoryOpcode opcode);
+
+  // A near-memory operation or DMA transfer from `requester` is about to
+  // access `address`.
+  // Any modified copies are written back first, and if the operation may
+  // modify the data, all cached copies are invalidated.
+  cycle_count_t prepareDirectAccess(MemoryAddr address, TileID requester, bool modify);
 
   // Store initial program data.
-  void storeData(vector<Word>& data, MemoryAddr location, bool readOnly);
+  void storeData(vector<Word>& data, MemoryAddr location, bool readOnly,
+                 bool executable=true);
+  void storeData(const uint32_t* data, size_t count, MemoryAddr location,
+                 bool readOnly, bool executable=true);
 
   void print(MemoryAddr start, MemoryAddr end) const;
 
@@ -109,15 +206,16 @@ public:
   // Messages between this centralised memory and each of the request handlers.
 
   // Is a request handler allowed to start a new request? It may not be allowed
-  // if the maximum number of requests are already in progress.
-  bool canStartRequest() const;
+  // if the maximum number of requests are already in progress. Interleaved
+  // channels are independent, so each is only limited by its own requests.
+  bool canStartRequest(uint channel) const;
 
   // Event triggered whenever it is possible to start a new request.
   const sc_event& canStartRequestEvent() const;
 
   // Tell this memory whenever a request starts or completes.
-  void notifyRequestStart();
-  void notifyRequestComplete();
+  void notifyRequestStart(uint channel);
+  void notifyRequestComplete(uint channel);
 
 protected:
 
@@ -126,9 +224,62 @@ protected:
 
 private:
 
-  // Keep track of which tiles have valid copies of which data for debugging.
-  void checkSafeRead(MemoryAddr address, TileID requester);
-  void checkSafeWrite(MemoryAddr address, TileID requester);
+
+  // Coherence state of a single cache line.
+  enum LineState {
+    LINE_INVALID,   // No tile has a copy
+    LINE_SHARED,    // Any number of tiles have clean copies
+    LINE_EXCLUSIVE, // One tile has a clean copy, and may modify it silently
+    LINE_MODIFIED   // One tile has a copy which may be dirty
+  };
+
+  struct DirectoryEntry {
+    LineState state;
+    SharerSet sharers;
+
+    DirectoryEntry() : state(LINE_INVALID) {}
+  };
+
+  // The time taken by the recalls needed for one coherence action. Recall
+  // messages leave the memory controller one per cycle and are served in
+  // parallel, so the action completes when the last acknowledgement returns.
+  struct RecallCost {
+    TileID        home;     // Memory controller sending the recalls
+    uint          sent;     // Recall messages sent so far
+    cycle_count_t cycles;   // Cycles until all acknowledgements have returned
+
+    RecallCost(TileID home) : home(home), sent(0), cycles(0) {}
+  };
+
+  DirectoryEntry& directoryEntry(MemoryAddr address);
+
+  // Make `tile` the only holder of a cache line, invalidating all other
+  // copies. Dirty copies are written back first.
+  void takeOwnership(DirectoryEntry& entry, uint tile, MemoryAddr address,
+                     RecallCost& cost);
+
+  // Retrieve any dirty data for `address` from the given tile, and optionally
+  // invalidate its copy. Returns whether any data was written back. The
+  // round trip to the tile is added to `cost`.
+  bool recallCacheLine(uint tile, MemoryAddr address, bool invalidate,
+                       RecallCost& cost);
+
+  // Record the delay caused by a coherence action, and return it.
+  cycle_count_t recallDelay(const RecallCost& cost) const;
+
+  // Check that `count` words can be stored at `location`, and record the
+  // region's protection attributes.
+  void prepareStore(size_t count, MemoryAddr location, bool readOnly,
+                    bool executable);
+
+  // Record a read-only region which does not cover whole pages. Overlapping
+  // regions are merged.
+  void addReadOnlyRegion(MemoryAddr start, MemoryAddr end);
+
+  // Flag all pages overlapping a partial read-only region.
+  void markPartialReadOnly(MemoryAddr start, MemoryAddr end);
+
+  size_t pageIndex(MemoryAddr address) const;
 
   Chip& parent() const;
 
@@ -162,13 +313,36 @@ private:
   // of the line which has already been processed by the other.
   unsigned int       activeRequests;
 
-  // Mainly for debug, mark the read-only sections of the address space.
-  vector<MemoryAddr> readOnlyBase, readOnlyLimit;
+  // If memory is interleaved, the number of requests in flight on each
+  // channel, and the maximum allowed on any one channel.
+  vector<unsigned int> activeChannelRequests;
+  const unsigned int channelBandwidth;
+
+  // Protection attributes for each page of memory.
+  vector<page_attributes_t> pageAttributes_;
+
+  // Disjoint read-only regions which only partly cover a page, indexed by
+  // start address and holding the end address. Only consulted for pages marked
+  // PAGE_PARTIAL_READ_ONLY, so the common case is a single array lookup.
+  std::map<MemoryAddr, MemoryAddr> partialReadOnly;
+
+  // Coherence directory: record which tiles have an up-to-date copy of each
+  // cache line. Without a coherence protocol, this is only used to detect
+  // incoherent memory use. Only lines which have been accessed are present,
+  // so this scales with the working set rather than with the size of memory.
+  // Any number of tiles is supported.
+  std::unordered_map<MemoryAddr, DirectoryEntry> directory;
+
+  const CoherenceProtocol coherence;
+
+  const Interleaving interleaving;
+
+  // Load-linked reservations made by near-memory operations. The requester is
+  // the last component to forward the request: usually a memory bank.
+  ReservationHandler reservations;
 
-  // For debug: record which tiles have an up-to-date copy of each cache line
-  // so we can detect incoherent memory use.
-  // Each entry in the vector represents a bitmask of all tiles on chip (< 32).
-  vector<uint>       cacheLineValid;
+  // Total number of cache lines in main memory.
+  const size_t       numCacheLines;
 
   sc_event           bandwidthAvailableEvent;
 
@@ -13,14 +13,15 @@
 #include "../Utility/Instrumentation/Network.h"
 
 MainMemoryRequestHandler::MainMemoryRequestHandler(sc_module_name name,
-    MainMemory& memory, const main_memory_parameters_t& params) :
+    MainMemory& memory, uint channel, const main_memory_parameters_t& params) :
     MemoryBase(name, memory.id, memory.log2CacheLineSize),
     iClock("iClock"),
     iData("iData"),
     oData("oData"),
     inputQueue("inQueue", 10, 100), // enough for a cache line + head flit
     outputQueue("delay", 1024 /* "infinite" size */, 100, (double)params.latency),
-    mainMemory(memory) {
+    mainMemory(memory),
+    channel(channel) {
 
   inputQueue.clock(iClock);
   outputQueue.clock(iClock);
@@ -95,7 +96,7 @@ uint32_t MainMemoryRequestHandler::getPayload(MemoryLevel level) {
   NetworkRequest request = inputQueue.read();
   uint32_t payload = request.payload().toUInt();
 
-  Instrumentation::MainMemory::receiveData(request);
+  Instrumentation::MainMemory::receiveData(channel, request);
 
   return payload;
 }
@@ -126,6 +127,20 @@ void MainMemoryRequestHandler::preWriteCheck(const MemoryOperation& operation) c
   }
 }
 
+// Check whether instructions may be fetched by the given operation.
+void MainMemoryRequestHandler::preExecuteCheck(const MemoryOperation& operation) const {
+  if (WARN_NO_EXECUTE && mainMemory.noExecute(operation.getAddress())) {
+     LOKI_WARN << this->name() << " fetching instructions from no-execute address" << endl;
+     LOKI_WARN << "  " << operation.toString() << endl;
+  }
+}
+
+void MainMemoryRequestHandler::writeWord(SRAMAddress position, uint32_t data, MemoryAccessMode mode, bool magic) {
+  // Data is stored in main memory, so reservations are held there too.
+  MemoryBase::writeWord(position, data, mode, magic);
+  mainMemory.reservations.clearReservation(position);
+}
+
 const vector<uint32_t>& MainMemoryRequestHandler::dataArray() const {
   return mainMemory.dataArray();
 }
@@ -145,14 +160,14 @@ void MainMemoryRequestHandler::processIdle() {
   loki_assert_with_message(requestState == STATE_IDLE, "State = %d", requestState);
 
   // Check with main memory that we are allowed to start a new request.
-  if (!mainMemory.canStartRequest()) {
+  if (!mainMemory.canStartRequest(channel)) {
     next_trigger(mainMemory.canStartRequestEvent());
   }
   // Check for new requests.
   else if (inputQueue.canRead()) {
     NetworkRequest request = inputQueue.read();
 
-    Instrumentation::MainMemory::receiveData(request);
+    Instrumentation::MainMemory::receiveData(channel, request);
 
     ChannelID returnAddress(request.getMemoryMetadata().returnTileX,
                             request.getMemoryMetadata().returnTileY,
@@ -162,17 +177,57 @@ void MainMemoryRequestHandler::processIdle() {
     activeRequest = std::unique_ptr<MemoryOperation>(decodeMemoryRequest(request, *this, MEMORY_OFF_CHIP, returnAddress));
 
     // Tell main memory that we've started a new request.
-    mainMemory.notifyRequestStart();
+    mainMemory.notifyRequestStart(channel);
+
+    MemoryAddr address = activeRequest->getAddress();
+    TileID requester = returnAddress.component.tile;
 
-    // Main memory only supports a subset of operations.
+    // Cycles spent waiting for other tiles to respond to coherence recalls.
+    cycle_count_t recallCycles = 0;
+
+    loki_assert_with_message(!mainMemory.interleaved() || mainMemory.channel(address) == channel,
+        "Address 0x%x sent to wrong memory channel", address);
+
+    // Main memory only supports a subset of operations. Requests which bypass
+    // all caches are performed directly on the data here.
     switch (activeRequest->getMetadata().opcode) {
       case FETCH_LINE:
-        Instrumentation::MainMemory::read(activeRequest->getAddress(), cacheLineWords());
-        mainMemory.checkSafeRead(activeRequest->getAddress(), returnAddress.component.tile);
+        Instrumentation::MainMemory::read(channel, address, cacheLineWords());
+        // DMA transfers skip the L1 and keep no copy of the line.
+        if (activeRequest->getMetadata().skipL1)
+          recallCycles = mainMemory.prepareDirectAccess(address, requester, false);
+        else
+          recallCycles = mainMemory.checkSafeRead(address, requester);
         break;
       case STORE_LINE:
-        Instrumentation::MainMemory::write(activeRequest->getAddress(), cacheLineWords());
-        mainMemory.checkSafeWrite(activeRequest->getAddress(), returnAddress.component.tile);
+        Instrumentation::MainMemory::write(channel, address, cacheLineWords());
+        if (activeRequest->getMetadata().skipL1)
+          recallCycles = mainMemory.prepareDirectAccess(address, requester, true);
+        else
+          mainMemory.checkSafeWrite(address, requester);
+        break;
+      case LOAD_W:
+      case LOAD_HW:
+      case LOAD_B:
+        Instrumentation::MainMemory::read(channel, address, 1);
+        recallCycles = mainMemory.prepareDirectAccess(address, requester, false);
+        break;
+      case STORE_W:
+      case STORE_HW:
+      case STORE_B:
+        Instrumentation::MainMemory::write(channel, address, 1);
+        recallCycles = mainMemory.prepareDirectAccess(address, requester, true);
+        break;
+      case LOAD_LINKED:
+      case STORE_CONDITIONAL:
+      case LOAD_AND_ADD:
+      case LOAD_AND_OR:
+      case LOAD_AND_AND:
+      case LOAD_AND_XOR:
+      case EXCHANGE:
+        Instrumentation::MainMemory::atomic(channel, address);
+        recallCycles = mainMemory.prepareDirectAccess(address, requester,
+                                       activeRequest->getMetadata().opcode != LOAD_LINKED);
         break;
       default:
         loki_assert_with_message(false, "%s not supported by main memory", memoryOpName(activeRequest->getMetadata().opcode).c_str());
@@ -180,7 +235,10 @@ void MainMemoryRequestHandler::processIdle() {
     }
 
     requestState = STATE_REQUEST;
-    next_trigger(sc_core::SC_ZERO_TIME);
+    if (recallCycles > 0)
+      next_trigger(recallCycles, sc_core::SC_NS);
+    else
+      next_trigger(sc_core::SC_ZERO_TIME);
 
     LOKI_LOG(1) << this->name() << " starting " << memoryOpName(activeRequest->getMetadata().opcode)
         << " request from component " << activeRequest->getDestination().component << endl;
@@ -211,7 +269,7 @@ void MainMemoryRequestHandler::processRequest() {
     activeRequest.reset();
 
     // Tell main memory that we've finished a request.
-    mainMemory.notifyRequestComplete();
+    mainMemory.notifyRequestComplete(channel);
 
     // Decode the next request immediately so it is ready to start next cycle.
     next_trigger(sc_core::SC_ZERO_TIME);
@@ -220,5 +278,5 @@ void MainMemoryRequestHandler::processRequest() {
 
 void MainMemoryRequestHandler::sentData() {
   NetworkResponse response = outputQueue.lastDataRead();
-  Instrumentation::MainMemory::sendData(response);
+  Instrumentation::MainMemory::sendData(channel, response);
 }
@@ -2,7 +2,8 @@
  * MainMemoryRequestHandler.h
  *
  * Component responsible for responding to requests on one input port of
- * main memory.
+ * main memory. If memory is interleaved, each port is an independent channel
+ * responsible for a subset of addresses.
  *
  *  Created on: 12 Oct 2016
  *      Author: db434
@@ -38,7 +39,7 @@ public:
 
   SC_HAS_PROCESS(MainMemoryRequestHandler);
   MainMemoryRequestHandler(sc_module_name name, MainMemory& memory,
-                           const main_memory_parameters_t& params);
+                           uint channel, const main_memory_parameters_t& params);
   virtual ~MainMemoryRequestHandler();
 
 //============================================================================//
@@ -90,6 +91,12 @@ public:
   // Check whether it is safe for the given operation to modify memory.
   virtual void preWriteCheck(const MemoryOperation& operation) const;
 
+  // Check whether instructions may be fetched by the given operation.
+  virtual void preExecuteCheck(const MemoryOperation& operation) const;
+
+  // Override writeWord so conflicting reservations are cleared.
+  virtual void writeWord(SRAMAddress position, uint32_t data, MemoryAccessMode mode, bool magic=false);
+
 protected:
 
   virtual const vector<uint32_t>& dataArray() const;
@@ -125,6 +132,9 @@ private:
   // request handlers all accessing the same data.
   MainMemory&           mainMemory;
 
+  // This handler's position among all of main memory's ports.
+  const uint            channel;
+
 };
 
 #endif /* SRC_TILE_MEMORY_MAINMEMORYREQUESTHANDLER_H_ */
@@ -243,10 +243,8 @@ ChannelIndex ChannelMapEntry::getReturnChannel() const {
 }
 
 uint ChannelMapEntry::computeAddressIncrement(MemoryAddr address) const {
-  uint increment = address;
-  increment &= (getMemoryGroupSize() * getLineSize() * BYTES_PER_WORD) - 1;
-  increment /= getLineSize() * BYTES_PER_WORD;
-  return increment;
+  uint line = address / (getLineSize() * BYTES_PER_WORD);
+  return bankHash_.map(line, getMemoryGroupSize());
 }
 
 void ChannelMapEntry::setAddressIncrement(uint increment) {
@@ -269,11 +267,12 @@ const sc_event& ChannelMapEntry::creditArrivedEvent() const {
   return creditArrived_;
 }
 
-ChannelMapEntry::ChannelMapEntry(ChannelID localID) :
+ChannelMapEntry::ChannelMapEntry(ChannelID localID, AddressHash bankHash) :
   id_(localID),
   data_(0),
   network_(MULTICAST),
-  addressIncrement_(0) {
+  addressIncrement_(0),
+  bankHash_(bankHash) {
 
 }
 
@@ -281,7 +280,8 @@ ChannelMapEntry::ChannelMapEntry(const ChannelMapEntry& other) :
   id_(other.id_),
   data_(other.data_),
   network_(other.network_),
-  addressIncrement_(other.addressIncrement_) {
+  addressIncrement_(other.addressIncrement_),
+  bankHash_(other.bankHash_) {
 
 }
 
@@ -289,6 +289,7 @@ ChannelMapEntry& ChannelMapEntry::operator=(const ChannelMapEntry& other) {
   id_ = other.id_;
   data_ = other.data_;
   addressIncrement_ = other.addressIncrement_;
+  bankHash_ = other.bankHash_;
 
   network_ = other.network_;
 
@@ -11,6 +11,7 @@
 #include <assert.h>
 #include "systemc"
 #include "../Datatype/Identifier.h"
+#include "../Memory/AddressHash.h"
 #include "../Memory/MemoryTypes.h"
 #include "../Types.h"
 #include "../Utility/Parameters.h"
@@ -184,7 +185,8 @@ public:
   ChannelIndex getReturnChannel() const;
 
   // Compute the increment which must be added to the ChannelID of the first
-  // memory of a group in order to access the given memory address.
+  // memory of a group in order to access the given memory address. The bank
+  // is chosen by applying this entry's hash function to the line address.
   uint computeAddressIncrement(MemoryAddr address) const;
 
   // Set the address increment, ready to be used by subsequent flits in the
@@ -201,7 +203,7 @@ public:
   // Event triggered when a credit arrives for a particular channel.
   const sc_event& creditArrivedEvent() const;
 
-  ChannelMapEntry(ChannelID localID);
+  ChannelMapEntry(ChannelID localID, AddressHash bankHash = AddressHash());
   ChannelMapEntry(const ChannelMapEntry& other);
   ChannelMapEntry& operator=(const ChannelMapEntry& other);
 
@@ -239,6 +241,9 @@ private:
   // The current address increment for this entry.
   unsigned int addressIncrement_;
 
+  // Mapping from addresses to banks within a memory group.
+  AddressHash bankHash_;
+
   // Event triggered whenever a credit arrives.
   sc_event creditArrived_;
 };
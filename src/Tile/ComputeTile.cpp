@@ -11,6 +11,7 @@
 #include "../Chip.h"
 #include "../Utility/Assert.h"
 #include "../Utility/StartUp/DataBlock.h"
+#include "../Utility/Trace/MemoryTrace.h"
 
 uint ComputeTile::numComponents() const {return numCores() + numMemories();}
 uint ComputeTile::numCores() const      {return cores.size();}
@@ -53,7 +54,7 @@ uint ComputeTile::globalMemoryIndex(ComponentID id) const {
 void ComputeTile::storeInstructions(vector<Word>& instructions, const ComponentID& component) {
   if (component.tile != id)
     chip().storeInstructions(instructions, component);
-  else {
+  else if (!MemoryTrace::replaying()) {
     loki_assert(isCore(component));
     cores[coreIndex(component)].storeData(instructions);
   }
@@ -64,7 +65,9 @@ void ComputeTile::storeData(const DataBlock& data) {
     chip().storeData(data);
   }
   else if (isCore(data.component())) {
-    cores[coreIndex(data.component())].storeData(data.payload());
+    // Cores do not execute anything while a memory trace is replayed.
+    if (!MemoryTrace::replaying())
+      cores[coreIndex(data.component())].storeData(data.payload());
   }
   else if (isMemory(data.component())) {
     LOKI_ERROR << "storing directly to memory banks is disabled since it cannot be known "
@@ -118,6 +121,15 @@ int  ComputeTile::readRegisterInternal(const ComponentID& component, RegisterInd
   }
 }
 
+void ComputeTile::countCoreEvent(const ComponentID& core, uint event) {
+  if (core.tile != id)
+    chip().countCoreEvent(core, event);
+  else if (cores.size() > 0) {
+    loki_assert(isCore(core));
+    cores[coreIndex(core)].countEvent((ControlRegisters::PerformanceEvent)event);
+  }
+}
+
 bool ComputeTile::readPredicateInternal(const ComponentID& component) const {
   if (component.tile != id)
     return chip().readPredicateInternal(component);
@@ -153,6 +165,26 @@ bool ComputeTile::backedByMainMemory(MemoryAddr address) const {
   return mhl.backedByMainMemory(address);
 }
 
+bool ComputeTile::recallCacheLine(MemoryAddr address, bool invalidate) {
+  bool dirty = false;
+  for (uint i=0; i<memories.size(); i++)
+    dirty |= memories[i].recallCacheLine(address, invalidate);
+  return dirty;
+}
+
+MemoryBank& ComputeTile::memoryBank(const ComponentID& bank) {
+  loki_assert(bank.tile == id && isMemory(bank));
+  return memories[memoryIndex(bank)];
+}
+
+void ComputeTile::updateDirectoryEntry(MemoryAddr address, uint data) {
+  mhl.updateDirectoryEntry(address, data);
+}
+
+void ComputeTile::updateDirectoryMask(uint maskLSB) {
+  mhl.updateDirectoryMask(maskLSB);
+}
+
 void ComputeTile::makeComponents(const tile_parameters_t& params) {
 
   // Initialise the cores of this tile
@@ -164,6 +196,13 @@ void ComputeTile::makeComponents(const tile_parameters_t& params) {
                        params.numMemories);
 
     cores.push_back(c);
+
+    if (MemoryTrace::replaying()) {
+      MemoryTraceInjector* injector =
+          new MemoryTraceInjector(sc_gen_unique_name("injector"), coreID,
+                                  params.core);
+      injectors.push_back(injector);
+    }
   }
 
   // Initialise the memories of this tile
@@ -193,20 +232,38 @@ void ComputeTile::wireUp(const tile_parameters_t& params) {
 
     core.clock(clock);
 
-    coreToMemory.inputs[i](core.oMemory);
     coreToCore.inputs[i](core.oMulticast);
     creditReturn.outputs[i](core.iCredit);
 
     for (uint j=0; j<totalInputs; j++) {
       icu.iFlowControl[i][j](core.iData[j]);
       coreToCore.outputs[i * totalInputs + j](core.iData[j]);
+    }
+
+    // When replaying a memory trace, the injector sends all memory requests
+    // and receives all responses instead of the core.
+    if (MemoryTrace::replaying()) {
+      MemoryTraceInjector& injector = injectors[i];
+      injector.clock(clock);
+      coreToMemory.inputs[i](injector.oMemory);
+
+      for (uint j=0; j<totalInputs; j++) {
+        if (j < instructionInputs)
+          instructionReturn.outputs[i * instructionInputs + j](injector.iData[j]);
+        dataReturn.outputs[i * totalInputs + j](injector.iData[j]);
+      }
+    }
+    else {
+      coreToMemory.inputs[i](core.oMemory);
 
-      if (j < instructionInputs)
-        instructionReturn.outputs[i * instructionInputs + j](core.iData[j]);
+      for (uint j=0; j<totalInputs; j++) {
+        if (j < instructionInputs)
+          instructionReturn.outputs[i * instructionInputs + j](core.iData[j]);
 
-      // The return crossbar actually connects to instruction inputs as well.
-      // It also handles data coming from the router.
-      dataReturn.outputs[i * totalInputs + j](core.iData[j]);
+        // The return crossbar actually connects to instruction inputs as well.
+        // It also handles data coming from the router.
+        dataReturn.outputs[i * totalInputs + j](core.iData[j]);
+      }
     }
   }
 
@@ -230,6 +287,14 @@ void ComputeTile::wireUp(const tile_parameters_t& params) {
   bankToMHLRequests.outputs[0](mhl.iRequestFromBanks);
   mhlToBankResponses.inputs[0](mhl.oResponseToBanks);
 
+  // The DMA engine sits after the memory banks on the networks to and from
+  // the MHL, and sends completion notifications through the return crossbar.
+  dma.clock(clock);
+  bankToMHLRequests.inputs[memories.size()](dma.oRequest);
+  for (uint i=0; i<dma.iResponse.size(); i++)
+    mhlToBankResponses.outputs[memories.size() + i](dma.iResponse[i]);
+  dataReturn.inputs[memories.size()](dma.oData);
+
   l2l.oRequestToBanks(l2lToBankRequests);
   bankToL2LResponses.outputs[0](l2l.iResponseFromBanks);
 
@@ -268,6 +333,7 @@ ComputeTile::ComputeTile(const sc_module_name& name, const TileID& id,
     mhl("mhl", params),
     l2l("l2l", params),
     icu("icu", params),
+    dma("dma", params),
     coreToCore("c2c", params),
     coreToMemory("fwdxbar", params),
     dataReturn("dxbar", params),
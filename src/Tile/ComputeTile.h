@@ -12,6 +12,8 @@
 
 #include "Tile.h"
 #include "Core/Core.h"
+#include "Core/MemoryTraceInjector.h"
+#include "Memory/DMAEngine.h"
 #include "Memory/MemoryBank.h"
 #include "Memory/MissHandlingLogic.h"
 #include "Network/CoreMulticast.h"
@@ -104,6 +106,7 @@ public:
   virtual bool readPredicateInternal(const ComponentID& component) const;
   virtual void networkSendDataInternal(const NetworkData& flit);
   virtual void networkSendCreditInternal(const NetworkCredit& flit);
+  virtual void countCoreEvent(const ComponentID& core, uint event);
 
   // Each tile modifies the address of outgoing memory addresses. Determine the
   // ultimate address in main memory that this address maps to.
@@ -114,6 +117,15 @@ public:
   // memory hierarchy.
   bool    backedByMainMemory(MemoryAddr address) const;
 
+  // Write back any dirty copy of the given main memory cache line, and
+  // optionally invalidate it. Returns whether any dirty data was found.
+  bool    recallCacheLine(MemoryAddr address, bool invalidate);
+
+  // Direct access for magic memory, bypassing all networks.
+  MemoryBank& memoryBank(const ComponentID& bank);
+  void    updateDirectoryEntry(MemoryAddr address, uint data);
+  void    updateDirectoryMask(uint maskLSB);
+
 private:
 
   void makeComponents(const tile_parameters_t& params);
@@ -130,10 +142,15 @@ private:
 private:
 
   LokiVector<Core>          cores;
+
+  // When replaying a memory trace, these take the place of the cores on the
+  // memory networks. Empty otherwise.
+  LokiVector<MemoryTraceInjector> injectors;
   LokiVector<MemoryBank>    memories;
   MissHandlingLogic         mhl;
   L2Logic                   l2l;
   IntertileUnit             icu;
+  DMAEngine                 dma;
 
   friend class Core;
   friend class MemoryBank;
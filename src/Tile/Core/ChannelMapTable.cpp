@@ -110,7 +110,8 @@ ChannelMapTable::ChannelMapTable(const sc_module_name& name,
 
   loki_assert(params.size > 0);
 
+  AddressHash bankHash(params.bankHash, params.bankPermutation);
   for (uint i=0; i<params.size; i++)
-    table.push_back(ChannelID());
+    table.push_back(ChannelMapEntry(ChannelID(), bankHash));
 
 }
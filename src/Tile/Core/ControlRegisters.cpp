@@ -8,6 +8,8 @@
 #include "ControlRegisters.h"
 
 #include "../../Utility/Assert.h"
+#include "../../Utility/Instrumentation/Stalls.h"
+#include "Core.h"
 
 ControlRegisters::ControlRegisters(const sc_module_name& name, ComponentID id) :
     LokiComponent(name),
@@ -24,10 +26,13 @@ ControlRegisters::~ControlRegisters() {
   // Do nothing
 }
 
-int32_t ControlRegisters::read(RegisterIndex reg) const {
+int32_t ControlRegisters::read(RegisterIndex reg, ThreadIndex thread) const {
   loki_assert_with_message(reg < registers.size(), "Register %d", reg);
   // TODO: check access mask
 
+  if (reg == CR_THREAD_ID)
+    return thread;
+
   return registers[reg];
 }
 
@@ -39,24 +44,29 @@ void ControlRegisters::write(RegisterIndex reg, int32_t value) {
   // TODO: are any others read-only? The counters?
   assert(reg != CR_CPU_LOCATION);
 
+  // Writing the status register clears the flags which are set in `value`.
+  if (reg == CR_COUNT_STATUS) {
+    registers[reg] &= ~value;
+    return;
+  }
+
   registers[reg] = value;
 
-  if ((reg == CR_COUNT0_CONFIG || reg == CR_COUNT1_CONFIG) &&
-      (value == CFG_COUNT_CYCLES))
+  if (reg == CR_THREAD_START)
+    parent().startThread(value);
+
+  if ((reg == CR_COUNT0_CONFIG || reg == CR_COUNT1_CONFIG) && countingCycles())
     startCycleCount.notify();
 }
 
 void ControlRegisters::instructionExecuted() {
-  if (registers[CR_COUNT0_CONFIG] == CFG_COUNT_INSTRUCTIONS) {
-    registers[CR_COUNT0]++;
-    if (registers[CR_COUNT0] == registers[CR_COMPARE0])
-      interrupt();
-  }
-  if (registers[CR_COUNT1_CONFIG] == CFG_COUNT_INSTRUCTIONS) {
-    registers[CR_COUNT1]++;
-    if (registers[CR_COUNT1] == registers[CR_COMPARE1])
-      interrupt();
-  }
+  countEvent(EVENT_INSTRUCTIONS);
+}
+
+void ControlRegisters::countEvent(PerformanceEvent event) {
+  for (uint counter=0; counter<NUM_COUNTERS; counter++)
+    if (counterEvent(counter) == (uint)event)
+      increment(counter);
 }
 
 void ControlRegisters::interrupt() {
@@ -69,26 +79,72 @@ void ControlRegisters::cycleCounter() {
   else if (!clock.posedge())
     next_trigger(clock.posedge_event());
   else {
-    if (registers[CR_COUNT0_CONFIG] == CFG_COUNT_CYCLES) {
-      registers[CR_COUNT0]++;
-      if (registers[CR_COUNT0] == registers[CR_COMPARE0])
-        interrupt();
-    }
-    if (registers[CR_COUNT1_CONFIG] == CFG_COUNT_CYCLES) {
-      registers[CR_COUNT1]++;
-      if (registers[CR_COUNT1] == registers[CR_COMPARE1])
-        interrupt();
+    for (uint counter=0; counter<NUM_COUNTERS; counter++) {
+      uint event = counterEvent(counter);
+
+      if (event == EVENT_CYCLES)
+        increment(counter);
+      else if (isCycleEvent(event)) {
+        Instrumentation::Stalls::StallReason reason =
+            (Instrumentation::Stalls::StallReason)(event - EVENT_STALL);
+        if (Instrumentation::Stalls::isStalled(parent().id, reason))
+          increment(counter);
+      }
     }
+
     next_trigger(clock.posedge_event());
   }
 }
 
 bool ControlRegisters::countingCycles() const {
-  return (registers[CR_COUNT0_CONFIG] == CFG_COUNT_CYCLES) ||
-         (registers[CR_COUNT1_CONFIG] == CFG_COUNT_CYCLES);
+  for (uint counter=0; counter<NUM_COUNTERS; counter++)
+    if (isCycleEvent(counterEvent(counter)))
+      return true;
+
+  return false;
 }
 
 bool ControlRegisters::countingInstructions() const {
-  return (registers[CR_COUNT0_CONFIG] == CFG_COUNT_INSTRUCTIONS) ||
-         (registers[CR_COUNT1_CONFIG] == CFG_COUNT_INSTRUCTIONS);
+  for (uint counter=0; counter<NUM_COUNTERS; counter++)
+    if (counterEvent(counter) == EVENT_INSTRUCTIONS)
+      return true;
+
+  return false;
+}
+
+uint ControlRegisters::counterEvent(uint counter) const {
+  int32_t config = registers[CR_COUNT0_CONFIG + counter];
+
+  if (config & CFG_ENABLE)
+    return (config >> 1) & 0x7F;
+  else
+    return NO_EVENT;
+}
+
+bool ControlRegisters::isCycleEvent(uint event) {
+  return (event == EVENT_CYCLES) ||
+         (event >= EVENT_STALL &&
+          event < EVENT_STALL + Instrumentation::Stalls::NUM_STALL_REASONS);
+}
+
+void ControlRegisters::increment(uint counter) {
+  RegisterIndex count = CR_COUNT0 + 2*counter;
+  RegisterIndex compare = CR_COMPARE0 + 2*counter;
+
+  // Unsigned arithmetic so the counter wraps cleanly.
+  uint32_t value = (uint32_t)registers[count] + 1;
+  registers[count] = value;
+
+  if (value == 0) {
+    registers[CR_COUNT_STATUS] |= STATUS_OVERFLOW0 << counter;
+    interrupt();
+  }
+  if (registers[count] == registers[compare]) {
+    registers[CR_COUNT_STATUS] |= STATUS_COMPARE0 << counter;
+    interrupt();
+  }
+}
+
+Core& ControlRegisters::parent() const {
+  return static_cast<Core&>(*(this->get_parent_object()));
 }
@@ -7,15 +7,15 @@
  *
  * 0  mask to control access to control registers in user/privileged modes?
  * 1  CPU location  Bits 3..0 – core ID within a tile, Bits 11..4 – tile ID (12-bit register)
- * 2
- * 3
- * 4  Count0cfg Bit 0 = counter0 enable, Bit 1 – count instructions/cycles
- * 5  Count1cfg Bit 0 = counter1 enable, Bit 1 – count instructions/cycles
- * 6  Count0    32-bit free running counter, increments every CPU clock cycle (if enabled)
+ * 2  Thread start: writing an address starts a new hardware thread there
+ * 3  Thread ID: the index of the hardware thread reading the register
+ * 4  Count0cfg Bit 0 = counter0 enable, Bits 7..1 – event to count (see PerformanceEvent)
+ * 5  Count1cfg Bit 0 = counter1 enable, Bits 7..1 – event to count (see PerformanceEvent)
+ * 6  Count0    32-bit counter, increments on each selected event (if enabled)
  * 7  Compare0  See p.68 Let MIPS run, raise interrupt when compare==count
- * 8  Count1    32-bit free running counter, increments every CPU clock cycle (if enabled)
+ * 8  Count1    32-bit counter, increments on each selected event (if enabled)
  * 9  Compare1  See p.68 Let MIPS run, raise interrupt when compare==count
- * 10 cp10      32-bit register
+ * 10 Count status  Sticky compare/overflow flags (see CountStatus). Write 1s to clear
  * 11 cp11      32-bit register
  * 12 cp12      32-bit register
  * 13 cp13      32-bit register
@@ -31,6 +31,8 @@
 
 #include "../../LokiComponent.h"
 
+class Core;
+
 class ControlRegisters : public LokiComponent {
 
 public:
@@ -38,15 +40,15 @@ public:
   enum ControlRegister {
     CR_ACCESS_MASK      = 0,
     CR_CPU_LOCATION     = 1,
-    CR_UNUSED2          = 2,
-    CR_UNUSED3          = 3,
+    CR_THREAD_START     = 2,
+    CR_THREAD_ID        = 3,
     CR_COUNT0_CONFIG    = 4,
     CR_COUNT1_CONFIG    = 5,
     CR_COUNT0           = 6,
     CR_COMPARE0         = 7,
     CR_COUNT1           = 8,
     CR_COMPARE1         = 9,
-    CR_CP10             = 10,
+    CR_COUNT_STATUS     = 10,
     CR_CP11             = 11,
     CR_CP12             = 12,
     CR_CP13             = 13,
@@ -60,13 +62,37 @@ public:
     ACCESS_PRIVILEGED = 1,
   };
 
-  // Values to be stored in COUNT_CONFIG registers.
+  // Values to be stored in COUNT_CONFIG registers. Other events are selected
+  // with (event << 1) | CFG_ENABLE.
   enum CountConfig {
     CFG_DISABLE = 0,
+    CFG_ENABLE = 1,
     CFG_COUNT_CYCLES = 1,
     CFG_COUNT_INSTRUCTIONS = 3,
   };
 
+  // Events which the counters can count. EVENT_STALL + r counts the cycles in
+  // which the core is stalled for Instrumentation::Stalls::StallReason r.
+  enum PerformanceEvent {
+    EVENT_CYCLES         = 0,
+    EVENT_INSTRUCTIONS   = 1,
+    EVENT_L1_HIT         = 2,   // This core's requests which hit in L1
+    EVENT_L1_MISS        = 3,   // This core's requests which missed in L1
+    EVENT_IPK_CACHE_MISS = 4,
+    EVENT_FLIT_SENT      = 5,
+    EVENT_FLIT_RECEIVED  = 6,   // Both instructions and data
+    EVENT_STALL          = 8
+  };
+
+  // Bits of the COUNT_STATUS register. Each stays set until software writes a
+  // 1 to it.
+  enum CountStatus {
+    STATUS_COMPARE0  = 1,   // Count0 reached Compare0
+    STATUS_COMPARE1  = 2,   // Count1 reached Compare1
+    STATUS_OVERFLOW0 = 4,   // Count0 wrapped around to zero
+    STATUS_OVERFLOW1 = 8,   // Count1 wrapped around to zero
+  };
+
 //============================================================================//
 // Ports
 //============================================================================//
@@ -91,8 +117,8 @@ public:
 
 public:
 
-  // Read from a control register.
-  int32_t read(RegisterIndex reg) const;
+  // Read from a control register on behalf of the given hardware thread.
+  int32_t read(RegisterIndex reg, ThreadIndex thread) const;
 
   // Write to a control register.
   void write(RegisterIndex reg, int32_t value);
@@ -102,6 +128,10 @@ public:
   // TODO: does this include predicated instructions?
   void instructionExecuted();
 
+  // Signal that an event has happened, which may possibly increment a counter.
+  // Events which are counted once per cycle are detected internally.
+  void countEvent(PerformanceEvent event);
+
 private:
 
   // Send an interrupt to the core.
@@ -110,12 +140,23 @@ private:
   // Loop which increments relevant counters every cycle.
   void cycleCounter();
 
-  // Return whether we are currently counting clock cycles.
+  // Return whether we are currently counting clock cycles, or any other event
+  // which is checked once per cycle.
   bool countingCycles() const;
 
   // Return whether we are currently counting instructions.
   bool countingInstructions() const;
 
+  // The event selected by a counter, or NO_EVENT if the counter is disabled.
+  uint counterEvent(uint counter) const;
+  static bool isCycleEvent(uint event);
+
+  // Add one to a counter, and signal if it reaches its compare value or
+  // overflows.
+  void increment(uint counter);
+
+  Core& parent() const;
+
 //============================================================================//
 // Local state
 //============================================================================//
@@ -129,6 +170,9 @@ private:
   // clock cycles are to be counted.
   sc_event startCycleCount;
 
+  static const uint NUM_COUNTERS = 2;
+  static const uint NO_EVENT = -1;
+
 };
 
 #endif /* CONTROLREGISTERS_H_ */
@@ -10,6 +10,7 @@
 #include "../../Datatype/DecodedInst.h"
 #include "../../Utility/Assert.h"
 #include "../../Utility/Instrumentation/Registers.h"
+#include "../../Utility/Instrumentation/Threads.h"
 
 /* Initialise the instructions a Core will execute. */
 void     Core::storeData(const std::vector<Word>& data) {
@@ -45,7 +46,8 @@ int32_t Core::readReg(PortIndex port, RegisterIndex reg, bool indirect) {
   // Slightly complicated by the possibility of indirect register access - the
   // stated register may not actually be the one providing/receiving the data.
   if (reg == write.currentInstruction().destination() &&
-      write.currentInstruction().opcode() != ISA::OP_IWTR) {
+      write.currentInstruction().opcode() != ISA::OP_IWTR &&
+      write.currentInstruction().thread() == activeThread) {
     result = write.currentInstruction().result();
 
     // In a real system, we wouldn't know we were bypassing until too late, so
@@ -71,14 +73,16 @@ int32_t Core::readRegDebug(RegisterIndex reg) const {
     return regs.readInternal(reg);
 }
 
-void     Core::writeReg(RegisterIndex reg, int32_t value, bool indirect) {
-  regs.write(reg, value, indirect);
+void     Core::writeReg(ThreadIndex thread, RegisterIndex reg, int32_t value,
+                        bool indirect) {
+  regs.write(thread, reg, value, indirect);
 }
 
 bool     Core::readPredReg(bool waitForExecution, const DecodedInst& inst) {
   // The wait parameter tells us to wait for the predicate to be written if
   // the instruction in the execute stage will set it.
-  if (waitForExecution && execute.currentInstruction().setsPredicate()) {
+  if (waitForExecution && execute.currentInstruction().setsPredicate() &&
+      execute.currentInstruction().thread() == inst.thread()) {
     Instrumentation::Stalls::stall(id, Instrumentation::Stalls::STALL_FORWARDING, inst);
     // Wait for at least one clock cycle.
     // FIXME: what if the execute stage's instruction finished on a previous cycle?
@@ -89,10 +93,10 @@ bool     Core::readPredReg(bool waitForExecution, const DecodedInst& inst) {
     Instrumentation::Stalls::unstall(id, Instrumentation::Stalls::STALL_FORWARDING, inst);
   }
 
-  return pred.read();
+  return pred.read(inst.thread());
 }
 
-void     Core::writePredReg(bool val)  {pred.write(val);}
+void     Core::writePredReg(ThreadIndex thread, bool val) {pred.write(thread, val);}
 
 const Word Core::readWord(MemoryAddr addr) {
   return Word(parent().readWordInternal(getSystemCallMemory(addr), addr));
@@ -114,8 +118,9 @@ void Core::magicMemoryAccess(const DecodedInst& instruction) {
   magicMemoryConnection.operate(instruction);
 }
 
-void Core::magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload) {
-  parent().magicMemoryAccess(opcode, address, returnChannel, payload);
+void Core::magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload,
+                             MemoryAccessMode mode, ComponentID bank) {
+  parent().magicMemoryAccess(opcode, address, returnChannel, payload, mode, bank);
 }
 
 void Core::deliverDataInternal(const NetworkData& flit) {
@@ -141,6 +146,10 @@ size_t Core::numInputDataBuffers() const {
   return iData.size() - numInstructionChannels;
 }
 
+void Core::countEvent(ControlRegisters::PerformanceEvent event) {
+  cregs.countEvent(event);
+}
+
 uint Core::coreIndex() const {
   return parent().coreIndex(id);
 }
@@ -205,6 +214,108 @@ void     Core::nextIPK() {
     /* continue discarding */;
 }
 
+ThreadIndex Core::currentThread() const {
+  return activeThread;
+}
+
+void     Core::startThread(MemoryAddr address) {
+  for (ThreadIndex thread=0; thread<threads.size(); thread++) {
+    if (threads[thread].state != THREAD_FREE)
+      continue;
+
+    LOKI_LOG(1) << this->name() << " starting thread " << thread << " at "
+        << LOKI_HEX(address) << endl;
+
+    threads[thread].state = THREAD_SUSPENDED;
+    threads[thread].waitingForData = false;
+    fetch.startThread(thread, address);
+    decode.startThread(thread);
+    return;
+  }
+
+  LOKI_WARN << this->name() << " has no free thread to start at "
+      << LOKI_HEX(address) << endl;
+}
+
+bool     Core::suspendThread(ChannelIndex channel, const DecodedInst& inst) {
+  ThreadIndex next = nextReadyThread();
+  if (next == activeThread)
+    return false;
+
+  // The instruction will be fetched and decoded again when the thread resumes,
+  // so it must not have had any effect yet. Also, the thread must be
+  // restartable from a packet in memory.
+  if (inst.isDecodeStageOperation() || inst.persistent() || inst.endOfIPK() ||
+      !decode.canSuspendThread() || !fetch.canSuspendThread())
+    return false;
+
+  threads[activeThread].state = THREAD_SUSPENDED;
+  threads[activeThread].waitingForData = true;
+  threads[activeThread].channel = channel;
+
+  fetch.suspendThread(activeThread, inst);
+  switchThread(next);
+  return true;
+}
+
+bool     Core::switchFromIdleThread() {
+  // Wait for the decode stage to finish with this thread's instructions.
+  if (!decode.isIdle() || pipelineRegs[0].canRead())
+    return false;
+
+  ThreadIndex next = nextReadyThread();
+  if (next == activeThread)
+    return false;
+
+  threads[activeThread].state = THREAD_FREE;
+  switchThread(next);
+  return true;
+}
+
+bool     Core::threadsWaiting() const {
+  for (uint thread=0; thread<threads.size(); thread++)
+    if (threads[thread].state == THREAD_SUSPENDED)
+      return true;
+
+  return false;
+}
+
+ThreadIndex Core::nextReadyThread() const {
+  for (uint i=1; i<threads.size(); i++) {
+    ThreadIndex thread = (activeThread + i) % threads.size();
+    const ThreadContext& context = threads[thread];
+
+    if (context.state != THREAD_SUSPENDED)
+      continue;
+    if (!context.waitingForData || decode.testChannel(context.channel))
+      return thread;
+  }
+
+  return activeThread;
+}
+
+void     Core::switchThread(ThreadIndex next) {
+  ThreadIndex previous = activeThread;
+
+  LOKI_LOG(1) << this->name() << " switching from thread " << previous
+      << " to thread " << next << endl;
+
+  // Anything already fetched for the previous thread will be fetched again
+  // when it resumes. Instructions further down the pipeline complete normally.
+  while (pipelineRegs[0].discard())
+    /* continue discarding */;
+
+  decode.switchThread(previous, next);
+  regs.selectThread(next);
+
+  threads[next].state = THREAD_RUNNING;
+  activeThread = next;
+
+  fetch.resumeThread(next);
+
+  Instrumentation::Threads::switched(id, previous, next);
+}
+
 void     Core::receivedCredit() {
   loki_assert(incomingCredits.canRead());
   deliverCreditInternal(incomingCredits.read());
@@ -240,7 +351,7 @@ void Core::trace(const DecodedInst& inst) const {
       parent().globalCoreIndex(id), inst.location(), inst.name().c_str(),
       inst.destination(), inst.sourceReg1(), inst.sourceReg2(),
       inst.immediate(), inst.immediate2(), inst.channelMapEntry(),
-      pred.read(), regbuf);
+      pred.read(inst.thread()), regbuf);
 }
 
 ComponentID Core::getSystemCallMemory(MemoryAddr address) {
@@ -274,21 +385,33 @@ Core::Core(const sc_module_name& name, const ComponentID& ID,
     oMemory("oMemory"),
     oMulticast("oMulticast"),
     iCredit("iCredit"),
-    fetch("fetch", params.ipkFIFO, params.cache),
-    decode("decode", params.numInputChannels-numInstructionChannels, params.inputFIFO),
-    execute("execute", params.scratchpad),
+    fetch("fetch", params.ipkFIFO, params.cache, params.threads),
+    decode("decode", params.numInputChannels-numInstructionChannels, params.inputFIFO,
+           params.threads),
+    execute("execute", params),
     write("write", params.outputFIFO, numMulticastOutputs, numMemories),
-    regs("regs", params.registerFile),
-    pred("predicate"),
+    regs("regs", params.registerFile, params.threads),
+    pred("predicate", params.threads),
     channelMapTable("channel_map_table", params.channelMapTable, params.numInputChannels),
     cregs("cregs", ID),
     incomingCredits("credits"),  // More of a register than a FIFO
     magicMemoryConnection("magic_memory"),
     id(ID),
+    threads(params.threads),
+    activeThread(0),
     stageReady("stageReady", 3) { // 4 stages => 3 links between stages
 
+  loki_assert_with_message(params.threads >= 1, "Threads = %d", params.threads);
+
   currentlyStalled = false;
 
+  threads[0].state = THREAD_RUNNING;
+  threads[0].waitingForData = false;
+  for (uint thread=1; thread<threads.size(); thread++) {
+    threads[thread].state = THREAD_FREE;
+    threads[thread].waitingForData = false;
+  }
+
   iData[0](fetch.iToFIFO);
   iData[1](fetch.iToCache);
   for (uint i=numInstructionChannels; i<params.numInputChannels; i++)
@@ -98,9 +98,9 @@ public:
   // Read a value from a register, without redirecting to the RCET.
   virtual int32_t  readRegDebug(RegisterIndex reg) const;
 
-  // Read the value of the predicate register.
-  // The optional wait parameter makes it possible to wait until the latest
-  // predicate has been computed, if it will be written this cycle.
+  // Read the value of the predicate register belonging to the instruction's
+  // thread. The optional wait parameter makes it possible to wait until the
+  // latest predicate has been computed, if it will be written this cycle.
   virtual bool     readPredReg(bool wait=false, const DecodedInst& inst = DecodedInst());
 
   const Word readWord(MemoryAddr addr);
@@ -108,7 +108,8 @@ public:
   void writeWord(MemoryAddr addr, Word data);
   void writeByte(MemoryAddr addr, Word data);
   void magicMemoryAccess(const DecodedInst& instruction);
-  void magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload = 0);
+  void magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload = 0,
+                         MemoryAccessMode mode = MEMORY_CACHE, ComponentID bank = ComponentID());
 
   // Receive data over the magic, zero-latency network.
   void deliverDataInternal(const NetworkData& flit);
@@ -117,6 +118,9 @@ public:
   // The number of input buffers, excluding any reserved for instructions.
   size_t numInputDataBuffers() const;
 
+  // An event has happened which the performance counters may be counting.
+  void countEvent(ControlRegisters::PerformanceEvent event);
+
   // The index of this core, with the first core being 0.
   uint coreIndex() const;
   uint coresThisTile() const;
@@ -154,12 +158,12 @@ private:
   // Return the result of the instruction in the execute stage.
   int32_t          getForwardedData() const;
 
-  // Write a value to a register.
-  void             writeReg(RegisterIndex reg, int32_t value,
-                            bool indirect = false);
+  // Write a value to one of the given thread's registers.
+  void             writeReg(ThreadIndex thread, RegisterIndex reg,
+                            int32_t value, bool indirect = false);
 
-  // Write a value to the predicate register.
-  void             writePredReg(bool val);
+  // Write a value to the given thread's predicate register.
+  void             writePredReg(ThreadIndex thread, bool val);
 
   // Update the address of the currently executing instruction packet so we
   // can fetch more packets from relative locations.
@@ -181,6 +185,33 @@ private:
   // waiting for an ".eop" marker.
   void             nextIPK();
 
+  // The hardware thread whose instructions are currently being fetched and
+  // decoded.
+  ThreadIndex      currentThread() const;
+
+  // Start a new thread in a free thread context. The thread will run when
+  // the current thread stalls or runs out of instructions.
+  void             startThread(MemoryAddr address);
+
+  // The current thread is about to stall waiting for data on an input channel.
+  // Switch to another thread if one is ready and the instruction can be
+  // restarted later. Returns whether the switch happened, in which case the
+  // instruction must be abandoned.
+  bool             suspendThread(ChannelIndex channel, const DecodedInst& inst);
+
+  // The current thread has no instructions left to execute. Switch to another
+  // thread if one is ready. Returns whether the switch happened.
+  bool             switchFromIdleThread();
+
+  // Returns whether any thread is waiting for its turn to run.
+  bool             threadsWaiting() const;
+
+  // The next suspended thread which is able to continue, in round-robin
+  // order. Returns the current thread if there are none.
+  ThreadIndex      nextReadyThread() const;
+
+  void             switchThread(ThreadIndex next);
+
   // Method triggered whenever credits arrive on iCredit.
   void             receivedCredit();
 
@@ -248,6 +279,21 @@ private:
   bool currentlyStalled;
   sc_event stallEvent;
 
+  enum ThreadState {
+    THREAD_FREE,        // No work to do
+    THREAD_RUNNING,     // Has control of the pipeline
+    THREAD_SUSPENDED    // Waiting for its turn to run
+  };
+
+  struct ThreadContext {
+    ThreadState  state;
+    bool         waitingForData;  // Must data arrive before the thread resumes?
+    ChannelIndex channel;         // Input buffer the thread is waiting on
+  };
+
+  vector<ThreadContext> threads;
+  ThreadIndex activeThread;
+
 //============================================================================//
 // Signals (wires)
 //============================================================================//
@@ -23,17 +23,19 @@ void         DecodeStage::execute() {
     if (!nextStageBlocked())
       core().idle(true);
 
+    waitingForInput = true;
     wait(newInstructionEvent);
+    waitingForInput = false;
     core().idle(false);
 
-    newInput(currentInst);
+    newInput(*currentInst);
     instructionCompleted();
 
     // If the instruction is to be executed repeatedly, switch into persistent
     // mode and keep issuing the now-decoded instruction.
     // TODO: make sure currentInst is set correctly
-    if (currentInst.persistent())
-      persistentInstruction(currentInst);
+    if (currentInst->persistent())
+      persistentInstruction(*currentInst);
 
     wait(clock.posedge_event());
   }
@@ -102,7 +104,9 @@ void         DecodeStage::newInput(DecodedInst& inst) {
   // end of the current one.
   startingNewPacket = inst.endOfIPK();
 
-  DecodedInst decoded;
+  // Decode into this stage's own slot; the input stays in the pipeline
+  // register.
+  DecodedInst& decoded = localInst;
 
   // Use a while loop to decode the instruction in case multiple outputs
   // are produced.
@@ -155,18 +159,20 @@ void         DecodeStage::newInput(DecodedInst& inst) {
     else wait(clock.posedge_event());
   }
 
-  currentInst = decoded;
+  currentInst = &localInst;
 
   // Start allowing fetches again at the end of a cache packet, OR at the end
   // of a FIFO packet where the core was idle before the packet started.
   // https://svr-rdm34-issue.cl.cam.ac.uk/w/loki/architecture/core/decode/
-  if (startingNewPacket) {
-    if (currentInst.source() == IPKCACHE) {
+  // Skip this if the instruction was abandoned by a thread switch: the state
+  // now belongs to another thread.
+  if (startingNewPacket && currentInst->thread() == core().currentThread()) {
+    if (currentInst->source() == IPKCACHE) {
       fetchInPreviousPacket = fetchSuppressionMode;
       fetchSuppressionMode = false;
       updateFetchAddress = true;
     }
-    else if (currentInst.source() == IPKFIFO && !fetchInPreviousPacket) {
+    else if (currentInst->source() == IPKFIFO && !fetchInPreviousPacket) {
       fetchSuppressionMode = false;
       updateFetchAddress = true;
     }
@@ -365,6 +371,10 @@ bool         DecodeStage::testChannel(ChannelIndex index) const {
   return rcet.testChannelEnd(index);
 }
 
+bool         DecodeStage::suspendThread(ChannelIndex channel, const DecodedInst& inst) {
+  return core().suspendThread(channel, inst);
+}
+
 ChannelIndex DecodeStage::selectChannel(unsigned int bitmask, const DecodedInst& inst) {
   return rcet.selectChannelEnd(bitmask, inst);
 }
@@ -383,7 +393,7 @@ void         DecodeStage::instructionExecuted() {
 
 void         DecodeStage::unstall() {
   decoder.cancelInstruction();
-  currentInst.persistent(false);
+  currentInst->persistent(false);
 
   // We are aborting the current instruction packet, so the next instruction
   // will be the start of a new packet.
@@ -394,17 +404,47 @@ void         DecodeStage::unstall() {
   // stalled forever.
 }
 
+bool         DecodeStage::isIdle() const {
+  return waitingForInput;
+}
+
+bool         DecodeStage::canSuspendThread() const {
+  // Instructions are being forwarded to another core, not executed.
+  return rmtexecuteChannel == Instruction::NO_CHANNEL;
+}
+
+void         DecodeStage::switchThread(ThreadIndex from, ThreadIndex to) {
+  threadState[from].startingNewPacket = startingNewPacket;
+  threadState[from].fetchSuppressionMode = fetchSuppressionMode;
+  threadState[from].fetchInPreviousPacket = fetchInPreviousPacket;
+  threadState[from].updateFetchAddress = updateFetchAddress;
+
+  startingNewPacket = threadState[to].startingNewPacket;
+  fetchSuppressionMode = threadState[to].fetchSuppressionMode;
+  fetchInPreviousPacket = threadState[to].fetchInPreviousPacket;
+  updateFetchAddress = threadState[to].updateFetchAddress;
+}
+
+void         DecodeStage::startThread(ThreadIndex thread) {
+  threadState[thread].startingNewPacket = true;
+  threadState[thread].fetchSuppressionMode = false;
+  threadState[thread].fetchInPreviousPacket = false;
+  threadState[thread].updateFetchAddress = true;
+}
+
 DecodeStage::DecodeStage(sc_module_name name, size_t numChannels,
-                         const fifo_parameters_t& fifoParams) :
+                         const fifo_parameters_t& fifoParams, uint threads) :
     PipelineStage(name),
     oReady("oReady"),
     iData("iData", numChannels),
     iOutputBufferReady("iOutputBufferReady"),
     rcet("rcet", numChannels, fifoParams),
-    decoder("decoder") {
+    decoder("decoder"),
+    threadState(threads) {
 
   startingNewPacket = true;
   waitingToSend = false;
+  waitingForInput = false;
   fetchSuppressionMode = false;
   fetchInPreviousPacket = false;
   updateFetchAddress = true;
@@ -56,7 +56,7 @@ public:
 
   SC_HAS_PROCESS(DecodeStage);
   DecodeStage(sc_module_name name, size_t numChannels,
-              const fifo_parameters_t& fifoParams);
+              const fifo_parameters_t& fifoParams, uint threads);
 
 //============================================================================//
 // Methods
@@ -78,6 +78,21 @@ public:
   // current operation.
   void           unstall();
 
+  // Perform a TESTCH operation.
+  bool           testChannel(ChannelIndex index) const;
+
+  // Returns whether this stage is waiting for its next instruction.
+  bool           isIdle() const;
+
+  // Returns whether the current thread can be suspended at this point.
+  bool           canSuspendThread() const;
+
+  // Save the fetch state of one thread and restore that of another.
+  void           switchThread(ThreadIndex from, ThreadIndex to);
+
+  // Prepare the fetch state of a thread which has not yet run.
+  void           startThread(ThreadIndex thread);
+
 private:
 
   // The main loop controlling this stage. Involves waiting for new input,
@@ -134,8 +149,9 @@ private:
   // memory. ChannelIndex 0 is mapped to the IPK FIFO.
   bool           connectionFromMemory(ChannelIndex channel) const;
 
-  // Perform a TESTCH operation.
-  bool           testChannel(ChannelIndex index) const;
+  // Ask the core to switch to another thread instead of stalling on the
+  // given channel. Returns whether the switch happened.
+  bool           suspendThread(ChannelIndex channel, const DecodedInst& inst);
 
   // Perform a SELCH operation.
   ChannelIndex   selectChannel(unsigned int bitmask, const DecodedInst& inst);
@@ -170,6 +186,7 @@ private:
   bool startingNewPacket;
 
   bool waitingToSend;
+  bool waitingForInput;
 
   // To aid context switching, sometimes enter a mode where fetches become nops.
   // https://svr-rdm34-issue.cl.cam.ac.uk/w/loki/architecture/core/decode/
@@ -177,6 +194,15 @@ private:
   bool fetchInPreviousPacket;
   bool updateFetchAddress;
 
+  // The above packet state for each thread which is not running.
+  struct ThreadState {
+    bool startingNewPacket;
+    bool fetchSuppressionMode;
+    bool fetchInPreviousPacket;
+    bool updateFetchAddress;
+  };
+  vector<ThreadState> threadState;
+
   // Store the channel information used previously in case we need to send a
   // whole packet of information.
   EncodedCMTEntry previousCMTData;
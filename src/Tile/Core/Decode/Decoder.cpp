@@ -245,6 +245,14 @@ void Decoder::waitForOperands(const DecodedInst& dec) {
       wait(1.1, sc_core::SC_NS);
       stall(false, Instrumentation::Stalls::STALL_FORWARDING, dec);
     }
+    if (dec.isDecodeStageOperation() &&
+        parent().core().execute.resultPending(dec.thread(), dec.sourceReg1())) {
+      // A pipelined unit is still computing the value.
+      stall(true, Instrumentation::Stalls::STALL_FORWARDING, dec);
+      while (parent().core().execute.resultPending(dec.thread(), dec.sourceReg1()))
+        wait(1, sc_core::SC_NS);
+      stall(false, Instrumentation::Stalls::STALL_FORWARDING, dec);
+    }
   }
   if (ISA::hasSrcReg2(dec.opcode()) && parent().core().regs.isChannelEnd(dec.sourceReg2()))
     waitUntilArrival(parent().core().regs.toChannelID(dec.sourceReg2()), dec);
@@ -253,8 +261,10 @@ void Decoder::waitForOperands(const DecodedInst& dec) {
 bool Decoder::needsForwarding(RegisterIndex reg) const {
   // Forwarding will be required if there is any instruction between the decode
   // stage and the write back stage which will modify the contents of reg.
+  const DecodedInst& executing = parent().core().execute.currentInstruction();
   return !parent().core().regs.isReserved(reg)
-      && (reg == parent().core().execute.currentInstruction().destination());
+      && (reg == executing.destination())
+      && (executing.thread() == parent().core().currentThread());
 }
 
 void Decoder::setOperand1(DecodedInst& dec) {
@@ -297,6 +307,13 @@ void Decoder::waitUntilArrival(ChannelIndex channel, const DecodedInst& inst) {
 
   // Test the channel to see if the data is already there.
   if (!parent().testChannel(channel)) {
+    // Let another thread use the pipeline instead, if possible. This
+    // instruction will be fetched again when its thread resumes.
+    if (parent().suspendThread(channel, inst)) {
+      instructionCancelled = true;
+      return;
+    }
+
     bool fromMemory = connectionFromMemory(channel);
     Instrumentation::Stalls::StallReason reason =
         fromMemory ? Instrumentation::Stalls::STALL_MEMORY_DATA
@@ -499,7 +516,7 @@ DecodeStage& Decoder::parent() const {
 
 void Decoder::reportStalls(ostream& os) {
   if (!ready()) {
-    DecodedInst& inst = parent().currentInst;
+    DecodedInst& inst = *parent().currentInst;
     os << this->name() << " unable to complete " << LOKI_HEX(inst.location()) << " " << inst << endl;
 
     if (needOperand1 || (inst.hasOperand1() && parent().core().regs.isChannelEnd(inst.sourceReg1())))
@@ -111,6 +111,7 @@ void ReceiveChannelEndTable::reportStalls(ostream& os) {
 
 void ReceiveChannelEndTable::networkDataArrived(ChannelIndex buffer) {
   Instrumentation::Latency::coreReceivedResult(id(), buffers[buffer].lastDataWritten());
+  parent().core().countEvent(ControlRegisters::EVENT_FLIT_RECEIVED);
   newData.notify(sc_core::SC_ZERO_TIME);
 }
 
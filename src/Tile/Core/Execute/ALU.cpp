@@ -6,6 +6,9 @@
  */
 
 #include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "ALU.h"
 #include "../../../Datatype/DecodedInst.h"
@@ -16,6 +19,120 @@
 #include "../../../Exceptions/InvalidOptionException.h"
 #include "ExecuteStage.h"
 
+//============================================================================//
+// Packed operations
+//============================================================================//
+
+// Each operand holds four 8-bit lanes (b) or two 16-bit lanes (h), and each
+// lane is computed independently. The dot products multiply corresponding
+// lanes and return the 32-bit sum of the products.
+
+#ifdef __SSE2__
+
+// Compute all lanes at once on the host's vector unit. Only the low 32 bits
+// of each vector are used.
+static inline __m128i toVector(int32_t val)   {return _mm_cvtsi32_si128(val);}
+static inline int32_t fromVector(__m128i val) {return _mm_cvtsi128_si32(val);}
+
+#define PACKED_OPERATION(NAME, INTRINSIC) \
+  static int32_t NAME(int32_t val1, int32_t val2) {\
+    return fromVector(INTRINSIC(toVector(val1), toVector(val2)));\
+  }
+
+PACKED_OPERATION(aluADDB,   _mm_add_epi8)
+PACKED_OPERATION(aluADDH,   _mm_add_epi16)
+PACKED_OPERATION(aluSUBB,   _mm_sub_epi8)
+PACKED_OPERATION(aluSUBH,   _mm_sub_epi16)
+PACKED_OPERATION(aluADDUSB, _mm_adds_epu8)
+PACKED_OPERATION(aluADDSH,  _mm_adds_epi16)
+PACKED_OPERATION(aluSUBUSB, _mm_subs_epu8)
+PACKED_OPERATION(aluSUBSH,  _mm_subs_epi16)
+PACKED_OPERATION(aluMINUB,  _mm_min_epu8)
+PACKED_OPERATION(aluMAXUB,  _mm_max_epu8)
+PACKED_OPERATION(aluMINH,   _mm_min_epi16)
+PACKED_OPERATION(aluMAXH,   _mm_max_epi16)
+
+static int32_t aluDOTB(int32_t val1, int32_t val2) {
+  // Sign-extend the bytes to 16 bits, then pair up the four products.
+  __m128i bytes1 = toVector(val1);
+  __m128i bytes2 = toVector(val2);
+  __m128i halves1 = _mm_srai_epi16(_mm_unpacklo_epi8(bytes1, bytes1), 8);
+  __m128i halves2 = _mm_srai_epi16(_mm_unpacklo_epi8(bytes2, bytes2), 8);
+  __m128i sums = _mm_madd_epi16(halves1, halves2);
+  return fromVector(_mm_add_epi32(sums, _mm_srli_si128(sums, 4)));
+}
+
+static int32_t aluDOTH(int32_t val1, int32_t val2) {
+  return fromVector(_mm_madd_epi16(toVector(val1), toVector(val2)));
+}
+
+#else
+
+// Apply a function to each lane of the operands, treating lanes as signed or
+// unsigned values.
+template<int bits, bool isSigned>
+static int32_t lanewise(int32_t val1, int32_t val2, int32_t (*fn)(int32_t, int32_t)) {
+  const uint32_t mask = (1 << bits) - 1;
+  uint32_t result = 0;
+
+  for (int shift = 0; shift < 32; shift += bits) {
+    int32_t lane1 = ((uint32_t)val1 >> shift) & mask;
+    int32_t lane2 = ((uint32_t)val2 >> shift) & mask;
+
+    if (isSigned) {
+      lane1 = (lane1 ^ (1 << (bits-1))) - (1 << (bits-1));
+      lane2 = (lane2 ^ (1 << (bits-1))) - (1 << (bits-1));
+    }
+
+    result |= ((uint32_t)fn(lane1, lane2) & mask) << shift;
+  }
+
+  return result;
+}
+
+static int32_t clamp(int32_t val, int32_t low, int32_t high) {
+  return (val < low) ? low : (val > high) ? high : val;
+}
+
+static int32_t laneADD(int32_t a, int32_t b)    {return a + b;}
+static int32_t laneSUB(int32_t a, int32_t b)    {return a - b;}
+static int32_t laneADDUSB(int32_t a, int32_t b) {return clamp(a + b, 0, 255);}
+static int32_t laneSUBUSB(int32_t a, int32_t b) {return clamp(a - b, 0, 255);}
+static int32_t laneADDSH(int32_t a, int32_t b)  {return clamp(a + b, -32768, 32767);}
+static int32_t laneSUBSH(int32_t a, int32_t b)  {return clamp(a - b, -32768, 32767);}
+static int32_t laneMIN(int32_t a, int32_t b)    {return (a < b) ? a : b;}
+static int32_t laneMAX(int32_t a, int32_t b)    {return (a > b) ? a : b;}
+
+static int32_t aluADDB(int32_t val1, int32_t val2)   {return lanewise<8, false>(val1, val2, laneADD);}
+static int32_t aluADDH(int32_t val1, int32_t val2)   {return lanewise<16, false>(val1, val2, laneADD);}
+static int32_t aluSUBB(int32_t val1, int32_t val2)   {return lanewise<8, false>(val1, val2, laneSUB);}
+static int32_t aluSUBH(int32_t val1, int32_t val2)   {return lanewise<16, false>(val1, val2, laneSUB);}
+static int32_t aluADDUSB(int32_t val1, int32_t val2) {return lanewise<8, false>(val1, val2, laneADDUSB);}
+static int32_t aluADDSH(int32_t val1, int32_t val2)  {return lanewise<16, true>(val1, val2, laneADDSH);}
+static int32_t aluSUBUSB(int32_t val1, int32_t val2) {return lanewise<8, false>(val1, val2, laneSUBUSB);}
+static int32_t aluSUBSH(int32_t val1, int32_t val2)  {return lanewise<16, true>(val1, val2, laneSUBSH);}
+static int32_t aluMINUB(int32_t val1, int32_t val2)  {return lanewise<8, false>(val1, val2, laneMIN);}
+static int32_t aluMAXUB(int32_t val1, int32_t val2)  {return lanewise<8, false>(val1, val2, laneMAX);}
+static int32_t aluMINH(int32_t val1, int32_t val2)   {return lanewise<16, true>(val1, val2, laneMIN);}
+static int32_t aluMAXH(int32_t val1, int32_t val2)   {return lanewise<16, true>(val1, val2, laneMAX);}
+
+static int32_t aluDOTB(int32_t val1, int32_t val2) {
+  uint32_t sum = 0;
+  for (int shift = 0; shift < 32; shift += 8)
+    sum += (int8_t)(val1 >> shift) * (int8_t)(val2 >> shift);
+  return sum;
+}
+
+static int32_t aluDOTH(int32_t val1, int32_t val2) {
+  // Unsigned sum: wraps like the vector version if both products are -2^30.
+  uint32_t sum = 0;
+  for (int shift = 0; shift < 32; shift += 16)
+    sum += (uint32_t)((int16_t)(val1 >> shift) * (int16_t)(val2 >> shift));
+  return sum;
+}
+
+#endif
+
 void ALU::execute(DecodedInst& dec) {
 
   loki_assert(dec.isExecuteStageOperation());
@@ -24,7 +141,7 @@ void ALU::execute(DecodedInst& dec) {
   if (cyclesRemaining > 0)
     cyclesRemaining--;
   else
-    cyclesRemaining = getFunctionLatency(dec.function());
+    issue(dec);
 
   if (cyclesRemaining > 0)
     return;
@@ -76,6 +193,21 @@ void ALU::execute(DecodedInst& dec) {
       result = 32 - __builtin_popcount(val1);
       break;
 
+    case ISA::FN_ADDB:    result = aluADDB(val1, val2); break;
+    case ISA::FN_ADDH:    result = aluADDH(val1, val2); break;
+    case ISA::FN_SUBB:    result = aluSUBB(val1, val2); break;
+    case ISA::FN_SUBH:    result = aluSUBH(val1, val2); break;
+    case ISA::FN_ADDUSB:  result = aluADDUSB(val1, val2); break;
+    case ISA::FN_ADDSH:   result = aluADDSH(val1, val2); break;
+    case ISA::FN_SUBUSB:  result = aluSUBUSB(val1, val2); break;
+    case ISA::FN_SUBSH:   result = aluSUBSH(val1, val2); break;
+    case ISA::FN_MINUB:   result = aluMINUB(val1, val2); break;
+    case ISA::FN_MAXUB:   result = aluMAXUB(val1, val2); break;
+    case ISA::FN_MINH:    result = aluMINH(val1, val2); break;
+    case ISA::FN_MAXH:    result = aluMAXH(val1, val2); break;
+    case ISA::FN_DOTB:    result = aluDOTB(val1, val2); break;
+    case ISA::FN_DOTH:    result = aluDOTH(val1, val2); break;
+
     default:
       cerr << dec << endl;
       throw InvalidOptionException("ALU function code", dec.function());
@@ -90,22 +222,96 @@ bool ALU::busy() const {
   return (cyclesRemaining > 0);
 }
 
-cycle_count_t ALU::getFunctionLatency(function_t fn) {
-  cycle_count_t cycles;
+bool ALU::operandsReady(const DecodedInst& operation) const {
+  if (pending.empty())
+    return true;
+
+  ThreadIndex thread = operation.thread();
+
+  // Also wait if the destination is pending, so results are written in order.
+  if (operation.hasSrcReg1() && resultPending(thread, operation.sourceReg1()))
+    return false;
+  if (operation.hasSrcReg2() && resultPending(thread, operation.sourceReg2()))
+    return false;
+  if (operation.hasDestReg() && resultPending(thread, operation.destination()))
+    return false;
+
+  return true;
+}
+
+bool ALU::unitAvailable(const DecodedInst& operation) const {
+  if (!ISA::isALUOperation(operation.opcode()))
+    return true;
+
+  const FunctionalUnit& unit = units[getFunctionUnit(operation.function())];
+  return Instrumentation::currentCycle() >= unit.nextIssue;
+}
+
+bool ALU::resultPending(ThreadIndex thread, RegisterIndex reg) const {
+  cycle_count_t now = Instrumentation::currentCycle();
+
+  for (uint i=0; i<pending.size(); i++)
+    if (pending[i].thread == thread && pending[i].reg == reg && pending[i].ready > now)
+      return true;
+
+  return false;
+}
 
+ALU::Unit ALU::getFunctionUnit(function_t fn) {
   switch (fn) {
     case ISA::FN_MULHW:
     case ISA::FN_MULHWU:
     case ISA::FN_MULLW:
-      cycles = 1;
-      break;
+    case ISA::FN_DOTB:
+    case ISA::FN_DOTH:
+      return UNIT_MULTIPLIER;
+
+    case ISA::FN_SLL:
+    case ISA::FN_SRL:
+    case ISA::FN_SRA:
+    case ISA::FN_CLZ:
+      return UNIT_SHIFTER;
 
     default:
-      cycles = 0;
-      break;
+      return UNIT_ALU;
   }
+}
 
-  return cycles;
+void ALU::issue(const DecodedInst& operation) {
+  FunctionalUnit& unit = units[getFunctionUnit(operation.function())];
+  cycle_count_t now = Instrumentation::currentCycle();
+
+  unit.nextIssue = now + unit.interval;
+
+  // Forget results which have now been computed.
+  uint kept = 0;
+  for (uint i=0; i<pending.size(); i++)
+    if (pending[i].ready > now)
+      pending[kept++] = pending[i];
+  pending.resize(kept);
+
+  // Network data and predicates are used as soon as the instruction leaves
+  // the execute stage, so these operations must always complete here.
+  bool canOverlap = isPipelined(unit) && !operation.sendsOnNetwork()
+                 && !operation.setsPredicate();
+
+  if (canOverlap) {
+    cyclesRemaining = 0;
+
+    if (operation.hasDestReg() && operation.destination() != 0 && unit.latency > 1) {
+      PendingResult result;
+      result.thread = operation.thread();
+      result.reg = operation.destination();
+      result.ready = now + unit.latency;
+      pending.push_back(result);
+    }
+  }
+  else
+    cyclesRemaining = unit.latency - 1;
+}
+
+bool ALU::isPipelined(const FunctionalUnit& unit) const {
+  return unit.interval < unit.latency;
 }
 
 void ALU::setPredicate(bool val) const {
@@ -124,8 +330,23 @@ void ALU::writeReg(RegisterIndex reg, Word data) const {parent().writeReg(reg, d
 void ALU::writeWord(MemoryAddr addr, Word data) const {parent().writeWord(addr, data);}
 void ALU::writeByte(MemoryAddr addr, Word data) const {parent().writeByte(addr, data);}
 
-ALU::ALU(const sc_module_name& name) : LokiComponent(name) {
+ALU::ALU(const sc_module_name& name, const core_parameters_t& params) :
+    LokiComponent(name),
+    units(NUM_UNITS) {
   cyclesRemaining = 0;
+
+  units[UNIT_ALU].latency = params.alu.latency;
+  units[UNIT_ALU].interval = params.alu.interval;
+  units[UNIT_SHIFTER].latency = params.shifter.latency;
+  units[UNIT_SHIFTER].interval = params.shifter.interval;
+  units[UNIT_MULTIPLIER].latency = params.multiplier.latency;
+  units[UNIT_MULTIPLIER].interval = params.multiplier.interval;
+
+  for (uint i=0; i<NUM_UNITS; i++) {
+    loki_assert(units[i].latency >= 1);
+    loki_assert(units[i].interval >= 1);
+    units[i].nextIssue = 0;
+  }
 }
 
 //============================================================================//
@@ -10,9 +10,11 @@
 #ifndef ALU_H_
 #define ALU_H_
 
+#include <vector>
 #include "../../../LokiComponent.h"
 #include "../../../Memory/MemoryTypes.h"
 #include "../../../Utility/ISA.h"
+#include "../../../Utility/Parameters.h"
 
 class DecodedInst;
 class ExecuteStage;
@@ -20,13 +22,43 @@ class Word;
 
 class ALU: public LokiComponent {
 
+//============================================================================//
+// Local types
+//============================================================================//
+
+public:
+
+  // Each function is computed by one of these units, with its own latency
+  // and initiation interval.
+  enum Unit {
+    UNIT_ALU,
+    UNIT_SHIFTER,
+    UNIT_MULTIPLIER,
+    NUM_UNITS
+  };
+
+private:
+
+  struct FunctionalUnit {
+    cycle_count_t latency;
+    cycle_count_t interval;
+    cycle_count_t nextIssue;  // Earliest cycle a new operation can start
+  };
+
+  // A result which a pipelined unit has not finished computing yet.
+  struct PendingResult {
+    ThreadIndex   thread;
+    RegisterIndex reg;
+    cycle_count_t ready;      // First cycle at which the result can be used
+  };
+
 //============================================================================//
 // Constructors and destructors
 //============================================================================//
 
 public:
 
-  ALU(const sc_module_name& name);
+  ALU(const sc_module_name& name, const core_parameters_t& params);
 
 //============================================================================//
 // Methods
@@ -42,13 +74,33 @@ public:
   // can be issued if so.
   bool busy() const;
 
+  // Tell whether all registers used by this instruction are up to date, i.e.
+  // no pipelined unit is still computing a value for any of them.
+  bool operandsReady(const DecodedInst& operation) const;
+
+  // Tell whether the unit needed by this instruction (if any) can accept a
+  // new operation this cycle.
+  bool unitAvailable(const DecodedInst& operation) const;
+
+  // Tell whether a pipelined unit is still computing a value for the given
+  // register.
+  bool resultPending(ThreadIndex thread, RegisterIndex reg) const;
+
   // Carry out a system call. All system calls are currently instant.
   void systemCall(DecodedInst& dec) const;
 
 private:
 
-  // Set cyclesRemaining to the appropriate value for this operation.
-  cycle_count_t getFunctionLatency(function_t fn);
+  // The unit which computes the given function.
+  static Unit getFunctionUnit(function_t fn);
+
+  // Start a new operation on the unit which computes it. Sets cyclesRemaining
+  // if the unit holds the execute stage.
+  void issue(const DecodedInst& operation);
+
+  // A unit is pipelined if it can start a new operation before finishing the
+  // previous one. Other instructions may execute while it works.
+  bool isPipelined(const FunctionalUnit& unit) const;
 
   void setPredicate(bool val) const;
 
@@ -65,7 +117,7 @@ private:
   uint convertTargetFlags(uint tflags) const;
 
 //============================================================================//
-// Methods
+// Local state
 //============================================================================//
 
 private:
@@ -73,6 +125,11 @@ private:
   // Allow multi-cycle operations. Stall the pipeline until they are complete.
   cycle_count_t cyclesRemaining;
 
+  std::vector<FunctionalUnit> units;
+
+  // Results of pipelined operations which are still in progress.
+  std::vector<PendingResult> pending;
+
 };
 
 #endif /* ALU_H_ */
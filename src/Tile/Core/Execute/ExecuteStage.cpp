@@ -10,46 +10,65 @@
 #include "../../../Utility/Assert.h"
 #include "../../../Utility/Instrumentation.h"
 #include "../../../Utility/Instrumentation/Registers.h"
+#include "../../../Utility/Instrumentation/Stalls.h"
 #include "../../../Exceptions/InvalidOptionException.h"
 #include "../../../Exceptions/UnsupportedFeatureException.h"
 #include "../../../Utility/Logging.h"
 #include "../Core.h"
 
-bool ExecuteStage::readPredicate() const {return core().readPredReg();}
+bool ExecuteStage::readPredicate() const {return core().readPredReg(false, *currentInst);}
 int32_t ExecuteStage::readReg(RegisterIndex reg) const {return core().readReg(1, reg);}
 int32_t ExecuteStage::readWord(MemoryAddr addr) const {return core().readWord(addr).toInt();}
 int32_t ExecuteStage::readByte(MemoryAddr addr) const {return core().readByte(addr).toInt();}
 
-void ExecuteStage::writePredicate(bool val) const {core().writePredReg(val);}
-void ExecuteStage::writeReg(RegisterIndex reg, Word data) const {core().writeReg(reg, data.toInt());}
+void ExecuteStage::writePredicate(bool val) const {core().writePredReg(currentInst->thread(), val);}
+void ExecuteStage::writeReg(RegisterIndex reg, Word data) const {core().writeReg(currentInst->thread(), reg, data.toInt());}
 void ExecuteStage::writeWord(MemoryAddr addr, Word data) const {core().writeWord(addr, data);}
 void ExecuteStage::writeByte(MemoryAddr addr, Word data) const {core().writeByte(addr, data);}
 
 void ExecuteStage::execute() {
   // Wait until it is clear to produce network data.
-  if (currentInst.sendsOnNetwork() && !iReady.read()) {
+  if (currentInst->sendsOnNetwork() && !iReady.read()) {
     blocked = true;
     next_trigger(iReady.posedge_event());
     return;
   }
-  else if (currentInst.sendsOnNetwork() && oData.valid()) {
+  else if (currentInst->sendsOnNetwork() && oData.valid()) {
     blocked = true;
     next_trigger(oData.ack_event());
     return;
   }
   blocked = false;
 
+  // Wait for any operands which a pipelined unit is still computing, and for
+  // the unit this instruction needs to accept a new operation.
+  if (!currentInst->hasResult() && !alu.busy()) {
+    bool ready = alu.operandsReady(*currentInst);
+
+    if (!ready && !waitingForOperands)
+      Instrumentation::Stalls::stall(id(), Instrumentation::Stalls::STALL_FORWARDING, *currentInst);
+    else if (ready && waitingForOperands)
+      Instrumentation::Stalls::unstall(id(), Instrumentation::Stalls::STALL_FORWARDING, *currentInst);
+    waitingForOperands = !ready;
+
+    if (!ready || !alu.unitAvailable(*currentInst)) {
+      blocked = true;
+      next_trigger(clock.posedge_event());
+      return;
+    }
+  }
+
   // If there is already a result, don't do anything
-  if (currentInst.hasResult() && !continuingStore) {
+  if (currentInst->hasResult() && !continuingStore) {
     previousInstExecuted = true;
-    if (currentInst.setsPredicate())
-      updatePredicate(currentInst);
+    if (currentInst->setsPredicate())
+      updatePredicate(*currentInst);
     sendOutput();
   }
   else
-    newInput(currentInst);
+    newInput(*currentInst);
 
-  forwardedResult = currentInst.result();
+  forwardedResult = currentInst->result();
 
   if (!blocked && !continuingStore) {
     instructionCompleted();
@@ -123,7 +142,7 @@ void ExecuteStage::newInput(DecodedInst& operation) {
         break;
 
       case ISA::OP_CREGRDI:
-        operation.result(core().cregs.read(operation.immediate()));
+        operation.result(core().cregs.read(operation.immediate(), operation.thread()));
         break;
 
       case ISA::OP_CREGWRI:
@@ -209,13 +228,13 @@ void ExecuteStage::newInput(DecodedInst& operation) {
   else {
     // If the instruction will not be executed, invalidate it so we don't
     // try to forward data from it.
-    currentInst.preventForwarding();
+    currentInst->preventForwarding();
 
     // HACK: if we removed a credit in DecodeStage::waitOnCredits, and now
     // discover that we aren't going to execute the instruction, add the credit
     // back again.
-    if (currentInst.sendsOnNetwork())
-      core().channelMapTable.addCredit(currentInst.channelMapEntry(), 1);
+    if (currentInst->sendsOnNetwork())
+      core().channelMapTable.addCredit(currentInst->channelMapEntry(), 1);
   }
 
   // Only instrument operations which executed in this pipeline stage.
@@ -236,30 +255,30 @@ void ExecuteStage::newInput(DecodedInst& operation) {
 }
 
 void ExecuteStage::sendOutput() {
-  if (currentInst.sendsOnNetwork()) {
+  if (currentInst->sendsOnNetwork()) {
     // Memory operations may be sent to different memory banks depending on the
     // address accessed.
     // In practice, this would be performed by a separate, small functional
     // unit in parallel with the main ALU, so that there is time left to request
     // a path to memory.
-    if (core().isMemory(currentInst.networkDestination().component))
-      adjustNetworkAddress(currentInst);
+    if (core().isMemory(currentInst->networkDestination().component))
+      adjustNetworkAddress(*currentInst);
 
-    if (MAGIC_MEMORY && !currentInst.forRemoteExecution() &&
-        core().isMemory(currentInst.networkDestination().component)) {
-      core().magicMemoryAccess(currentInst);
+    if (MAGIC_MEMORY && !currentInst->forRemoteExecution() &&
+        core().isMemory(currentInst->networkDestination().component)) {
+      core().magicMemoryAccess(*currentInst);
     }
     else {
       // Send the data to the output buffer - it will arrive immediately so that
       // network resources can be requested the cycle before they are used.
       loki_assert(!oData.valid());
-      oData.write(currentInst.toNetworkData(id().tile));
+      oData.write(currentInst->toNetworkData(id().tile));
     }
   }
 
   // Send the data to the register file - it will arrive at the beginning
   // of the next clock cycle.
-  outputInstruction(currentInst);
+  outputInstruction(*currentInst);
 }
 
 void ExecuteStage::setChannelMap(DecodedInst& inst) {
@@ -301,6 +320,7 @@ void ExecuteStage::adjustNetworkAddress(DecodedInst& inst) const {
     case PAYLOAD_EOP:
     case UPDATE_DIRECTORY_ENTRY:
     case UPDATE_DIRECTORY_MASK:
+    case DMA_COMMAND:
       addressFlit = false;
       break;
     default:
@@ -391,25 +411,30 @@ const sc_event& ExecuteStage::executedEvent() const {
   return instructionCompletedEvent;
 }
 
+bool ExecuteStage::resultPending(ThreadIndex thread, RegisterIndex reg) const {
+  return alu.resultPending(thread, reg);
+}
+
 void ExecuteStage::reportStalls(ostream& os) {
   if (blocked) {
-    os << this->name() << " blocked while executing " << currentInst << endl;
+    os << this->name() << " blocked while executing " << *currentInst << endl;
   }
 }
 
 ExecuteStage::ExecuteStage(const sc_module_name& name,
-                           const scratchpad_parameters_t& spadParams) :
+                           const core_parameters_t& params) :
     PipelineStage(name),
     oReady("oReady"),
     oData("oData"),
     iReady("iReady"),
-    alu("alu"),
-    scratchpad("scratchpad", spadParams) {
+    alu("alu", params),
+    scratchpad("scratchpad", params.scratchpad) {
 
   forwardedResult = 0;
   previousInstExecuted = false;
   blocked = false;
   continuingStore = false;
+  waitingForOperands = false;
 
   SC_METHOD(execute);
   sensitive << newInstructionEvent;
@@ -43,7 +43,7 @@ public:
 
   SC_HAS_PROCESS(ExecuteStage);
   ExecuteStage(const sc_module_name& name,
-               const scratchpad_parameters_t& spadParams);
+               const core_parameters_t& params);
 
 //============================================================================//
 // Methods
@@ -54,6 +54,10 @@ public:
   // An event which is triggered whenever execution of an instruction completes.
   const sc_event& executedEvent() const;
 
+  // Tell whether a pipelined functional unit is still computing a value for
+  // the given register.
+  bool resultPending(ThreadIndex thread, RegisterIndex reg) const;
+
 private:
 
   // The main loop controlling this stage. Involves waiting for new input,
@@ -140,6 +144,9 @@ private:
   // second half.
   bool continuingStore;
 
+  // The current instruction is waiting for a result from a pipelined unit.
+  bool waitingForOperands;
+
 };
 
 #endif /* EXECUTESTAGE_H_ */
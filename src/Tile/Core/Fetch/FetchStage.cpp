@@ -41,7 +41,14 @@ void FetchStage::readLoop() {
       }
       else if (cachePendingPacket.active() && cachePendingPacket.execute)
         switchToPacket(cachePendingPacket);
-      // Nothing to do - wait until a new instruction packet arrives.
+      // Nothing to do for this thread - give the pipeline to another.
+      else if (fetchBuffer.empty() && writeState == WS_READY &&
+               core().switchFromIdleThread())
+        next_trigger(newPacketAvailable);
+      // Nothing to do - wait until a new instruction packet arrives. If other
+      // threads are waiting, keep checking whether one can run.
+      else if (core().threadsWaiting())
+        next_trigger(newPacketAvailable | clock.posedge_event());
       else
         next_trigger(newPacketAvailable);
 
@@ -64,26 +71,27 @@ void FetchStage::readLoop() {
         // The Instruction becomes a DecodedInst here to simplify various interfaces
         // throughout the pipeline. The decoding actually happens in the decode stage.
         Instruction instruction = currentInstructionSource().read();
-        currentInst = DecodedInst(instruction);
-        currentInst.location(getCurrentAddress());
-        currentInst.source(currentPacket.location.component);
+        *currentInst = DecodedInst(instruction);
+        currentInst->location(getCurrentAddress());
+        currentInst->source(currentPacket.location.component);
+        currentInst->thread(core().currentThread());
 
-        Instrumentation::Stalls::unstall(id(), Instrumentation::Stalls::STALL_INSTRUCTIONS, currentInst);
+        Instrumentation::Stalls::unstall(id(), Instrumentation::Stalls::STALL_INSTRUCTIONS, *currentInst);
 
         static const string names[] = {"FIFO", "cache", "unknown"};
         LOKI_LOG(2) << this->name() << " selected instruction from "
-             << names[currentPacket.location.component] << ": " << currentInst << endl;
+             << names[currentPacket.location.component] << ": " << *currentInst << endl;
 
         // Make sure we didn't read a junk instruction. "nor r0, r0, r0 -> 0" seems
         // pretty unlikely to ever come up in a real program.
-        loki_assert_with_message(instruction.toInt() != 0, "Probable junk instruction from address 0x%x", currentInst.location());
+        loki_assert_with_message(instruction.toInt() != 0, "Probable junk instruction from address 0x%x", currentInst->location());
 
-        if (currentInst.endOfIPK()) {
+        if (currentInst->endOfIPK()) {
           // Check for the special case of single-instruction persistent packets.
           // These do not need to be read repeatedly, so remove the persistent flag.
           if (currentPacket.persistent &&
               currentPacket.memAddr == currentInstructionSource().memoryAddress()) {
-            currentInst.persistent(true);
+            currentInst->persistent(true);
             currentPacket.persistent = false;
           }
 
@@ -93,7 +101,7 @@ void FetchStage::readLoop() {
         else
           next_trigger(clock.negedge_event());
 
-        outputInstruction(currentInst);
+        outputInstruction(*currentInst);
         instructionCompleted();
       }
       break;
@@ -110,10 +118,20 @@ void FetchStage::switchToPacket(PacketInfo& packet) {
     else
       next_trigger(cache.writeEvent());
   }
+  // A resumed thread starts part-way through a packet. Wait for the whole
+  // packet so the instructions skipped over are there.
+  else if (packet.offset != 0 && !packet.inCache) {
+    Instrumentation::Stalls::stall(id(), Instrumentation::Stalls::STALL_INSTRUCTIONS, DecodedInst());
+    next_trigger(packetArrivedEvent);
+  }
   else {
     currentPacket = packet;
 
     currentInstructionSource().startNewPacket(currentPacket.location.index);
+    if (currentPacket.offset != 0) {
+      currentInstructionSource().jump(currentPacket.offset);
+      currentPacket.offset = 0;
+    }
 
     static const string names[] = {"FIFO", "cache", "unknown"};
     LOKI_LOG(2) << this->name() << " switched to pending packet: " << names[currentPacket.location.component] <<
@@ -127,17 +145,19 @@ void FetchStage::switchToPacket(PacketInfo& packet) {
 
 // Continually ensure that any fetched instruction packets are available. Read
 // requests from the fetchBuffer, and update the pending packet with the
-// location to access locally. Only ever have a single fetch in progress.
+// location to access locally. Only ever have a single fetch in progress:
+// packets must arrive one at a time so they are stored contiguously. If there
+// are no requests waiting, prefetch the packets predicted to be needed next.
 void FetchStage::writeLoop() {
 
   switch (writeState) {
     case WS_READY: {
       // Wait for a fetch request to arrive.
-      if (fetchBuffer.empty()) {
+      if (fetchBuffer.empty() && !prefetcher.hasCandidate()) {
         next_trigger(fetchBuffer.writeEvent());
       }
       // Wait for there to be space in the cache to fetch a new packet.
-      else if (!roomToFetch()) {
+      else if (!roomToFetch(nextFetchAddress())) {
         next_trigger(cache.readEvent() | fifo.readEvent());
       }
       // The pending packet is where we store all the information about the
@@ -156,7 +176,12 @@ void FetchStage::writeLoop() {
     }
 
     case WS_FETCH: {
-      activeFetch = fetchBuffer.read();
+      // Requests from the program have priority over prefetches.
+      if (!fetchBuffer.empty())
+        activeFetch = fetchBuffer.read();
+      else
+        activeFetch = FetchInfo(prefetcher.nextCandidate(), ISA::OP_FILL,
+                                prefetchChannel, true);
 
       if (activeFetch.networkInfo.returnChannel == 0)
         fifoPendingPacket.reset();
@@ -239,7 +264,17 @@ void FetchStage::writeLoop() {
 void FetchStage::sendRequest(const FetchInfo& fetch) {
   if (MAGIC_MEMORY) {
     ChannelID returnAddress(id(), fetch.networkInfo.returnChannel);
-    core().magicMemoryAccess(IPK_READ, fetch.address, returnAddress);
+
+    if (fetch.networkInfo.isMemory) {
+      // Use the same bank and access mode as a real request would, so
+      // packets held in scratchpad-mode banks can be fetched.
+      uint increment = core().channelMapTable[0].computeAddressIncrement(fetch.address);
+      ComponentID bank(id().tile, fetch.networkInfo.bank + increment + core().coresThisTile());
+      MemoryAccessMode mode = fetch.networkInfo.scratchpadL1 ? MEMORY_SCRATCHPAD : MEMORY_CACHE;
+      core().magicMemoryAccess(IPK_READ, fetch.address, returnAddress, 0, mode, bank);
+    }
+    else
+      core().magicMemoryAccess(IPK_READ, fetch.address, returnAddress);
   }
   else {
     NetworkData flit;
@@ -261,7 +296,7 @@ void FetchStage::sendRequest(const FetchInfo& fetch) {
 
   // If we don't already have a packet to execute, we are now stalled
   // waiting for this one to arrive.
-  if (!currentPacket.active())
+  if (!currentPacket.active() && !fetch.prefetch)
     Instrumentation::Stalls::stall(id(), Instrumentation::Stalls::STALL_INSTRUCTIONS, DecodedInst());
 }
 
@@ -327,7 +362,7 @@ void FetchStage::checkTags(MemoryAddr addr,
 
     // If the previous instruction was also the end of the packet, abort the
     // next iteration.
-    if (currentInst.endOfIPK())
+    if (currentInst->endOfIPK())
       readState = RS_READY;
   }
 }
@@ -360,9 +395,12 @@ bool FetchStage::inCache(const FetchInfo& fetch) {
                       operation != ISA::OP_FILLR;
   packet.persistent = operation == ISA::OP_FETCHPST ||
                       operation == ISA::OP_FETCHPSTR;
+  packet.offset     = fetch.offset;
+  packet.networkInfo = fetch.networkInfo;
   newPacketAvailable.notify();
 
   bool found = packet.inCache;
+  bool execute = packet.execute;
 
   LOKI_LOG(2) << (found ? "" : "not ") << "cached" << endl;
 
@@ -371,9 +409,31 @@ bool FetchStage::inCache(const FetchInfo& fetch) {
   if (packet.inCache && !packet.execute)
     packet.reset();
 
-  Instrumentation::IPKCache::tagCheck(core(), packet.inCache, fetch.address, previousFetch);
-
-  previousFetch = fetch.address;
+  if (fetch.prefetch) {
+    if (!found) {
+      prefetcher.prefetchSent(fetch.address, Instrumentation::currentCycle());
+      Instrumentation::IPKCache::prefetch(core());
+    }
+  }
+  else {
+    cycle_count_t hidden;
+    bool prefetched = prefetcher.prefetchUsed(fetch.address, fetch.requested, hidden);
+    if (prefetched && found)
+      Instrumentation::IPKCache::prefetchUsed(core(), hidden);
+
+    Instrumentation::IPKCache::tagCheck(core(), found, fetch.address, previousFetch);
+    if (!found)
+      core().countEvent(ControlRegisters::EVENT_IPK_CACHE_MISS);
+
+    previousFetch = fetch.address;
+
+    // Predict which packets will follow this one. Prefetches use the same
+    // memory channel.
+    if (execute && fetch.networkInfo.isMemory && location.component == IPKCACHE) {
+      prefetchChannel = fetch.networkInfo;
+      prefetcher.fetched(fetch.address);
+    }
+  }
 
   return found;
 }
@@ -396,11 +456,18 @@ const InstLocation FetchStage::lookup(const MemoryAddr addr) {
   return location;
 }
 
-bool FetchStage::roomToFetch() const {
+bool FetchStage::roomToFetch(MemoryAddr address) const {
   // We only allow a new fetch request to be sent when there is room in the
   // cache, and there is no packet currently in transfer (we don't want to
   // interleave the instructions).
-  return cache.roomToFetch() && (!currentPacket.active() || currentPacket.inCache);
+  return cache.roomToFetch(address) && (!currentPacket.active() || currentPacket.inCache);
+}
+
+MemoryAddr FetchStage::nextFetchAddress() const {
+  if (!fetchBuffer.empty())
+    return fetchBuffer.peek().address;
+  else
+    return prefetcher.peekCandidate();
 }
 
 /* Perform any status updates required when we receive a position to jump to. */
@@ -415,6 +482,70 @@ void FetchStage::jump(const JumpOffset offset) {
   newPacketAvailable.notify();
 }
 
+bool FetchStage::canSuspendThread() const {
+  // The current packet must be complete, and fetched from memory.
+  if (currentPacket.location.component != IPKCACHE || !currentPacket.inCache ||
+      !currentPacket.networkInfo.isMemory)
+    return false;
+
+  // The fetch stage has already moved on to the next packet.
+  if (currentInst->endOfIPK())
+    return false;
+
+  // Packets queued up after this one must also be refetchable. Interrupts
+  // from the FIFO cannot be restarted.
+  if (fifoPendingPacket.active())
+    return false;
+  if (cachePendingPacket.active() && !cachePendingPacket.networkInfo.isMemory)
+    return false;
+
+  // There must be no fetches in progress.
+  return fetchBuffer.empty() && writeState == WS_READY;
+}
+
+void FetchStage::suspendThread(ThreadIndex thread, const DecodedInst& inst) {
+  vector<FetchInfo>& resume = suspended[thread];
+  resume.clear();
+
+  // Restart the current packet at the given instruction.
+  opcode_t operation = currentPacket.persistent ? ISA::OP_FETCHPST : ISA::OP_FETCH;
+  FetchInfo current(currentPacket.memAddr, operation, currentPacket.networkInfo);
+  current.offset = (inst.location() - currentPacket.memAddr) / BYTES_PER_WORD;
+  resume.push_back(current);
+
+  // Then continue with the packet which was due to follow it.
+  if (cachePendingPacket.active()) {
+    operation = cachePendingPacket.persistent ? ISA::OP_FETCHPST : ISA::OP_FETCH;
+    resume.push_back(FetchInfo(cachePendingPacket.memAddr, operation,
+                               cachePendingPacket.networkInfo));
+    cache.markAsRead(cachePendingPacket.location.index);
+  }
+
+  LOKI_LOG(2) << this->name() << " suspended thread " << thread << " at "
+      << LOKI_HEX(inst.location()) << endl;
+
+  // Other threads may overwrite these packets. They will be fetched again if
+  // necessary.
+  cache.markAsRead(currentPacket.location.index);
+  cache.cancelPacket();
+
+  currentPacket.reset();
+  cachePendingPacket.reset();
+  readState = RS_READY;
+}
+
+void FetchStage::resumeThread(ThreadIndex thread) {
+  for (uint i=0; i<suspended[thread].size(); i++)
+    fetchBuffer.write(suspended[thread][i]);
+  suspended[thread].clear();
+}
+
+void FetchStage::startThread(ThreadIndex thread, MemoryAddr address) {
+  suspended[thread].clear();
+  suspended[thread].push_back(FetchInfo(address, ISA::OP_FETCH,
+                                        core().channelMapTable[0].memoryView()));
+}
+
 void FetchStage::nextIPK() {
   currentPacket.persistent = false;
 
@@ -436,6 +567,10 @@ void FetchStage::fifoInstructionArrived(Instruction inst) {
   }
 }
 
+void FetchStage::cacheInstructionEvicted(MemoryAddr address) {
+  prefetcher.evicted(address);
+}
+
 void FetchStage::cacheInstructionArrived(Instruction inst) {
   // Increment the fetch address so we can fetch a new line when necessary.
   if (activeFetch.networkInfo.returnChannel == 1) {
@@ -444,6 +579,16 @@ void FetchStage::cacheInstructionArrived(Instruction inst) {
   }
 }
 
+MemoryAddr FetchStage::arrivingPacketTag(InstructionSource source) const {
+  const PacketInfo& pendingPacket = (source == IPKFIFO)
+                                  ? fifoPendingPacket
+                                  : cachePendingPacket;
+
+  // If the packet doesn't already have a tag, it is probably arriving from
+  // another core.
+  return (pendingPacket.memAddr == DEFAULT_TAG) ? 0 : pendingPacket.memAddr;
+}
+
 MemoryAddr FetchStage::newPacketArriving(const InstLocation& location) {
   PacketInfo& pendingPacket = (location.component == IPKFIFO)
                             ? fifoPendingPacket
@@ -451,11 +596,7 @@ MemoryAddr FetchStage::newPacketArriving(const InstLocation& location) {
 
   // We now know where to read the packet from.
   pendingPacket.location = location;
-
-  // If the packet didn't already have a tag, it is probably arriving from
-  // another core.
-  if (pendingPacket.memAddr == DEFAULT_TAG)
-    pendingPacket.memAddr = 0;
+  pendingPacket.memAddr = arrivingPacketTag(location.component);
 
   newPacketAvailable.notify(sc_core::SC_ZERO_TIME);
   return pendingPacket.memAddr;
@@ -473,10 +614,26 @@ void FetchStage::packetFinishedArriving(InstructionSource source) {
 
   packet->inCache = true;
 
+  // If this is the packet we fetched, we now know where the next packet in
+  // memory begins.
+  if (source == IPKCACHE && writeState == WS_RECEIVE &&
+      activeFetch.networkInfo.returnChannel != 0) {
+    prefetcher.packetArrived(packet->memAddr, activeFetch.address,
+                             Instrumentation::currentCycle());
+
+    // Prefetched instructions may never be read: don't hold on to them.
+    if (activeFetch.prefetch)
+      cache.markAsRead(packet->location.index);
+  }
+
   // If we are not due to execute this packet, clear its entry in the queue so
-  // we can fetch another.
-  if (!packet->execute)
+  // we can fetch another. Its instructions may never be read, so don't hold
+  // on to them.
+  if (!packet->execute) {
+    if (source == IPKCACHE)
+      cache.markAsRead(packet->location.index);
     packet->reset();
+  }
 
   packetArrivedEvent.notify(sc_core::SC_ZERO_TIME);
 }
@@ -536,9 +693,19 @@ void FetchStage::reportStalls(ostream& os) {
     os << fifo.name() << " is full." << endl;
 }
 
+// A suspended thread may need to restart both its current packet and the
+// packet queued up after it, so multithreaded cores need room for two fetches.
+size_t FetchStage::fetchQueueSize(const cache_parameters_t& params, uint threads) {
+  if (threads > 1 && params.fetchQueueSize < 2)
+    return 2;
+  else
+    return params.fetchQueueSize;
+}
+
 FetchStage::FetchStage(sc_module_name name,
                        const fifo_parameters_t& fifoParams,
-                       const cache_parameters_t& cacheParams) :
+                       const cache_parameters_t& cacheParams,
+                       uint threads) :
     FirstPipelineStage(name),
     iToCache("iCacheInstruction"),
     iToFIFO("iFIFOInstruction"),
@@ -546,7 +713,10 @@ FetchStage::FetchStage(sc_module_name name,
     iOutputBufferReady("iOutputBufferReady"),
     cache("IPKcache", cacheParams),
     fifo("IPKfifo", fifoParams),
-    fetchBuffer("fetchBuffer", 1) {
+    prefetcher(cacheParams.prefetchEntries),
+    fetchBuffer("fetchBuffer", fetchQueueSize(cacheParams, threads)),
+    suspended(threads),
+    prefetchChannel(0) {
 
   // Connect ports.
   fifo.clock(clock);
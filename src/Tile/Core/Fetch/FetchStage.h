@@ -16,8 +16,10 @@
 #include "../../../Network/NetworkTypes.h"
 #include "InstructionPacketCache.h"
 #include "InstructionPacketFIFO.h"
+#include "IPKPrefetcher.h"
 #include "../PipelineStage.h"
 #include "../../../Utility/BlockingInterface.h"
+#include "../../../Utility/Instrumentation.h"
 
 class FetchStage : public FirstPipelineStage, public BlockingInterface {
 
@@ -25,12 +27,16 @@ private:
 
   // A collection of information about an instruction packet and how it should
   // be executed.
-  typedef struct {
+  struct PacketInfo {
     MemoryAddr   memAddr;   // Memory address of this packet (mainly for debug)
     InstLocation location;  // Location of first instruction of the packet
     bool         persistent;// Persistent packets repeat until NXIPK is received
     bool         execute;   // Should these instructions be executed immediately?
     bool         inCache;   // Is the packet completely in the cache?
+    JumpOffset   offset;    // Instructions to skip when starting the packet
+    ChannelMapEntry::MemoryChannel networkInfo; // How the packet was fetched
+
+    PacketInfo() : networkInfo(0) {reset();}
 
     void reset() {
       memAddr = DEFAULT_TAG;
@@ -38,6 +44,8 @@ private:
       inCache = false;
       execute = true;
       persistent = false;
+      offset = 0;
+      networkInfo = 0;
     }
     bool arriving() const {
       return active() && !inCache && (location.index != NOT_IN_CACHE);
@@ -45,7 +53,7 @@ private:
     bool active() const {
       return memAddr != DEFAULT_TAG;
     }
-  } PacketInfo;
+  };
 
   // Information about each instruction packet we want to bring into the cache.
   struct FetchInfo {
@@ -53,13 +61,20 @@ private:
     opcode_t   operation;   // Fetch operation used to request the packet.
     ChannelMapEntry::MemoryChannel networkInfo; // All required network information.
     bool       complete;    // All instructions in the packet have arrived.
+    bool       prefetch;    // Requested by the prefetcher, not the program.
+    JumpOffset offset;      // Instructions to skip when starting the packet.
+    cycle_count_t requested; // Cycle at which the request was made.
 
-    FetchInfo() : address(0), operation((opcode_t)0), networkInfo(0), complete(false) {}
-    FetchInfo(MemoryAddr addr, opcode_t op, ChannelMapEntry::MemoryChannel networkInfo) :
+    FetchInfo() : address(0), operation((opcode_t)0), networkInfo(0), complete(false), prefetch(false), offset(0), requested(0) {}
+    FetchInfo(MemoryAddr addr, opcode_t op, ChannelMapEntry::MemoryChannel networkInfo,
+              bool prefetch=false) :
       address(addr),
       operation(op),
       networkInfo(networkInfo),
-      complete(false) {}
+      complete(false),
+      prefetch(prefetch),
+      offset(0),
+      requested(Instrumentation::currentCycle()) {}
   };
 
 //============================================================================//
@@ -94,7 +109,8 @@ public:
   SC_HAS_PROCESS(FetchStage);
   FetchStage(sc_module_name name,
              const fifo_parameters_t& fifoParams,
-             const cache_parameters_t& cacheParams);
+             const cache_parameters_t& cacheParams,
+             uint threads);
 
 //============================================================================//
 // Methods
@@ -124,6 +140,21 @@ public:
   // Jump to a different instruction in the Instruction Packet Cache.
   void          jump(const JumpOffset offset);
 
+  // Returns whether the current thread could be restarted from the given
+  // instruction. This requires the thread's packets to be in the cache, and
+  // to have been fetched from memory, so they can be fetched again.
+  bool          canSuspendThread() const;
+
+  // Stop reading instructions for the current thread, and remember how to
+  // restart it from the given instruction.
+  void          suspendThread(ThreadIndex thread, const DecodedInst& inst);
+
+  // Start fetching instructions for a suspended thread.
+  void          resumeThread(ThreadIndex thread);
+
+  // Prepare a new thread to start at the given address.
+  void          startThread(ThreadIndex thread, MemoryAddr address);
+
 protected:
 
   virtual void  reportStalls(ostream& os);
@@ -148,9 +179,13 @@ private:
   // operation too.
   bool          inCache(const FetchInfo& info);
 
-  // Tells whether there is room in the cache to fetch another instruction
-  // packet, assuming the packet is of maximum size.
-  bool          roomToFetch() const;
+  // Tells whether there is room in the cache to fetch the instruction packet
+  // at the given address, assuming the packet is of maximum size.
+  bool          roomToFetch(MemoryAddr address) const;
+
+  // The address of the packet which will be fetched next: a request from the
+  // program if there is one, or a prefetch otherwise.
+  MemoryAddr    nextFetchAddress() const;
 
   // Recompute whether this pipeline stage is stalled.
   virtual void  updateReady();
@@ -164,6 +199,13 @@ private:
   void          fifoInstructionArrived(Instruction inst);
   void          cacheInstructionArrived(Instruction inst);
 
+  // The instruction from the given address has been overwritten in the cache.
+  void          cacheInstructionEvicted(MemoryAddr address);
+
+  // The memory address (tag) of the next packet to arrive at the given
+  // instruction store.
+  MemoryAddr    arrivingPacketTag(InstructionSource source) const;
+
   // Signal to this pipeline stage that a new packet has started to arrive, and
   // tell where it is. Returns the memory address (tag) of the packet.
   MemoryAddr    newPacketArriving(const InstLocation& location);
@@ -184,6 +226,10 @@ private:
   // Override PipelineStage's implementation.
   virtual void  prepareNextInstruction();
 
+  // The number of fetch requests which can be queued. Raised to two if there
+  // are multiple threads.
+  static size_t fetchQueueSize(const cache_parameters_t& params, uint threads);
+
 //============================================================================//
 // Components
 //============================================================================//
@@ -192,6 +238,7 @@ private:
 
   InstructionPacketCache    cache;
   InstructionPacketFIFO     fifo;
+  IPKPrefetcher             prefetcher;
 
   friend class InstructionPacketCache;
   friend class InstructionPacketFIFO;
@@ -236,6 +283,13 @@ private:
   FIFO<FetchInfo> fetchBuffer;
   FetchInfo activeFetch;
 
+  // The fetches needed to restart each suspended thread.
+  vector<vector<FetchInfo>> suspended;
+
+  // Network information used for prefetches. Copied from the most recent
+  // fetch which brought a packet into the cache from memory.
+  ChannelMapEntry::MemoryChannel prefetchChannel;
+
   // Event which is triggered whenever a packet finishes arriving.
   sc_event packetArrivedEvent;
 
@@ -0,0 +1,123 @@
+/*
+ * IPKPrefetcher.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "IPKPrefetcher.h"
+
+#include <algorithm>
+#include <assert.h>
+
+IPKPrefetcher::IPKPrefetcher(uint entries) :
+    table(entries),
+    previousFetch(NO_ADDRESS),
+    predicted(false) {
+  assert((entries & (entries - 1)) == 0);
+
+  for (uint i=0; i<entries; i++)
+    table[i].packet = table[i].fallThrough = table[i].target = NO_ADDRESS;
+}
+
+void IPKPrefetcher::fetched(MemoryAddr address) {
+  if (table.empty())
+    return;
+
+  // Remember where execution went after the previous packet, unless it was
+  // just the fall-through, which is already known.
+  if (previousFetch != NO_ADDRESS) {
+    Entry& previous = entry(previousFetch);
+    if (previous.packet == previousFetch && address != previous.fallThrough)
+      previous.target = address;
+  }
+
+  previousFetch = address;
+  candidates.clear();
+
+  Entry& current = entry(address);
+  predicted = (current.packet == address);
+  if (!predicted)
+    return;
+
+  if (current.fallThrough != NO_ADDRESS && current.fallThrough != address)
+    candidates.push_back(current.fallThrough);
+  if (current.target != NO_ADDRESS && current.target != address)
+    candidates.push_back(current.target);
+}
+
+void IPKPrefetcher::packetArrived(MemoryAddr address, MemoryAddr fallThrough,
+                                  cycle_count_t cycle) {
+  if (table.empty())
+    return;
+
+  Entry& packet = entry(address);
+
+  if (packet.packet != address) {
+    packet.packet = address;
+    packet.target = NO_ADDRESS;
+  }
+
+  packet.fallThrough = fallThrough;
+
+  std::map<MemoryAddr, Prefetch>::iterator it = unused.find(address);
+  if (it != unused.end() && it->second.arrived == NO_CYCLE)
+    it->second.arrived = cycle;
+
+  // The most recent fetch had nothing to go on, but now the packet's
+  // fall-through is known. Start bringing it in while this packet executes.
+  if (address == previousFetch && !predicted) {
+    predicted = true;
+    if (fallThrough != address && candidates.empty())
+      candidates.push_back(fallThrough);
+  }
+}
+
+bool IPKPrefetcher::hasCandidate() const {
+  return !candidates.empty();
+}
+
+MemoryAddr IPKPrefetcher::peekCandidate() const {
+  assert(hasCandidate());
+  return candidates.front();
+}
+
+MemoryAddr IPKPrefetcher::nextCandidate() {
+  assert(hasCandidate());
+
+  MemoryAddr address = candidates.front();
+  candidates.pop_front();
+  return address;
+}
+
+void IPKPrefetcher::prefetchSent(MemoryAddr address, cycle_count_t cycle) {
+  Prefetch prefetch;
+  prefetch.sent = cycle;
+  prefetch.arrived = NO_CYCLE;
+  unused[address] = prefetch;
+}
+
+bool IPKPrefetcher::prefetchUsed(MemoryAddr address, cycle_count_t requested,
+                                 cycle_count_t& hidden) {
+  std::map<MemoryAddr, Prefetch>::iterator it = unused.find(address);
+  if (it == unused.end())
+    return false;
+
+  // Without the prefetch, the packet would have started arriving when it was
+  // requested. The latency hidden is the part of the prefetch's round trip
+  // which happened before that point.
+  const Prefetch& prefetch = it->second;
+  cycle_count_t ready = std::min(prefetch.arrived, requested);
+  hidden = (ready > prefetch.sent) ? (ready - prefetch.sent) : 0;
+
+  unused.erase(it);
+  return true;
+}
+
+void IPKPrefetcher::evicted(MemoryAddr address) {
+  unused.erase(address);
+}
+
+IPKPrefetcher::Entry& IPKPrefetcher::entry(MemoryAddr address) {
+  return table[(address / BYTES_PER_WORD) & (table.size() - 1)];
+}
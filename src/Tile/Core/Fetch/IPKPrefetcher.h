@@ -0,0 +1,129 @@
+/*
+ * IPKPrefetcher.h
+ *
+ * Predicts which instruction packets a core will fetch next, so they can be
+ * brought into the IPK cache before they are requested.
+ *
+ * Each entry of a small direct-mapped table describes one packet:
+ *   fall-through  the address immediately after the packet's final
+ *                 instruction, learned when the packet arrives
+ *   target        the packet fetched after this one last time, if that was
+ *                 not the fall-through
+ *
+ * Whenever the core fetches a packet, both successors of that packet become
+ * prefetch candidates. Candidates from older fetches are discarded. A packet
+ * fetched for the first time has no prediction, so its fall-through becomes
+ * a candidate as soon as the packet arrives, while it is still executing.
+ *
+ * Also tracks which prefetched packets have not yet been used, and when they
+ * were requested and arrived, so the accuracy of prefetching and the fetch
+ * latency it hides can be measured.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_TILE_CORE_FETCH_IPKPREFETCHER_H_
+#define SRC_TILE_CORE_FETCH_IPKPREFETCHER_H_
+
+#include <deque>
+#include <map>
+#include <vector>
+#include "../../../Memory/MemoryTypes.h"
+#include "../../../Types.h"
+
+class IPKPrefetcher {
+
+//============================================================================//
+// Local types
+//============================================================================//
+
+private:
+
+  struct Entry {
+    MemoryAddr packet;
+    MemoryAddr fallThrough;
+    MemoryAddr target;
+  };
+
+  struct Prefetch {
+    cycle_count_t sent;
+    cycle_count_t arrived;
+  };
+
+//============================================================================//
+// Constructors and destructors
+//============================================================================//
+
+public:
+
+  // `entries` must be a power of two. 0 disables prefetching.
+  IPKPrefetcher(uint entries);
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  // The core requested the packet at `address`. Train on the transition from
+  // the previous request and queue up the predicted successors.
+  void fetched(MemoryAddr address);
+
+  // The packet at `address` has finished arriving at `cycle`, and the
+  // instruction after its final instruction is at `fallThrough`.
+  void packetArrived(MemoryAddr address, MemoryAddr fallThrough,
+                     cycle_count_t cycle);
+
+  // Returns whether there is a prefetch candidate waiting.
+  bool hasCandidate() const;
+
+  // Return the next prefetch candidate without removing it.
+  MemoryAddr peekCandidate() const;
+
+  // Remove and return the next prefetch candidate.
+  MemoryAddr nextCandidate();
+
+  // A prefetch request for `address` has been sent at `cycle`.
+  void prefetchSent(MemoryAddr address, cycle_count_t cycle);
+
+  // The core requested the packet at `address` at cycle `requested`. Returns
+  // whether the packet was prefetched and had not been used before. If so,
+  // `hidden` is set to the number of cycles of fetch latency which were
+  // overlapped with earlier work: an upper bound on the stall cycles saved.
+  bool prefetchUsed(MemoryAddr address, cycle_count_t requested,
+                    cycle_count_t& hidden);
+
+  // The instruction at `address` has been overwritten. Any unused prefetch of
+  // a packet starting there is no longer useful.
+  void evicted(MemoryAddr address);
+
+private:
+
+  Entry& entry(MemoryAddr address);
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+private:
+
+  static const MemoryAddr NO_ADDRESS = 0xFFFFFFFF;
+  static const cycle_count_t NO_CYCLE = (cycle_count_t)-1;
+
+  std::vector<Entry> table;
+
+  // The most recently requested packet, and whether its successors could be
+  // predicted when it was requested.
+  MemoryAddr previousFetch;
+  bool       predicted;
+
+  // Packets to prefetch, in order of preference.
+  std::deque<MemoryAddr> candidates;
+
+  // Packets which have been prefetched but not yet requested.
+  std::map<MemoryAddr, Prefetch> unused;
+
+};
+
+#endif /* SRC_TILE_CORE_FETCH_IPKPREFETCHER_H_ */
@@ -9,7 +9,9 @@
 
 #include "../../../Memory/IPKCacheDirectMapped.h"
 #include "../../../Memory/IPKCacheFullyAssociative.h"
+#include "../../../Memory/IPKCacheSetAssociative.h"
 #include "FetchStage.h"
+#include "../Core.h"
 #include "../../../Utility/Assert.h"
 #include "../../../Utility/Instrumentation.h"
 #include "../../../Utility/Instrumentation/IPKCache.h"
@@ -24,6 +26,7 @@ void InstructionPacketCache::storeCode(const std::vector<Instruction>& instructi
   CacheIndex writePos = cache->storeCode(instructions);
 
   for (CacheIndex j=0, i=writePos; j<instructions.size(); j++) {
+    parent().cacheInstructionEvicted(addresses[i]);
     addresses[i] = 0;
     i++;
     if (i >= cache->size())
@@ -64,6 +67,9 @@ void InstructionPacketCache::write(const Instruction inst) {
   LOKI_LOG(3) << this->name() << " received Instruction: " << inst << endl;
   parent().cacheInstructionArrived(inst);
 
+  if (finishedPacketWrite)
+    cache->startPacket(parent().arrivingPacketTag(IPKCACHE));
+
   CacheIndex writePos = cache->write(inst);
   cacheWrite.notify(sc_core::SC_ZERO_TIME);
 
@@ -80,6 +86,7 @@ void InstructionPacketCache::write(const Instruction inst) {
   else
     lastWriteAddr += BYTES_PER_WORD;
 
+  parent().cacheInstructionEvicted(addresses[writePos]);
   addresses[writePos] = lastWriteAddr;
 
   finishedPacketWrite = inst.endOfPacket();
@@ -123,6 +130,10 @@ void InstructionPacketCache::cancelPacket() {
   cache->cancelPacket();
 }
 
+void InstructionPacketCache::markAsRead(CacheIndex position) {
+  cache->markAsRead(position);
+}
+
 const sc_event& InstructionPacketCache::readEvent() const {
   return cacheRead;
 }
@@ -138,6 +149,7 @@ void InstructionPacketCache::write(const Flit<Word>& data) {
   // can be at most one writer at a time.
 
   Instrumentation::Latency::coreReceivedResult(parent().id(), data);
+  parent().core().countEvent(ControlRegisters::EVENT_FLIT_RECEIVED);
 
   // Strip off the network address and store the instruction.
   Instruction inst = static_cast<Instruction>(data.payload());
@@ -175,6 +187,10 @@ bool InstructionPacketCache::roomToFetch() const {
   return cache->canFetch();
 }
 
+bool InstructionPacketCache::roomToFetch(MemoryAddr tag) const {
+  return cache->canFetch(tag);
+}
+
 FetchStage& InstructionPacketCache::parent() const {
   return static_cast<FetchStage&>(*(this->get_parent_object()));
 }
@@ -185,7 +201,10 @@ InstructionPacketCache::InstructionPacketCache(sc_module_name name,
     LokiComponent(name),
     addresses(params.size, DEFAULT_TAG) {
 
-  cache = new IPKCacheFullyAssociative(string(this->name()), params.size, params.numTags, params.maxIPKSize);
+  if (params.ways == 0)
+    cache = new IPKCacheFullyAssociative(string(this->name()), params.size, params.numTags, params.maxIPKSize);
+  else
+    cache = new IPKCacheSetAssociative(string(this->name()), params.size, params.ways, params.maxIPKSize, params.replacement);
 //  cache = new IPKCacheDirectMapped(string(this->name()), params.size, params.maxIPKSize);
 
   lastReadAddr = 0;
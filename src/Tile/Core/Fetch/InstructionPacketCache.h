@@ -73,6 +73,10 @@ public:
   // for an ".eop" marker.
   virtual void cancelPacket();
 
+  // The packet starting at the given position was prefetched, and may never
+  // be read.
+  void markAsRead(CacheIndex position);
+
   // Tells whether the cache considers itself empty. This may be because there
   // are no instructions in the cache, or because all instructions have been
   // executed.
@@ -84,6 +88,10 @@ public:
   // size.
   bool roomToFetch() const;
 
+  // Tells whether there is room to fetch the packet with the given tag. Some
+  // caches can only store a packet in a subset of their locations.
+  bool roomToFetch(MemoryAddr tag) const;
+
   // Jump to a new instruction specified by the offset.
   virtual void jump(JumpOffset offset);
 
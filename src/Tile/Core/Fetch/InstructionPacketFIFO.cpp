@@ -10,6 +10,7 @@
 #include "../../../Datatype/Instruction.h"
 #include "../../../Utility/Instrumentation/Latency.h"
 #include "FetchStage.h"
+#include "../Core.h"
 
 const Instruction InstructionPacketFIFO::read() {
   Instruction inst = fifo.read().payload();
@@ -125,6 +126,7 @@ FetchStage& InstructionPacketFIFO::parent() const {
 
 void InstructionPacketFIFO::write(const Flit<Word>& data) {
   Instrumentation::Latency::coreReceivedResult(parent().id(), data);
+  parent().core().countEvent(ControlRegisters::EVENT_FLIT_RECEIVED);
 
   // Strip off the network address and store the instruction.
   Instruction inst = static_cast<Instruction>(data.payload());
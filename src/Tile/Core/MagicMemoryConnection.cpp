@@ -17,6 +17,8 @@ MagicMemoryConnection::MagicMemoryConnection(sc_module_name name) :
   currentOpcode = PAYLOAD_EOP;
   currentAddress = -1;
   payloadsRemaining = 0;
+  currentMode = MEMORY_CACHE;
+  skipL1 = false;
 
 }
 
@@ -64,12 +66,13 @@ unsigned int numPayloadFlits(MemoryOpcode op) {
     case EXCHANGE:
     case UPDATE_DIRECTORY_ENTRY:
     case UPDATE_DIRECTORY_MASK:
+    case DMA_COMMAND:
       return 1;
       break;
 
     case STORE_LINE:
     case PUSH_LINE:
-      return 8;
+      return CACHE_LINE_WORDS;
       break;
 
     default:
@@ -85,8 +88,12 @@ void MagicMemoryConnection::operate(const DecodedInst& instruction) {
   ChannelMapEntry& channelMapEntry = parent().channelMapTable[instruction.channelMapEntry()];
   ChannelID returnChannel(parent().id.tile.x, parent().id.tile.y, channelMapEntry.getChannel(), channelMapEntry.getReturnChannel());
 
-  loki_assert_with_message(!channelMapEntry.memoryView().scratchpadL1,
-      "Magic memory only supports one address space.", 0);
+  // Scratchpad accesses need to know which bank they are accessing. The
+  // destination has already been adjusted to account for memory groups.
+  ChannelMapEntry::MemoryChannel channel = channelMapEntry.memoryView();
+  currentMode = channel.scratchpadL1 ? MEMORY_SCRATCHPAD : MEMORY_CACHE;
+  currentBank = instruction.networkDestination().component;
+  skipL1 = channel.l1Skip;
 
   MemoryOpcode memoryOp = instruction.memoryOp();
 
@@ -101,8 +108,7 @@ void MagicMemoryConnection::operate(const DecodedInst& instruction) {
       loki_assert(currentOpcode != PAYLOAD);
       loki_assert(payloadsRemaining > 0);
 
-      parent().magicMemoryAccess(currentOpcode, currentAddress,
-          returnChannel, instruction.result());
+      access(currentOpcode, currentAddress, returnChannel, instruction.result());
 
       // All multi-payload operations act on words (rather than bytes, etc.).
       currentAddress += 4;
@@ -121,7 +127,7 @@ void MagicMemoryConnection::operate(const DecodedInst& instruction) {
       else if (payloadsRemaining > 1)
         loki_assert_with_message(false, "Unhandled complex operation: %s", memoryOpName(memoryOp).c_str());
       else if (payloadsRemaining == 0)
-        parent().magicMemoryAccess(currentOpcode, currentAddress, returnChannel);
+        access(currentOpcode, currentAddress, returnChannel);
     }
 
     // Operation finished.
@@ -139,11 +145,10 @@ void MagicMemoryConnection::operate(const DecodedInst& instruction) {
       int payloads = numPayloadFlits(memoryOp);
       switch (payloads) {
         case 0:
-          parent().magicMemoryAccess(memoryOp, instruction.result(), returnChannel);
+          access(memoryOp, instruction.result(), returnChannel);
           break;
         case 1:
-          parent().magicMemoryAccess(memoryOp, instruction.result(),
-              returnChannel, instruction.operand1());
+          access(memoryOp, instruction.result(), returnChannel, instruction.operand1());
           break;
         default:
           loki_assert_with_message(false, "Magic memory doesn't support multi-payload operations.", 0);
@@ -153,6 +158,19 @@ void MagicMemoryConnection::operate(const DecodedInst& instruction) {
   }
 }
 
+void MagicMemoryConnection::access(MemoryOpcode opcode, MemoryAddr address,
+                                   ChannelID returnChannel, Word payload) {
+  // Directory updates which skip the L1 are aimed at a directory further
+  // along the memory hierarchy. Magic memory has no such directories.
+  if ((opcode == UPDATE_DIRECTORY_ENTRY || opcode == UPDATE_DIRECTORY_MASK) && skipL1) {
+    LOKI_LOG(2) << this->name() << ": " << memoryOpName(opcode) << " has no effect" << endl;
+    return;
+  }
+
+  parent().magicMemoryAccess(opcode, address, returnChannel, payload,
+                             currentMode, currentBank);
+}
+
 Core& MagicMemoryConnection::parent() const {
   return static_cast<Core&>(*(this->get_parent_object()));
 }
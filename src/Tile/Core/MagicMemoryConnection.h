@@ -4,6 +4,9 @@
  * Component responsible for managing communication with a zero-latency memory.
  * The component should go unused unless MAGIC_MEMORY is set to 1.
  *
+ * Operations with multiple payload flits (STORE_LINE, PUSH_LINE) are split
+ * into a sequence of single-word stores.
+ *
  *  Created on: 30 Jan 2017
  *      Author: db434
  */
@@ -27,6 +30,11 @@ public:
   void operate(const DecodedInst& instruction);
 
 private:
+  // Pass a single operation on to the magic memory, using the address space
+  // of the current instruction.
+  void access(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel,
+              Word payload = 0);
+
   Core& parent() const;
 
   // Many operations are self-contained, but some (especially sendconfigs)
@@ -35,6 +43,11 @@ private:
   MemoryAddr   currentAddress;
   unsigned int payloadsRemaining;
 
+  // Address space and target of the current instruction.
+  MemoryAccessMode currentMode;
+  ComponentID      currentBank;
+  bool             skipL1;
+
 };
 
 #endif /* SRC_TILE_CORE_MAGICMEMORYCONNECTION_H_ */
@@ -0,0 +1,149 @@
+/*
+ * MemoryTraceInjector.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include <algorithm>
+#include "MemoryTraceInjector.h"
+#include "../../Network/NetworkTypes.h"
+#include "../../Utility/Assert.h"
+#include "../../Utility/Instrumentation.h"
+
+static const cycle_count_t NOT_COMPLETE = (cycle_count_t)-1;
+
+uint MemoryTraceInjector::unfinishedInjectors = 0;
+
+bool MemoryTraceInjector::finished() const {
+  if (cursor < trace.size())
+    return false;
+
+  for (uint i=0; i<outstanding.size(); i++)
+    if (!outstanding[i].empty())
+      return false;
+
+  return true;
+}
+
+void MemoryTraceInjector::mainLoop() {
+  collectResponses();
+  issueRequest();
+  updateIdle();
+}
+
+void MemoryTraceInjector::collectResponses() {
+  cycle_count_t now = Instrumentation::currentCycle();
+
+  for (uint channel=0; channel<responses.size(); channel++) {
+    while (responses[channel].canRead()) {
+      NetworkResponse flit = responses[channel].read();
+
+      if (!flit.getMetadata().endOfPacket)
+        continue;
+
+      if (outstanding[channel].empty()) {
+        LOKI_WARN << this->name() << " received unexpected response " << flit << endl;
+        continue;
+      }
+
+      completionTime[outstanding[channel].front()] = now;
+      outstanding[channel].pop_front();
+    }
+  }
+}
+
+void MemoryTraceInjector::issueRequest() {
+  if (cursor >= trace.size() || !requests.canWrite())
+    return;
+
+  const MemoryTrace::Record& record = trace[cursor];
+  cycle_count_t now = Instrumentation::currentCycle();
+
+  if (record.isHead()) {
+    count_t request = completionTime.size();
+    cycle_count_t ready = lastIssue;
+
+    if (record.dependence > 0) {
+      loki_assert(record.dependence < request);
+      cycle_count_t completed = completionTime[request - record.dependence];
+      if (completed == NOT_COMPLETE)
+        return;
+      ready = std::max(ready, completed);
+    }
+
+    if (now < ready + record.delay)
+      return;
+
+    completionTime.push_back(NOT_COMPLETE);
+    lastIssue = now;
+
+    MemoryMetadata metadata = record.memoryMetadata();
+    if (MemoryTrace::expectsResponse(metadata.opcode)) {
+      loki_assert(metadata.returnChannel < outstanding.size());
+      outstanding[metadata.returnChannel].push_back(request);
+    }
+  }
+
+  // The channel of a core-to-memory flit is the position of the core.
+  ChannelID destination(id.tile, record.bank, id.position);
+  requests.write(NetworkRequest(Word(record.payload), destination, record.metadata));
+  cursor++;
+}
+
+void MemoryTraceInjector::updateIdle() {
+  bool done = finished();
+
+  if (done && active) {
+    active = false;
+    Instrumentation::idle(id, true);
+
+    loki_assert(unfinishedInjectors > 0);
+    unfinishedInjectors--;
+
+    LOKI_LOG(1) << this->name() << " finished replaying " << trace.size() << " flits" << endl;
+
+    if (unfinishedInjectors == 0)
+      Instrumentation::endExecution();
+  }
+  else if (!done && !active) {
+    active = true;
+    Instrumentation::idle(id, false);
+  }
+}
+
+MemoryTraceInjector::MemoryTraceInjector(const sc_module_name& name,
+                                         const ComponentID& ID,
+                                         const core_parameters_t& params) :
+    LokiComponent(name),
+    clock("clock"),
+    iData("iData", params.numInputChannels),
+    oMemory("oMemory"),
+    id(ID),
+    trace(MemoryTrace::replayStream(ID)),
+    cursor(0),
+    completionTime(1, 0),
+    lastIssue(0),
+    outstanding(params.numInputChannels),
+    active(false),
+    requests("requests", params.outputFIFO) {
+
+  for (uint i=0; i<params.numInputChannels; i++) {
+    std::stringstream bufName;
+    bufName << "responses_" << i;
+    responses.push_back(new NetworkFIFO<Word>(bufName.str().c_str(), params.inputFIFO));
+
+    responses[i].clock(clock);
+    iData[i](responses[i]);
+  }
+
+  requests.clock(clock);
+  oMemory(requests);
+
+  if (!trace.empty())
+    unfinishedInjectors++;
+
+  SC_METHOD(mainLoop);
+  sensitive << clock.pos();
+  dont_initialize();
+}
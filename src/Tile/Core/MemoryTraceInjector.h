@@ -0,0 +1,114 @@
+/*
+ * MemoryTraceInjector.h
+ *
+ * Stands in for a core when a memory trace is being replayed. All of the
+ * core's requests to its local memory banks are taken from the trace, and all
+ * responses are consumed and discarded.
+ *
+ * A request is not sent until the request it depended on in the original
+ * execution has received its response, and then only after the same delay as
+ * was originally observed. Payload flits follow their head flit as soon as the
+ * network allows.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_TILE_CORE_MEMORYTRACEINJECTOR_H_
+#define SRC_TILE_CORE_MEMORYTRACEINJECTOR_H_
+
+#include <deque>
+#include "../../LokiComponent.h"
+#include "../../Network/FIFOs/NetworkFIFO.h"
+#include "../../Utility/LokiVector.h"
+#include "../../Utility/Trace/MemoryTrace.h"
+
+class MemoryTraceInjector : public LokiComponent {
+
+//============================================================================//
+// Ports
+//============================================================================//
+
+public:
+
+  typedef sc_port<network_sink_ifc<Word>> InPort;
+  typedef sc_port<network_source_ifc<Word>> OutPort;
+
+  ClockInput            clock;
+
+  // Responses from memory. One port for each of the core's input channels.
+  LokiVector<InPort>    iData;
+
+  // Requests to memory.
+  OutPort               oMemory;
+
+//============================================================================//
+// Constructors and destructors
+//============================================================================//
+
+public:
+
+  SC_HAS_PROCESS(MemoryTraceInjector);
+  MemoryTraceInjector(const sc_module_name& name, const ComponentID& ID,
+                      const core_parameters_t& params);
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  // Returns whether every request has been sent and every response received.
+  bool finished() const;
+
+private:
+
+  void mainLoop();
+
+  // Consume all responses which have arrived, and note which requests are now
+  // complete.
+  void collectResponses();
+
+  // Send the next flit from the trace, if it is ready.
+  void issueRequest();
+
+  // Update idleness information, and end simulation if all injectors have
+  // finished.
+  void updateIdle();
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+public:
+
+  const ComponentID id;
+
+private:
+
+  // All flits to be sent, and the position of the next one.
+  const vector<MemoryTrace::Record>& trace;
+  size_t cursor;
+
+  // The time each request received its response, indexed by request number.
+  // Request numbers start at 1, to match the trace's dependence encoding.
+  vector<cycle_count_t> completionTime;
+
+  // Time at which the latest head flit was sent.
+  cycle_count_t lastIssue;
+
+  // Requests waiting for a response, one queue per input channel.
+  vector<std::deque<count_t>> outstanding;
+
+  bool active;
+
+  LokiVector<NetworkFIFO<Word>> responses;
+  NetworkFIFO<Word>             requests;
+
+  // The number of injectors with work still to do. Simulation ends when this
+  // reaches zero.
+  static uint unfinishedInjectors;
+
+};
+
+#endif /* SRC_TILE_CORE_MEMORYTRACEINJECTOR_H_ */
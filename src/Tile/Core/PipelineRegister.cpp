@@ -16,10 +16,13 @@ bool PipelineRegister::canWrite() const {
 
 void PipelineRegister::write(const DecodedInst& inst) {
   if (ENERGY_TRACE)
-    Instrumentation::PipelineReg::activity(data, inst, position);
+    Instrumentation::PipelineReg::activity(data[written], inst, position);
 
   loki_assert(!valid);
-  data = inst;
+
+  // Don't overwrite the instruction the consumer is working on.
+  written = (reading + 1) % NUM_SLOTS;
+  data[written] = inst;
   valid = true;
   writeEvent.notify();
 }
@@ -28,11 +31,12 @@ bool PipelineRegister::canRead() const {
   return valid;
 }
 
-const DecodedInst& PipelineRegister::read() {
+DecodedInst& PipelineRegister::read() {
   loki_assert(valid);
   readEvent.notify();
   valid = false;
-  return data;
+  reading = written;
+  return data[reading];
 }
 
 const sc_event& PipelineRegister::canReadEvent() const {
@@ -59,6 +63,7 @@ PipelineRegister::PipelineRegister(const sc_module_name& name,
   LokiComponent(name),
   position(pos) {
 
+  written = reading = NUM_SLOTS - 1;
   valid = false;
 
 }
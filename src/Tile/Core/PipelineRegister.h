@@ -1,14 +1,18 @@
 /*
  * PipelineRegister.h
  *
- * Two registers to go between each pair of pipeline stages, removing the need
- * for instantaneous propagation of pipeline flow control signals.
+ * Register to go between each pair of pipeline stages.
  *
  * Loosely based (much higher-level) on the implementation in
  * http://www.cl.cam.ac.uk/~rdm34/Memos/localstall.pdf
  *
- * NOTE: I have switched back to a one-register implementation, as having two
- * registers makes forwarding awkward.
+ * Flow control is that of a single register: at most one instruction is
+ * waiting to be read, and write() is only allowed once it has been read.
+ * Storage is double-buffered: the register holds two instruction slots.
+ * read() hands the consumer a reference to the slot it read, and the next
+ * write goes to the other slot, so a stage can work on its instruction in
+ * place without taking a copy. The slot remains valid until the instruction
+ * after next is written.
  *
  *  Created on: 15 Mar 2012
  *      Author: db434
@@ -26,8 +30,9 @@ public:
   // Can an instruction be read?
   virtual bool canRead() const = 0;
 
-  // Read an instruction.
-  virtual const DecodedInst& read() = 0;
+  // Read an instruction. The instruction may be modified in place, and
+  // remains valid until the instruction after next has been written.
+  virtual DecodedInst& read() = 0;
 
   // Event triggered when `canRead()` becomes `true`.
   virtual const sc_event& canReadEvent() const = 0;
@@ -97,7 +102,7 @@ public:
 
   // Is this register ready to provide the next instruction?
   virtual bool canRead() const;
-  virtual const DecodedInst& read();
+  virtual DecodedInst& read();
 
   virtual const sc_event& canReadEvent() const;
   virtual const sc_event& canWriteEvent() const;
@@ -112,7 +117,12 @@ public:
 
 private:
 
-  DecodedInst data;
+  static const uint NUM_SLOTS = 2;
+
+  // Instruction storage. `written` is the slot holding the newest
+  // instruction, and `reading` is the slot owned by the consumer.
+  DecodedInst data[NUM_SLOTS];
+  uint written, reading;
   bool valid;
 
   sc_event readEvent, writeEvent;
@@ -15,6 +15,7 @@ PipelineStageBase::PipelineStageBase(const sc_module_name& name) :
     LokiComponent(name),
     clock("clock") {
 
+  currentInst = &localInst;
   currentInstValid = false;
 
   SC_METHOD(prepareNextInstruction);
@@ -24,7 +25,7 @@ PipelineStageBase::PipelineStageBase(const sc_module_name& name) :
 }
 
 const DecodedInst& PipelineStageBase::currentInstruction() const {
-  return currentInst;
+  return *currentInst;
 }
 
 const ComponentID& PipelineStageBase::id() const {
@@ -51,11 +52,11 @@ void PipelineStageBase::prepareNextInstruction() {
   else if (!clock.posedge() || isStalled())
     next_trigger(clock.posedge_event());
   else {
-    currentInst = receiveInstruction();
+    currentInst = &receiveInstruction();
     currentInstValid = true;
     newInstructionEvent.notify(sc_core::SC_ZERO_TIME);
 
-    LOKI_LOG(2) << this->name() << " received Instruction: " << currentInst << endl;
+    LOKI_LOG(2) << this->name() << " received Instruction: " << *currentInst << endl;
 
     // Wait until the pipeline stage finishes this instruction before retrieving
     // the next one.
@@ -90,9 +91,9 @@ const sc_event& FirstPipelineStage::nextStageUnblockedEvent() const {
   return nextStage->canWriteEvent();
 }
 
-DecodedInst FirstPipelineStage::receiveInstruction() {
+DecodedInst& FirstPipelineStage::receiveInstruction() {
   loki_assert(false);
-  return DecodedInst();
+  return localInst;
 }
 
 bool FirstPipelineStage::discardNextInst() {
@@ -129,7 +130,7 @@ const sc_event& LastPipelineStage::nextStageUnblockedEvent() const {
   return *(new sc_event());
 }
 
-DecodedInst LastPipelineStage::receiveInstruction() {
+DecodedInst& LastPipelineStage::receiveInstruction() {
   return previousStage->read();
 }
 
@@ -166,7 +167,7 @@ const sc_event& PipelineStage::nextStageUnblockedEvent() const {
   return nextStage->canWriteEvent();
 }
 
-DecodedInst PipelineStage::receiveInstruction() {
+DecodedInst& PipelineStage::receiveInstruction() {
   return previousStage->read();
 }
 
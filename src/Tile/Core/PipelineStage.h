@@ -73,8 +73,9 @@ protected:
   // possible to produce multiple outputs from a single instruction (stw).
   void instructionCompleted();
 
-  // Receive an instruction from the previous stage.
-  virtual DecodedInst receiveInstruction() = 0;
+  // Receive an instruction from the previous stage. The instruction stays in
+  // the pipeline register, and may be modified in place.
+  virtual DecodedInst& receiveInstruction() = 0;
 
   // Send the transformed instruction on to the next pipeline stage.
   virtual void outputInstruction(const DecodedInst& inst) = 0;
@@ -95,8 +96,11 @@ protected:
 
 protected:
 
-  // The instruction currently being worked on.
-  DecodedInst currentInst;
+  // The instruction currently being worked on. This usually points into the
+  // previous pipeline register, to avoid copying each instruction into every
+  // stage. Stages which produce their own instructions use `localInst`.
+  DecodedInst* currentInst;
+  DecodedInst localInst;
   bool currentInstValid;
 
   sc_event newInstructionEvent, instructionCompletedEvent;
@@ -117,7 +121,7 @@ public:
 
   FirstPipelineStage(const sc_module_name& name);
 
-  virtual DecodedInst receiveInstruction();
+  virtual DecodedInst& receiveInstruction();
   virtual bool discardNextInst();
   virtual void outputInstruction(const DecodedInst& inst);
   virtual bool previousStageBlocked() const;
@@ -137,7 +141,7 @@ public:
 
   LastPipelineStage(const sc_module_name& name);
 
-  virtual DecodedInst receiveInstruction();
+  virtual DecodedInst& receiveInstruction();
   virtual bool discardNextInst();
   virtual void outputInstruction(const DecodedInst& inst);
   virtual bool previousStageBlocked() const;
@@ -161,7 +165,7 @@ public:
 
   PipelineStage(const sc_module_name& name);
 
-  virtual DecodedInst receiveInstruction();
+  virtual DecodedInst& receiveInstruction();
   virtual bool discardNextInst();
   virtual void outputInstruction(const DecodedInst& inst);
   virtual bool previousStageBlocked() const;
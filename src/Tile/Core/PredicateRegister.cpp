@@ -7,17 +7,17 @@
 
 #include "../../Tile/Core/PredicateRegister.h"
 
-bool PredicateRegister::read() const {
-  return predicate;
+bool PredicateRegister::read(ThreadIndex thread) const {
+  return predicate[thread];
 }
 
-void PredicateRegister::write(bool val) {
-  predicate = val;
+void PredicateRegister::write(ThreadIndex thread, bool val) {
+  predicate[thread] = val;
   LOKI_LOG(1) << this->name() << " set to " << val << endl;
 }
 
-PredicateRegister::PredicateRegister(const sc_module_name& name) : LokiComponent(name) {
-
-  predicate = false;
+PredicateRegister::PredicateRegister(const sc_module_name& name, uint threads) :
+    LokiComponent(name),
+    predicate(threads, false) {
 
 }
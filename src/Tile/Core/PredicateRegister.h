@@ -1,7 +1,8 @@
 /*
  * PredicateRegister.h
  *
- * A register containing a single boolean value.
+ * A register containing a single boolean value. Each hardware thread has its
+ * own copy.
  *
  *  Created on: 22 Mar 2010
  *      Author: db434
@@ -20,11 +21,11 @@ class PredicateRegister: public LokiComponent {
 
 public:
 
-  // Get the current value.
-  bool read() const;
+  // Get the current value for the given thread.
+  bool read(ThreadIndex thread) const;
 
-  // Write a new value to the register.
-  void write(bool val);
+  // Write a new value to the given thread's register.
+  void write(ThreadIndex thread, bool val);
 
 //============================================================================//
 // Constructors and destructors
@@ -32,7 +33,7 @@ public:
 
 public:
 
-  PredicateRegister(const sc_module_name& name);
+  PredicateRegister(const sc_module_name& name, uint threads);
 
 //============================================================================//
 // Local state
@@ -40,7 +41,7 @@ public:
 
 private:
 
-  bool predicate;
+  vector<bool> predicate;
 
 };
 
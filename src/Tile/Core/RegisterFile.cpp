@@ -53,25 +53,30 @@ int32_t RegisterFile::read(PortIndex port, RegisterIndex reg, bool indirect) con
 }
 
 int32_t RegisterFile::readInternal(const RegisterIndex reg) const {
-  loki_assert_with_message(reg < regs.size(), "Accessing register %d of %d", reg, regs.size());
+  return readInternal(activeThread, reg);
+}
+
+int32_t RegisterFile::readInternal(ThreadIndex thread, const RegisterIndex reg) const {
+  loki_assert_with_message(reg < numRegisters, "Accessing register %d of %d", reg, numRegisters);
 
   if (reg == 0)
     return 0;
   else
-    return regs[reg];
+    return regs[thread * numRegisters + reg];
 }
 
-void RegisterFile::write(const RegisterIndex reg, int32_t value, bool indirect) {
+void RegisterFile::write(ThreadIndex thread, const RegisterIndex reg,
+                         int32_t value, bool indirect) {
 
-  RegisterIndex index = indirect ? regs[reg] : reg;
+  RegisterIndex index = indirect ? readInternal(thread, reg) : reg;
 
   // There are some registers that we can't write to.
   if (isReserved(index)/* || isChannelEnd(index)*/ && index != 0)
     throw InvalidOptionException("destination register", index);
 
-  int oldData = regs[index];
+  int oldData = readInternal(thread, index);
 
-  writeInternal(index, value);
+  writeInternal(thread, index, value);
 
   if (ENERGY_TRACE) {
     Instrumentation::Registers::write(index, oldData, value);
@@ -94,7 +99,7 @@ bool RegisterFile::isChannelEnd(RegisterIndex position) const {
 
 bool RegisterFile::isAddressableReg(RegisterIndex position) const {
   return !(isReserved(position) || isChannelEnd(position))
-      && position < regs.size();
+      && position < numRegisters;
 }
 
 bool RegisterFile::needsIndirect(RegisterIndex position) const {
@@ -102,7 +107,7 @@ bool RegisterFile::needsIndirect(RegisterIndex position) const {
 }
 
 bool RegisterFile::isInvalid(RegisterIndex position) const {
-  return position > regs.size();
+  return position > numRegisters;
 }
 
 RegisterIndex RegisterFile::toChannelID(RegisterIndex position) const {
@@ -115,17 +120,22 @@ RegisterIndex RegisterFile::fromChannelID(RegisterIndex position) const {
   return position + START_OF_INPUT_CHANNELS;
 }
 
+void RegisterFile::selectThread(ThreadIndex thread) {
+  loki_assert_with_message(thread * numRegisters < regs.size(), "Thread %d", thread);
+  activeThread = thread;
+}
+
 void RegisterFile::updateCurrentIPK(MemoryAddr addr) {
-  writeInternal(1, addr);
+  writeInternal(activeThread, 1, addr);
 }
 
-void RegisterFile::writeInternal(RegisterIndex reg, int32_t data) {
-  loki_assert_with_message(reg < regs.size(), "Accessing register %d of %d", reg, regs.size());
+void RegisterFile::writeInternal(ThreadIndex thread, RegisterIndex reg, int32_t data) {
+  loki_assert_with_message(reg < numRegisters, "Accessing register %d of %d", reg, numRegisters);
 
   if (reg > 0)
     LOKI_LOG(2) << this->name() << ": Stored " << data << " to register " << (int)reg << endl;
 
-  regs[reg] = data;
+  regs[thread * numRegisters + reg] = data;
 }
 
 void RegisterFile::logActivity() {
@@ -141,9 +151,12 @@ Core& RegisterFile::parent() const {
 }
 
 RegisterFile::RegisterFile(sc_module_name name,
-                           const register_file_parameters_t& params) :
+                           const register_file_parameters_t& params,
+                           uint threads) :
     LokiComponent(name),
-    regs(params.size),
+    regs(params.size * threads),
+    numRegisters(params.size),
+    activeThread(0),
     prevRead(3),
     lastActivity(-1) {
 
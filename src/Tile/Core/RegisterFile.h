@@ -6,6 +6,10 @@
  * The next NUM_RECEIVE_CHANNELS registers address the channel-ends.
  * Up to NUM_ADDRESSABLE_REGISTERS are normal registers.
  *
+ * There is a separate bank of registers for each hardware thread. Reads from
+ * the decode stage access the bank of the active thread; writes name the
+ * thread explicitly, since they may complete after a thread switch.
+ *
  *  Created on: 6 Jan 2010
  *      Author: db434
  */
@@ -28,7 +32,8 @@ class RegisterFile: public LokiComponent {
 public:
 
   RegisterFile(sc_module_name name,
-               const register_file_parameters_t& params);
+               const register_file_parameters_t& params,
+               uint threads);
 
 //============================================================================//
 // Methods
@@ -41,9 +46,14 @@ public:
 
   // Read from a register without redirecting to RCET.
   int32_t readInternal(const RegisterIndex reg) const;
+  int32_t readInternal(ThreadIndex thread, const RegisterIndex reg) const;
 
   // Write to a register, including all safety checks.
-  void    write(const RegisterIndex reg, int32_t value, bool indirect);
+  void    write(ThreadIndex thread, const RegisterIndex reg, int32_t value,
+                bool indirect);
+
+  // Direct future reads to the given thread's registers.
+  void    selectThread(ThreadIndex thread);
 
   // Simple methods to tell what sort of register is being dealt with.
   // These perhaps belong in Core rather than here.
@@ -70,7 +80,7 @@ public:
 private:
 
   // Perform the register write (no safety checks, etc.).
-  void writeInternal(RegisterIndex reg, int32_t value);
+  void writeInternal(ThreadIndex thread, RegisterIndex reg, int32_t value);
 
   void logActivity();
 
@@ -82,7 +92,11 @@ private:
 
 private:
 
+  // Registers of all threads: thread t's register r is at t*numRegisters + r.
   vector<uint32_t> regs;
+  const size_t numRegisters;
+
+  ThreadIndex activeThread;
 
   // Data from previous read on each port. Used to compute Hamming distances
   // for energy models. (wr=0, rd1=1, rd2=2)
@@ -139,6 +139,8 @@ void SendChannelEndTable::sentMulticastData() {
   const NetworkData& flit = bufferMulticast.lastDataRead();
   if (ENERGY_TRACE)
     Instrumentation::Network::traffic(id(), flit.channelID().component);
+
+  core().countEvent(ControlRegisters::EVENT_FLIT_SENT);
 }
 
 void SendChannelEndTable::sentPointToPointData() {
@@ -146,6 +148,8 @@ void SendChannelEndTable::sentPointToPointData() {
   if (ENERGY_TRACE)
     Instrumentation::Network::traffic(id(), flit.channelID().component);
 
+  core().countEvent(ControlRegisters::EVENT_FLIT_SENT);
+
   if (core().isMemory(flit.channelID().component))
     Instrumentation::Latency::coreSentMemoryRequest(id(), flit);
 }
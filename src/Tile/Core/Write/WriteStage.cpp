@@ -13,11 +13,11 @@
 #include "../../../Utility/ISA.h"
 
 void WriteStage::execute() {
-  newInput(currentInst);
-//  bool packetInProgress = !currentInst.endOfNetworkPacket();
+  newInput(*currentInst);
+//  bool packetInProgress = !currentInst->endOfNetworkPacket();
 
   if (Arguments::csimTrace())
-    core().trace(currentInst);
+    core().trace(*currentInst);
 
   instructionCompleted();
 }
@@ -38,9 +38,9 @@ void WriteStage::updateReady() {
     oReady.write(ready);
 
     if (ready)
-      Instrumentation::Stalls::unstall(id(), Instrumentation::Stalls::STALL_OUTPUT, currentInst);
+      Instrumentation::Stalls::unstall(id(), Instrumentation::Stalls::STALL_OUTPUT, *currentInst);
     else
-      Instrumentation::Stalls::stall(id(), Instrumentation::Stalls::STALL_OUTPUT, currentInst);
+      Instrumentation::Stalls::stall(id(), Instrumentation::Stalls::STALL_OUTPUT, *currentInst);
 
     if (!ready)
       LOKI_LOG(3) << this->name() << " stalled." << endl;
@@ -52,7 +52,7 @@ bool WriteStage::isStalled() const {
 }
 
 void WriteStage::writeReg(RegisterIndex reg, int32_t value, bool indirect) const {
-  core().writeReg(reg, value, indirect);
+  core().writeReg(currentInst->thread(), reg, value, indirect);
 }
 
 WriteStage::WriteStage(sc_module_name name,
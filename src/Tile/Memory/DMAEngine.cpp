@@ -0,0 +1,303 @@
+/*
+ * DMAEngine.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "DMAEngine.h"
+#include "../ComputeTile.h"
+#include "../../Datatype/Encoding.h"
+#include "../../Network/NetworkTypes.h"
+#include "../../Utility/Assert.h"
+#include "../../Utility/Instrumentation.h"
+#include "../../Utility/Instrumentation/DMA.h"
+
+DMAEngine::DMAEngine(const sc_module_name& name,
+                     const tile_parameters_t& params) :
+    LokiComponent(name),
+    clock("clock"),
+    oRequest("oRequest"),
+    iResponse("iResponse", params.dma.buffers),
+    oData("oData"),
+    numCores(params.numCores),
+    numMemories(params.numMemories),
+    lineBytes(params.memory.cacheLineSize),
+    registers(NUM_DMA_REGISTERS, 0),
+    active(false),
+    linesFetched(0),
+    linesStored(0),
+    startTime(0),
+    buffers(params.dma.buffers),
+    fetchesIssued(0),
+    storing(params.dma.buffers),
+    flitsSent(0),
+    requests("requests", params.memory.outputFIFO),
+    notifications("notifications", params.memory.outputFIFO) {
+
+  // Response channels follow the memory banks, and must fit in the return
+  // channel field of memory requests.
+  loki_assert_with_message(params.dma.buffers >= 1, "DMA buffers = %d", params.dma.buffers);
+  loki_assert_with_message(params.numMemories + params.dma.buffers <= 16,
+      "Too many DMA buffers: %d", params.dma.buffers);
+
+  registers[DMA_ROWS] = 1;
+  registers[DMA_NOTIFY] = DMA_NO_NOTIFY;
+
+  for (uint i=0; i<buffers.size(); i++) {
+    buffers[i].state = BUFFER_FREE;
+    buffers[i].data.reserve(lineBytes / BYTES_PER_WORD);
+
+    std::stringstream bufName;
+    bufName << "responses_" << i;
+    responses.push_back(new NetworkFIFO<Word>(bufName.str().c_str(), params.memory.inputFIFO));
+
+    responses[i].clock(clock);
+    iResponse[i](responses[i]);
+  }
+
+  requests.clock(clock);
+  oRequest(requests);
+
+  notifications.clock(clock);
+  oData(notifications);
+
+  SC_METHOD(mainLoop);
+  sensitive << transferQueued;
+  dont_initialize();
+}
+
+void DMAEngine::writeRegister(uint reg, uint32_t value) {
+  loki_assert_with_message(reg < NUM_DMA_REGISTERS, "DMA register %d", reg);
+
+  LOKI_LOG(2) << this->name() << " register " << reg << " = " << LOKI_HEX(value) << endl;
+
+  if (reg != DMA_START) {
+    registers[reg] = value;
+    return;
+  }
+
+  Transfer transfer;
+  transfer.source = registers[DMA_SOURCE];
+  transfer.destination = registers[DMA_DESTINATION];
+  transfer.rowBytes = registers[DMA_ROW_BYTES];
+  transfer.rows = registers[DMA_ROWS];
+  transfer.sourceStride = (int32_t)registers[DMA_SOURCE_STRIDE];
+  transfer.destinationStride = (int32_t)registers[DMA_DESTINATION_STRIDE];
+  transfer.notify = (registers[DMA_NOTIFY] != DMA_NO_NOTIFY);
+  transfer.tag = Word(value);
+
+  loki_assert_with_message(transfer.source % lineBytes == 0,
+      "DMA source 0x%x not line-aligned", transfer.source);
+  loki_assert_with_message(transfer.destination % lineBytes == 0,
+      "DMA destination 0x%x not line-aligned", transfer.destination);
+  loki_assert_with_message(transfer.rowBytes % lineBytes == 0,
+      "DMA row length %d not a whole number of lines", transfer.rowBytes);
+  loki_assert_with_message(transfer.sourceStride % (int32_t)lineBytes == 0,
+      "DMA source stride %d not line-aligned", transfer.sourceStride);
+  loki_assert_with_message(transfer.destinationStride % (int32_t)lineBytes == 0,
+      "DMA destination stride %d not line-aligned", transfer.destinationStride);
+
+  if (transfer.notify) {
+    transfer.notifyChannel = ChannelID(registers[DMA_NOTIFY], Encoding::softwareChannelID);
+    loki_assert_with_message(transfer.notifyChannel.component.tile == tile().id
+                          && tile().isCore(transfer.notifyChannel.component),
+        "DMA can only notify cores on its own tile: %s",
+        transfer.notifyChannel.getString(Encoding::softwareChannelID).c_str());
+  }
+
+  pending.push(transfer);
+  transferQueued.notify(sc_core::SC_ZERO_TIME);
+}
+
+bool DMAEngine::idle() const {
+  return !active && pending.empty();
+}
+
+void DMAEngine::mainLoop() {
+  collectResponses();
+
+  if (!active)
+    startTransfer();
+
+  if (active) {
+    sendRequest();
+    checkCompletion();
+  }
+
+  if (idle())
+    next_trigger(transferQueued);
+  else
+    next_trigger(clock.posedge_event());
+}
+
+void DMAEngine::collectResponses() {
+  uint wordsPerLine = lineBytes / BYTES_PER_WORD;
+
+  for (uint i=0; i<buffers.size(); i++) {
+    LineBuffer& buffer = buffers[i];
+
+    while (responses[i].canRead()) {
+      loki_assert_with_message(buffer.state == BUFFER_FETCHING,
+          "Unexpected response for DMA buffer %d", i);
+
+      NetworkResponse flit = responses[i].read();
+      buffer.data.push_back(flit.payload().toUInt());
+
+      if (buffer.data.size() == wordsPerLine) {
+        buffer.state = BUFFER_FULL;
+        break;
+      }
+    }
+  }
+}
+
+void DMAEngine::sendRequest() {
+  if (!requests.canWrite())
+    return;
+
+  // Start storing a full buffer, if there is one.
+  if (storing == buffers.size()) {
+    storing = oldestFullBuffer();
+    flitsSent = 0;
+  }
+
+  if (storing < buffers.size()) {
+    LineBuffer& buffer = buffers[storing];
+    NetworkRequest flit;
+
+    if (flitsSent == 0) {
+      flit = header(buffer.destination, storing, STORE_LINE, false);
+      Instrumentation::DMA::storeLine();
+    }
+    else {
+      bool endOfPacket = (flitsSent == buffer.data.size());
+      flit = NetworkRequest(Word(buffer.data[flitsSent - 1]), requester(storing),
+                            PAYLOAD, endOfPacket);
+    }
+
+    requests.write(flit);
+    flitsSent++;
+
+    if (flitsSent > buffer.data.size()) {
+      buffer.state = BUFFER_FREE;
+      buffer.data.clear();
+      storing = buffers.size();
+      linesStored++;
+    }
+    return;
+  }
+
+  // Otherwise, fetch the next line into a free buffer.
+  if (linesFetched == totalLines())
+    return;
+
+  for (uint i=0; i<buffers.size(); i++) {
+    LineBuffer& buffer = buffers[i];
+    if (buffer.state != BUFFER_FREE)
+      continue;
+
+    buffer.state = BUFFER_FETCHING;
+    buffer.destination = destinationLine(linesFetched);
+    buffer.sequence = fetchesIssued++;
+
+    requests.write(header(sourceLine(linesFetched), i, FETCH_LINE, true));
+    Instrumentation::DMA::fetchLine();
+
+    linesFetched++;
+    break;
+  }
+}
+
+void DMAEngine::startTransfer() {
+  if (pending.empty())
+    return;
+
+  current = pending.front();
+  pending.pop();
+
+  active = true;
+  linesFetched = 0;
+  linesStored = 0;
+  startTime = Instrumentation::currentCycle();
+
+  LOKI_LOG(1) << this->name() << " copying " << current.rows << "x"
+      << current.rowBytes << " bytes from " << LOKI_HEX(current.source)
+      << " to " << LOKI_HEX(current.destination) << endl;
+}
+
+void DMAEngine::checkCompletion() {
+  if (linesStored < totalLines())
+    return;
+
+  // Wait until the notification can be sent.
+  if (current.notify) {
+    if (!notifications.canWrite())
+      return;
+
+    notifications.write(NetworkData(current.tag, current.notifyChannel, true));
+  }
+
+  count_t bytes = (count_t)current.rowBytes * current.rows;
+  cycle_count_t cycles = Instrumentation::currentCycle() - startTime;
+  Instrumentation::DMA::transferComplete(bytes, cycles);
+
+  LOKI_LOG(1) << this->name() << " copied " << bytes << " bytes in " << cycles
+      << " cycles" << endl;
+
+  active = false;
+}
+
+uint DMAEngine::totalLines() const {
+  return (current.rowBytes / lineBytes) * current.rows;
+}
+
+MemoryAddr DMAEngine::sourceLine(uint line) const {
+  uint linesPerRow = current.rowBytes / lineBytes;
+  uint row = line / linesPerRow;
+  uint column = line % linesPerRow;
+  return current.source + row * current.sourceStride + column * lineBytes;
+}
+
+MemoryAddr DMAEngine::destinationLine(uint line) const {
+  uint linesPerRow = current.rowBytes / lineBytes;
+  uint row = line / linesPerRow;
+  uint column = line % linesPerRow;
+  return current.destination + row * current.destinationStride + column * lineBytes;
+}
+
+uint DMAEngine::oldestFullBuffer() const {
+  uint oldest = buffers.size();
+
+  for (uint i=0; i<buffers.size(); i++) {
+    if (buffers[i].state != BUFFER_FULL)
+      continue;
+    if (oldest == buffers.size() || buffers[i].sequence < buffers[oldest].sequence)
+      oldest = i;
+  }
+
+  return oldest;
+}
+
+NetworkRequest DMAEngine::header(MemoryAddr address, uint buffer,
+                                 MemoryOpcode opcode, bool endOfPacket) const {
+  NetworkRequest flit(Word(address), requester(buffer), opcode, endOfPacket);
+
+  // The engine never keeps a copy of the data, so main memory treats each line
+  // like a near-memory access rather than a cache fill or writeback.
+  MemoryMetadata metadata = flit.getMemoryMetadata();
+  metadata.skipL1 = 1;
+  flit.setMetadata(metadata.flatten());
+
+  return flit;
+}
+
+ComponentID DMAEngine::requester(uint buffer) const {
+  // Positions after the memory banks. The return channel of a request is its
+  // source's position relative to the first bank.
+  return ComponentID(tile().id, numCores + numMemories + buffer);
+}
+
+ComputeTile& DMAEngine::tile() const {
+  return *static_cast<ComputeTile*>(this->get_parent_object());
+}
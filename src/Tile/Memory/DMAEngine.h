@@ -0,0 +1,217 @@
+/*
+ * DMAEngine.h
+ *
+ * Streaming copy engine shared by all cores of a tile. Copies a rectangular
+ * block of whole cache lines from one address to another without involving
+ * the cores or the L1 banks.
+ *
+ * The engine is programmed by sending DMA_COMMAND requests to any local memory
+ * bank: the head flit holds a register index and the payload holds its new
+ * value. The bank forwards the command to the miss handling logic, which
+ * writes the register. Writing DMA_START queues a transfer using the current
+ * register values, so the next transfer can be set up while one is in
+ * progress.
+ *
+ * Each cache line is fetched from the source with FETCH_LINE and written to
+ * the destination with STORE_LINE, both through the miss handling logic, so
+ * addresses are translated by the tile's directory exactly as L1 misses are.
+ * Every line buffer has its own response channel, so fetches can overlap and
+ * complete in any order.
+ *
+ * On completion, the value written to DMA_START is sent to the channel in
+ * DMA_NOTIFY, if any.
+ *
+ * Requests are marked as skipping the L1, so main memory's coherence directory
+ * knows that the engine keeps no copy of the data. With a coherence protocol,
+ * modified copies of each source line are written back before it is read, and
+ * all cached copies of each destination line, on any tile including this one,
+ * are invalidated before it is written. Without a protocol, software must
+ * flush any dirty source data and invalidate any cached destination data, as
+ * for all other main memory writes. Lines which the directory maps to another
+ * tile's memory are never made coherent.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_TILE_MEMORY_DMAENGINE_H_
+#define SRC_TILE_MEMORY_DMAENGINE_H_
+
+#include <queue>
+#include "../../LokiComponent.h"
+#include "../../Memory/MemoryTypes.h"
+#include "../../Network/NetworkTypes.h"
+#include "../../Network/FIFOs/NetworkFIFO.h"
+#include "../../Utility/LokiVector.h"
+
+class ComputeTile;
+
+class DMAEngine : public LokiComponent {
+
+//============================================================================//
+// Local types
+//============================================================================//
+
+public:
+
+  enum Register {
+    DMA_SOURCE,             // Address of first source line
+    DMA_DESTINATION,        // Address of first destination line
+    DMA_ROW_BYTES,          // Bytes per row: a multiple of the line size
+    DMA_ROWS,               // Number of rows
+    DMA_SOURCE_STRIDE,      // Bytes between the starts of source rows
+    DMA_DESTINATION_STRIDE, // Bytes between the starts of destination rows
+    DMA_NOTIFY,             // Channel to notify on completion (software
+                            // encoding), or DMA_NO_NOTIFY
+    DMA_START,              // Queue a transfer. The value is sent as the
+                            // completion notification.
+
+    NUM_DMA_REGISTERS
+  };
+
+  static const uint32_t DMA_NO_NOTIFY = 0xFFFFFFFF;
+
+private:
+
+  struct Transfer {
+    MemoryAddr source;
+    MemoryAddr destination;
+    uint       rowBytes;
+    uint       rows;
+    int32_t    sourceStride;
+    int32_t    destinationStride;
+    bool       notify;
+    ChannelID  notifyChannel;
+    Word       tag;
+  };
+
+  enum BufferState {
+    BUFFER_FREE,            // Available for a new fetch
+    BUFFER_FETCHING,        // Waiting for data to arrive
+    BUFFER_FULL             // Holding a whole line, ready to be stored
+  };
+
+  struct LineBuffer {
+    BufferState      state;
+    MemoryAddr       destination;
+    count_t          sequence;    // Order in which fetches were issued
+    vector<uint32_t> data;
+  };
+
+//============================================================================//
+// Ports
+//============================================================================//
+
+public:
+
+  typedef sc_port<network_sink_ifc<Word>> InPort;
+  typedef sc_port<network_source_ifc<Word>> OutPort;
+
+  ClockInput            clock;
+
+  // Requests to the miss handling logic.
+  OutPort               oRequest;
+
+  // Responses from the miss handling logic. One port per line buffer.
+  LokiVector<InPort>    iResponse;
+
+  // Completion notifications to cores.
+  OutPort               oData;
+
+//============================================================================//
+// Constructors and destructors
+//============================================================================//
+
+public:
+
+  SC_HAS_PROCESS(DMAEngine);
+  DMAEngine(const sc_module_name& name, const tile_parameters_t& params);
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  // Set one of the engine's registers.
+  void writeRegister(uint reg, uint32_t value);
+
+  // Returns whether all queued transfers have completed.
+  bool idle() const;
+
+private:
+
+  void mainLoop();
+
+  // Move any response data which has arrived into the line buffers.
+  void collectResponses();
+
+  // Send at most one flit to the miss handling logic. Storing a full buffer
+  // takes priority over fetching a new line.
+  void sendRequest();
+
+  // Start the next queued transfer, if there is one.
+  void startTransfer();
+
+  // Notify the requester and record statistics once every line has been
+  // stored.
+  void checkCompletion();
+
+  uint       totalLines() const;
+  MemoryAddr sourceLine(uint line) const;
+  MemoryAddr destinationLine(uint line) const;
+
+  // The buffer which has held a full line for longest, or buffers.size() if
+  // none are full.
+  uint       oldestFullBuffer() const;
+
+  // The head flit of a request for the given line, using the given buffer.
+  NetworkRequest header(MemoryAddr address, uint buffer, MemoryOpcode opcode,
+                        bool endOfPacket) const;
+
+  // The component which is notionally the source of requests using the given
+  // buffer. Responses come back to the response port of the same buffer.
+  ComponentID requester(uint buffer) const;
+
+  ComputeTile& tile() const;
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+private:
+
+  const uint numCores;
+  const uint numMemories;
+  const uint lineBytes;
+
+  vector<uint32_t>      registers;
+
+  // Transfers waiting for the engine to become free.
+  std::queue<Transfer>  pending;
+
+  // The transfer in progress.
+  bool                  active;
+  Transfer              current;
+  uint                  linesFetched;
+  uint                  linesStored;
+  cycle_count_t         startTime;
+
+  vector<LineBuffer>    buffers;
+  count_t               fetchesIssued;
+
+  // The buffer currently being sent to the destination, and the number of
+  // flits of it sent so far (including the head).
+  uint                  storing;
+  uint                  flitsSent;
+
+  LokiVector<NetworkFIFO<Word>> responses;
+  NetworkFIFO<Word>     requests;
+  NetworkFIFO<Word>     notifications;
+
+  // Triggered when a new transfer is queued.
+  sc_event              transferQueued;
+
+};
+
+#endif /* SRC_TILE_MEMORY_DMAENGINE_H_ */
@@ -6,7 +6,10 @@
  */
 
 #include "L2Logic.h"
+#include "MemoryBank.h"
+#include "../ComputeTile.h"
 #include "../../Utility/Assert.h"
+#include "../../Utility/Instrumentation/L2Cache.h"
 
 L2Logic::L2Logic(const sc_module_name& name, const tile_parameters_t& params) :
     LokiComponent(name),
@@ -16,7 +19,16 @@ L2Logic::L2Logic(const sc_module_name& name, const tile_parameters_t& params) :
     oRequestToBanks("oRequestToBanks"),
     log2CacheLineSize(params.memory.log2CacheLineSize()),
     numMemoryBanks(params.numMemories),
-    requestsFromNetwork("requestsFromNetwork") {
+    tagDirectory(params.l2.tagDirectory),
+    allocation((AllocationPolicy)params.l2.allocation),
+    bankHash(params.core.channelMapTable.bankHash,
+             params.core.channelMapTable.bankPermutation),
+    requestsFromNetwork("requestsFromNetwork"),
+    lastAllocation(params.numMemories, 0),
+    numAllocations(0) {
+
+  loki_assert_with_message(allocation <= ALLOCATE_AFFINITY,
+      "Unknown L2 allocation policy: %d", allocation);
 
   rngState = 0x3F;  // Same seed as Verilog uses (see nextTargetBank()).
   randomBank = 0;
@@ -42,7 +54,8 @@ void L2Logic::forwardRequests() {
     // The same target bank is used for all flits of a single request.
     if (newRemoteRequest) {
       MemoryIndex targetBank = getTargetBank(flit);
-      oRequestToBanks->newRequest(flit, targetBank);
+      bool directed = directRequest(flit, targetBank);
+      oRequestToBanks->newRequest(flit, targetBank, directed);
     }
     else
       oRequestToBanks->newPayload(flit);
@@ -69,10 +82,108 @@ MemoryIndex L2Logic::getTargetBank(const NetworkRequest& request) {
     return request.getMemoryMetadata().returnChannel;
   }
 
-  // Otherwise, the target bank is random.
+  // Otherwise, the target bank is chosen by the allocation policy.
   else {
-    return nextRandomBank();
+    return allocationTarget(request);
+  }
+}
+
+MemoryIndex L2Logic::allocationTarget(const NetworkRequest& request) {
+  MemoryAddr address = request.payload().toUInt();
+
+  switch (allocation) {
+    case ALLOCATE_RANDOM:
+      return nextRandomBank();
+
+    case ALLOCATE_INTERLEAVED:
+      return bankHash.map(address >> log2CacheLineSize, numMemoryBanks);
+
+    case ALLOCATE_LRA: {
+      MemoryIndex oldest = 0;
+      for (uint bank=1; bank<numMemoryBanks; bank++)
+        if (lastAllocation[bank] < lastAllocation[oldest])
+          oldest = bank;
+
+      // Only count an allocation if the line is going to be fetched. The
+      // target is ignored if another bank already holds the line.
+      if (holdingBank(address) < 0)
+        lastAllocation[oldest] = ++numAllocations;
+
+      return oldest;
+    }
+
+    case ALLOCATE_LEAST_LOADED: {
+      MemoryIndex leastLoaded = 0;
+      uint lowestOccupancy = tile().memories[0].occupancy();
+      for (uint bank=1; bank<numMemoryBanks; bank++) {
+        uint occupancy = tile().memories[bank].occupancy();
+        if (occupancy < lowestOccupancy) {
+          leastLoaded = bank;
+          lowestOccupancy = occupancy;
+        }
+      }
+      return leastLoaded;
+    }
+
+    case ALLOCATE_AFFINITY: {
+      // Spread requesting tiles across banks, so that tiles in the same row or
+      // column do not all share one bank.
+      MemoryMetadata metadata = request.getMemoryMetadata();
+      return (metadata.returnTileX + 3 * metadata.returnTileY) % numMemoryBanks;
+    }
+
+    default:
+      loki_assert(false);
+      return 0;
+  }
+}
+
+int L2Logic::holdingBank(MemoryAddr address) const {
+  for (uint bank=0; bank<numMemoryBanks; bank++)
+    if (tile().memories[bank].holdsLine(address))
+      return bank;
+
+  return -1;
+}
+
+bool L2Logic::directRequest(const NetworkRequest& request, MemoryIndex& target) const {
+  if (!tagDirectory) {
+    Instrumentation::L2Cache::broadcastRequest();
+    return false;
+  }
+
+  // Some requests already name the bank they must access.
+  MemoryMetadata metadata = request.getMemoryMetadata();
+  if (metadata.scratchpad || metadata.opcode == PUSH_LINE || metadata.skipL2) {
+    Instrumentation::L2Cache::namedBankRequest();
+    return true;
+  }
+
+  MemoryAddr address = request.payload().toUInt();
+
+  // A bank which is flushing this line must delay the request until the flush
+  // completes. Let all banks see the request so this can happen.
+  for (uint bank=0; bank<numMemoryBanks; bank++) {
+    if (tile().memories[bank].flushing(address)) {
+      Instrumentation::L2Cache::broadcastRequest();
+      return false;
+    }
+  }
+
+  int holder = holdingBank(address);
+  if (holder >= 0) {
+    target = holder;
+    Instrumentation::L2Cache::directedRequest(true);
+    return true;
   }
+
+  // No bank has the data: the target bank will allocate it.
+  Instrumentation::L2Cache::directedRequest(false);
+  return true;
+}
+
+ComputeTile& L2Logic::tile() const {
+  return *static_cast<ComputeTile*>(this->get_parent_object());
 }
 
 MemoryIndex L2Logic::nextRandomBank() {
@@ -4,6 +4,14 @@
  * Logic which allows the memory banks of a single tile to behave as a unified
  * associative cache.
  *
+ * A line which misses is allocated in a bank chosen by the allocation policy
+ * (the l2-allocation parameter).
+ *
+ * By default, each request is broadcast to all banks so they can check their
+ * tags. With the optional tag directory, the L2 logic holds a copy of all
+ * banks' tags and sends each request straight to the one bank which should
+ * serve it.
+ *
  *  Created on: 3 Apr 2019
  *      Author: db434
  */
@@ -11,11 +19,15 @@
 #ifndef SRC_TILE_MEMORY_L2LOGIC_H_
 #define SRC_TILE_MEMORY_L2LOGIC_H_
 
+#include <vector>
 #include "../../LokiComponent.h"
+#include "../../Memory/AddressHash.h"
 #include "../../Network/NetworkChannel.h"
 #include "../../Utility/LokiVector.h"
 #include "../Network/L2LToBankRequests.h"
 
+class ComputeTile;
+
 class L2Logic: public LokiComponent {
 
 //============================================================================//
@@ -67,18 +79,48 @@ private:
   // Determine which memory bank should be the target for the given request.
   MemoryIndex getTargetBank(const NetworkRequest& request);
 
+  // Select the bank which will allocate the line if it is not already held by
+  // any bank.
+  MemoryIndex allocationTarget(const NetworkRequest& request);
+
   // Pseudo-randomly select a target bank.
   MemoryIndex nextRandomBank();
 
+  // The bank which holds a valid copy of the given address, or -1 if none.
+  int holdingBank(MemoryAddr address) const;
+
+  // Use the tag directory to decide whether the request can be sent to a
+  // single bank. May update `target` to the bank which holds the data.
+  bool directRequest(const NetworkRequest& request, MemoryIndex& target) const;
+
+  // A reference to the parent tile.
+  ComputeTile& tile() const;
+
 //============================================================================//
 // Local state
 //============================================================================//
 
+public:
+
+  enum AllocationPolicy {
+    ALLOCATE_RANDOM       = 0,
+    ALLOCATE_INTERLEAVED  = 1,
+    ALLOCATE_LRA          = 2,
+    ALLOCATE_LEAST_LOADED = 3,
+    ALLOCATE_AFFINITY     = 4
+  };
+
 private:
 
   // Configuration.
   const size_t log2CacheLineSize; // In bytes.
   const size_t numMemoryBanks;
+  const bool   tagDirectory;
+  const AllocationPolicy allocation;
+
+  // Address-interleaved allocation spreads lines across banks in the same way
+  // as the L1 channel map table spreads them across a memory group.
+  const AddressHash bankHash;
 
   // Buffers/latches for network communications.
   NetworkChannel<Word> requestsFromNetwork;
@@ -90,6 +132,11 @@ private:
   // Used for random number generation.
   unsigned int rngState;
   MemoryIndex randomBank;
+
+  // Least-recently-allocated policy: the allocation number of the most recent
+  // line allocated in each bank.
+  std::vector<count_t> lastAllocation;
+  count_t numAllocations;
 };
 
 #endif /* SRC_TILE_MEMORY_L2LOGIC_H_ */
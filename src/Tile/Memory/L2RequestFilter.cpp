@@ -8,6 +8,7 @@
 #include "../../Tile/Memory/L2RequestFilter.h"
 #include "../../Tile/Memory/MemoryBank.h"
 #include "../../Utility/Assert.h"
+#include "../../Utility/Instrumentation/L2Cache.h"
 #include "../../Utility/Instrumentation/Latency.h"
 
 L2RequestFilter::L2RequestFilter(const sc_module_name& name, MemoryBank& localBank) :
@@ -25,7 +26,7 @@ L2RequestFilter::~L2RequestFilter() {
 
 void L2RequestFilter::end_of_elaboration() {
   SC_METHOD(mainLoop);
-  sensitive << iRequest->newRequestArrived();
+  sensitive << iRequest->newRequestArrived(localBank.memoryIndex());
   dont_initialize();
 }
 
@@ -57,11 +58,13 @@ void L2RequestFilter::mainLoop() {
       // Perform a few checks to see whether this bank should claim the
       // request now, wait until next cycle, or ignore the request entirely.
       // This bank is responsible if the operation is one which specifies
-      // that this bank should be used, or if the bank was chosen randomly
-      // but this bank contains the data already.
+      // that this bank should be used, if the tag directory sent the request
+      // only to this bank, or if the bank was chosen randomly but this bank
+      // contains the data already.
       bool cacheHit = localBank.contains(address, position, mode);
       bool targetingThisBank = iRequest->targetBank() == localBank.memoryIndex();
-      bool mustAccessTarget = (mode == MEMORY_SCRATCHPAD) || (opcode == PUSH_LINE) || request.getMemoryMetadata().skipL2;
+      bool namedBank = (mode == MEMORY_SCRATCHPAD) || (opcode == PUSH_LINE) || request.getMemoryMetadata().skipL2;
+      bool mustAccessTarget = namedBank || iRequest->directed();
       bool ignore = mustAccessTarget && !targetingThisBank;
       bool serveRequest = (targetingThisBank && mustAccessTarget) || (cacheHit && !ignore);
 
@@ -81,6 +84,9 @@ void L2RequestFilter::mainLoop() {
       if (serveRequest) {
         LOKI_LOG(2) << this->name() << " claiming request (cache hit)" << endl;
 
+        if (!namedBank)
+          Instrumentation::L2Cache::access(localBank.id, cacheHit);
+
         state = STATE_SEND;
         next_trigger(sc_core::SC_ZERO_TIME);
 
@@ -92,7 +98,7 @@ void L2RequestFilter::mainLoop() {
         state = STATE_WAIT;
       }
       else {
-        next_trigger(iRequest->newRequestArrived());
+        next_trigger(iRequest->newRequestArrived(localBank.memoryIndex()));
       }
       break;
     }
@@ -103,12 +109,14 @@ void L2RequestFilter::mainLoop() {
       // Someone else claimed the request - wait for a new one.
       if (iRequest->associativeHit()) {
         state = STATE_IDLE;
-        next_trigger(iRequest->newRequestArrived());
+        next_trigger(iRequest->newRequestArrived(localBank.memoryIndex()));
       }
       // No one else has claimed - the request is ours.
       else {
         LOKI_LOG(2) << this->name() << " claiming request (target bank)" << endl;
 
+        Instrumentation::L2Cache::access(localBank.id, false);
+
         state = STATE_SEND;
         next_trigger(sc_core::SC_ZERO_TIME);
 
@@ -0,0 +1,451 @@
+/*
+ * LastLevelCache.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "LastLevelCache.h"
+#include "../MemoryControllerTile.h"
+#include "../../Chip.h"
+#include "../../Datatype/MemoryOperations/MemoryOperationDecode.h"
+#include "../../OffChip/MainMemory.h"
+#include "../../Utility/Assert.h"
+#include "../../Utility/Instrumentation/LastLevelCache.h"
+
+LastLevelCache::LastLevelCache(sc_module_name name, const ComponentID& id,
+                               const main_memory_parameters_t& params,
+                               MainMemory& memory) :
+    MemoryBase(name, id, params.log2CacheLineSize()),
+    iClock("iClock"),
+    iRequest("iRequest"),
+    oResponse("oResponse"),
+    oMemoryRequest("oMemoryRequest"),
+    iMemoryResponse("iMemoryResponse"),
+    associativity(params.llc.associativity),
+    numSets(params.llc.size / params.cacheLineSize / params.llc.associativity),
+    replacement((ReplacementPolicy)params.llc.replacement),
+    data(params.llc.size/BYTES_PER_WORD, 0),
+    metadata(numSets * associativity),
+    outputQueue("delay", 1024 /* "infinite" size */, 100, (double)params.llc.latency),
+    mainMemory(memory) {
+
+  loki_assert(associativity >= 1);
+  loki_assert_with_message(numSets >= 1, "Size = %d", params.llc.size);
+  loki_assert_with_message(replacement <= REPLACE_RANDOM, "Policy = %d", replacement);
+
+  state = STATE_IDLE;
+  accessCount = 0;
+  lfsr = 0xACE1;
+  cacheLineCursor = 0;
+  invalidateActiveLine = false;
+  bypassPayload = false;
+  bypassResponse = false;
+
+  for (uint line=0; line<metadata.size(); line++) {
+    metadata[line].valid = false;
+    metadata[line].stamp = 0;
+  }
+
+  outputQueue.clock(iClock);
+  oResponse(outputQueue);
+
+  SC_METHOD(mainLoop);
+  sensitive << iClock.pos();
+  dont_initialize();
+
+}
+
+LastLevelCache::~LastLevelCache() {
+  // Nothing
+}
+
+
+// Compute the position in SRAM that the given memory address is to be found.
+// If the data is not present, this is the position it will be stored when it
+// arrives.
+SRAMAddress LastLevelCache::getPosition(MemoryAddr address, MemoryAccessMode mode) const {
+  uint set = getSet(address);
+  int way = findWay(address);
+  if (way < 0)
+    way = chooseVictim(set);
+
+  uint line = set * associativity + way;
+  return (line << log2CacheLineSize) | getOffset(address);
+}
+
+// Return the position in the memory address space of the data stored at the
+// given position.
+MemoryAddr LastLevelCache::getAddress(SRAMAddress position) const {
+  return metadata[getLine(position)].address + getOffset(position);
+}
+
+// Return whether data from `address` can be found at `position` in the SRAM.
+bool LastLevelCache::contains(MemoryAddr address, SRAMAddress position, MemoryAccessMode mode) const {
+  // Requests at this level always arrive in scratchpad mode, but the tags are
+  // checked regardless.
+  const TagData& tag = metadata[getLine(position)];
+  return tag.valid && (tag.address == getTag(address));
+}
+
+// Ensure that a valid copy of data from `address` can be found at `position`.
+void LastLevelCache::allocate(MemoryAddr address, SRAMAddress position, MemoryAccessMode mode) {
+  if (contains(address, position, mode))
+    return;
+
+  LOKI_LOG(2) << this->name() << " cache miss at address " << LOKI_HEX(address) << endl;
+
+  // Lines are never dirty, so the previous contents can be dropped.
+  TagData& tag = metadata[getLine(position)];
+  tag.address = getTag(address);
+  tag.valid = false;
+  tag.stamp = ++accessCount;
+  nextRandom();
+
+  // Pass the original request on to main memory. The response will come back
+  // here.
+  loki_assert(oMemoryRequest->canWrite());
+  oMemoryRequest->write(activeHeader);
+
+  state = STATE_REFILL;
+  cacheLineCursor = 0;
+}
+
+// Ensure that there is a space to write data to `address` at `position`.
+void LastLevelCache::validate(MemoryAddr address, SRAMAddress position, MemoryAccessMode mode) {
+  uint line = getLine(position);
+  TagData& tag = metadata[line];
+
+  if (!contains(address, position, mode)) {
+    tag.address = getTag(address);
+    tag.valid = true;
+    tag.stamp = ++accessCount;
+    nextRandom();
+  }
+  else
+    touch(line);
+}
+
+// Invalidate the cache line which contains `position`.
+void LastLevelCache::invalidate(SRAMAddress position, MemoryAccessMode mode) {
+  metadata[getLine(position)].valid = false;
+}
+
+// Flush the cache line containing `position` down the memory hierarchy, if
+// necessary. The line is not invalidated, but is no longer dirty.
+void LastLevelCache::flush(SRAMAddress position, MemoryAccessMode mode) {
+  // Do nothing: data is written through to main memory as it arrives.
+}
+
+// Return whether a payload flit is available. `level` tells whether this bank
+// is being treated as an L1 or L2 cache.
+bool LastLevelCache::payloadAvailable(MemoryLevel level) const {
+  loki_assert_with_message(level == MEMORY_OFF_CHIP, "Level = %d", level);
+
+  // Each payload is also forwarded to main memory, so there must be space.
+  return iRequest->canRead() && isPayload(iRequest->peek())
+      && oMemoryRequest->canWrite();
+}
+
+// Retrieve a payload flit. `level` tells whether this bank is being treated
+// as an L1 or L2 cache.
+uint32_t LastLevelCache::getPayload(MemoryLevel level) {
+  loki_assert(payloadAvailable(level));
+
+  NetworkRequest request = iRequest->read();
+  oMemoryRequest->write(request);
+
+  return request.payload().toUInt();
+}
+
+// Send a result to the requested destination.
+void LastLevelCache::sendResponse(NetworkResponse response, MemoryLevel level) {
+  loki_assert_with_message(level == MEMORY_OFF_CHIP, "Level = %d", level);
+  loki_assert(outputQueue.canWrite());
+
+  outputQueue.write(response);
+}
+
+// Make a load-linked reservation.
+void LastLevelCache::makeReservation(ComponentID requester, MemoryAddr address, MemoryAccessMode mode) {
+  // Do nothing.
+}
+
+// Return whether a load-linked reservation is still valid.
+bool LastLevelCache::checkReservation(ComponentID requester, MemoryAddr address, MemoryAccessMode mode) const {
+  // Do nothing.
+  return false;
+}
+
+// Check whether it is safe for the given operation to modify memory.
+void LastLevelCache::preWriteCheck(const MemoryOperation& operation) const {
+  // Do nothing: main memory checks all data written through to it.
+}
+
+// Check whether instructions may be fetched by the given operation.
+void LastLevelCache::preExecuteCheck(const MemoryOperation& operation) const {
+  // Do nothing: instructions are only fetched by L1 banks.
+}
+
+void LastLevelCache::invalidateLine(MemoryAddr address) {
+  // Don't pull data out from under a request which is using it. The request
+  // started before the line was modified, so still sees a consistent view, but
+  // the line must not outlive it.
+  if (state != STATE_IDLE && activeRequest != NULL
+      && getTag(activeRequest->getAddress()) == getTag(address)) {
+    invalidateActiveLine = true;
+    Instrumentation::LastLevelCache::invalidate();
+    return;
+  }
+
+  int way = findWay(address);
+  if (way < 0)
+    return;
+
+  metadata[getSet(address) * associativity + way].valid = false;
+  Instrumentation::LastLevelCache::invalidate();
+}
+
+const vector<uint32_t>& LastLevelCache::dataArray() const {
+  return data;
+}
+
+vector<uint32_t>& LastLevelCache::dataArray() {
+  return data;
+}
+
+void LastLevelCache::mainLoop() {
+  switch (state) {
+    case STATE_IDLE:      processIdle();      break;
+    case STATE_REQUEST:   processRequest();   break;
+    case STATE_REFILL:    processRefill();    break;
+    case STATE_BYPASS:    processBypass();    break;
+  }
+}
+
+void LastLevelCache::processIdle() {
+  loki_assert_with_message(state == STATE_IDLE, "State = %d", state);
+
+  if (!iRequest->canRead()) {
+    next_trigger(iRequest->canReadEvent());
+  }
+  // All requests may need to send something to main memory straight away.
+  else if (!oMemoryRequest->canWrite()) {
+    next_trigger(oMemoryRequest->canWriteEvent());
+  }
+  else {
+    NetworkRequest request = iRequest->read();
+    MemoryMetadata metadata = request.getMemoryMetadata();
+    MemoryAddr address = request.payload().toUInt();
+
+    ChannelID returnAddress(metadata.returnTileX,
+                            metadata.returnTileY,
+                            metadata.returnChannel,
+                            0);
+
+    // Operations on individual words are performed at main memory. Main
+    // memory invalidates any copy held here if the data is modified.
+    if (MainMemory::nearMemoryOperation(metadata.opcode)) {
+      oMemoryRequest->write(request);
+
+      bypassPayload = !request.getMetadata().endOfPacket;
+      bypassResponse = (metadata.opcode != STORE_W)
+                    && (metadata.opcode != STORE_HW)
+                    && (metadata.opcode != STORE_B);
+      state = STATE_BYPASS;
+
+      LOKI_LOG(1) << this->name() << " passing " << memoryOpName(metadata.opcode)
+          << " request to main memory" << endl;
+      return;
+    }
+
+    // Cycles spent waiting for other tiles to respond to coherence recalls.
+    cycle_count_t recallCycles = 0;
+
+    switch (metadata.opcode) {
+      case FETCH_LINE:
+        // Give the coherence directory a chance to retrieve modified data
+        // from other tiles. This may invalidate the copy held here. DMA
+        // transfers skip the L1 and keep no copy of the line.
+        if (metadata.skipL1)
+          recallCycles = mainMemory.prepareDirectAccess(address, returnAddress.component.tile, false);
+        else
+          recallCycles = mainMemory.checkSafeRead(address, returnAddress.component.tile);
+        Instrumentation::LastLevelCache::access(true, findWay(address) >= 0);
+        break;
+
+      case STORE_LINE:
+        Instrumentation::LastLevelCache::access(false, findWay(address) >= 0);
+
+        // Data is written through to main memory. Any copies in other slices
+        // (and this one) are now out of date.
+        oMemoryRequest->write(request);
+        chip().invalidateLastLevelCaches(address);
+        break;
+
+      default:
+        loki_assert_with_message(false, "%s not supported by last-level cache", memoryOpName(metadata.opcode).c_str());
+        break;
+    }
+
+    activeHeader = request;
+    activeRequest = std::unique_ptr<MemoryOperation>(decodeMemoryRequest(request, *this, MEMORY_OFF_CHIP, returnAddress));
+
+    if (activeRequest->inCache())
+      touch(getLine(activeRequest->getSRAMAddress()));
+
+    state = STATE_REQUEST;
+    if (recallCycles > 0)
+      next_trigger(recallCycles, sc_core::SC_NS);
+    else
+      next_trigger(sc_core::SC_ZERO_TIME);
+
+    LOKI_LOG(1) << this->name() << " starting " << memoryOpName(metadata.opcode)
+        << " request from component " << activeRequest->getDestination().component << endl;
+  }
+}
+
+void LastLevelCache::processRequest() {
+  loki_assert_with_message(state == STATE_REQUEST, "State = %d", state);
+  loki_assert(activeRequest != NULL);
+
+  if (!iClock.negedge()) {
+    next_trigger(iClock.negedge_event());
+  }
+  else if (!activeRequest->preconditionsMet()) {
+    // A miss sends a request to main memory.
+    if (oMemoryRequest->canWrite())
+      activeRequest->prepare();
+    else
+      next_trigger(oMemoryRequest->canWriteEvent());
+  }
+  else if (!activeRequest->complete()) {
+    activeRequest->execute();
+  }
+
+  // If the operation has finished, end the request and prepare for a new one.
+  if (activeRequest->complete() && state == STATE_REQUEST) {
+    if (invalidateActiveLine) {
+      metadata[getLine(activeRequest->getSRAMAddress())].valid = false;
+      invalidateActiveLine = false;
+    }
+
+    state = STATE_IDLE;
+    activeRequest.reset();
+
+    // Decode the next request immediately so it is ready to start next cycle.
+    next_trigger(sc_core::SC_ZERO_TIME);
+  }
+}
+
+void LastLevelCache::processRefill() {
+  loki_assert_with_message(state == STATE_REFILL, "State = %d", state);
+  loki_assert(activeRequest != NULL);
+
+  if (!iMemoryResponse->canRead()) {
+    next_trigger(iMemoryResponse->canReadEvent());
+  }
+  else {
+    NetworkResponse response = iMemoryResponse->read();
+    SRAMAddress position = getTag(activeRequest->getSRAMAddress()) + cacheLineCursor;
+    writeWord(position, response.payload().toUInt(), MEMORY_SCRATCHPAD, true);
+
+    cacheLineCursor += BYTES_PER_WORD;
+
+    // Refill has finished if the cursor has covered a whole cache line.
+    if (cacheLineCursor >= cacheLineBytes()) {
+      metadata[getLine(position)].valid = true;
+      state = STATE_REQUEST;
+
+      LOKI_LOG(2) << this->name() << " resuming " << memoryOpName(activeRequest->getMetadata().opcode) << " request" << endl;
+    }
+  }
+}
+
+void LastLevelCache::processBypass() {
+  loki_assert_with_message(state == STATE_BYPASS, "State = %d", state);
+
+  if (bypassPayload) {
+    if (!iRequest->canRead())
+      next_trigger(iRequest->canReadEvent());
+    else if (!oMemoryRequest->canWrite())
+      next_trigger(oMemoryRequest->canWriteEvent());
+    else {
+      NetworkRequest payload = iRequest->read();
+      oMemoryRequest->write(payload);
+      bypassPayload = !payload.getMetadata().endOfPacket;
+    }
+  }
+  else if (bypassResponse) {
+    if (!iMemoryResponse->canRead())
+      next_trigger(iMemoryResponse->canReadEvent());
+    else {
+      NetworkResponse response = iMemoryResponse->read();
+      loki_assert(outputQueue.canWrite());
+      outputQueue.write(response);
+      bypassResponse = !response.getMetadata().endOfPacket;
+    }
+  }
+
+  if (!bypassPayload && !bypassResponse) {
+    state = STATE_IDLE;
+    next_trigger(sc_core::SC_ZERO_TIME);
+  }
+}
+
+int LastLevelCache::findWay(MemoryAddr address) const {
+  uint set = getSet(address);
+  MemoryTag tag = getTag(address);
+
+  for (uint way=0; way<associativity; way++) {
+    const TagData& entry = metadata[set * associativity + way];
+    if (entry.valid && entry.address == tag)
+      return way;
+  }
+
+  return -1;
+}
+
+uint LastLevelCache::chooseVictim(uint set) const {
+  uint first = set * associativity;
+
+  // Always use an empty way if there is one.
+  for (uint way=0; way<associativity; way++)
+    if (!metadata[first + way].valid)
+      return way;
+
+  switch (replacement) {
+    case REPLACE_LRU:
+    case REPLACE_FIFO: {
+      // LRU stamps are updated on every access; FIFO stamps only on
+      // allocation.
+      uint victim = 0;
+      for (uint way=1; way<associativity; way++)
+        if (metadata[first + way].stamp < metadata[first + victim].stamp)
+          victim = way;
+      return victim;
+    }
+
+    case REPLACE_RANDOM:
+    default:
+      return lfsr % associativity;
+  }
+}
+
+void LastLevelCache::touch(uint line) {
+  if (replacement == REPLACE_LRU)
+    metadata[line].stamp = ++accessCount;
+}
+
+void LastLevelCache::nextRandom() {
+  // 16-bit Galois LFSR.
+  lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+}
+
+uint LastLevelCache::getSet(MemoryAddr address) const {
+  return (address >> log2CacheLineSize) % numSets;
+}
+
+Chip& LastLevelCache::chip() const {
+  return static_cast<MemoryControllerTile&>(*(this->get_parent_object())).chip();
+}
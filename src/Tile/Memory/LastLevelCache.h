@@ -0,0 +1,206 @@
+/*
+ * LastLevelCache.h
+ *
+ * One slice of the shared last-level cache, sitting between a memory
+ * controller tile and main memory.
+ *
+ * Caches send FETCH_LINE and STORE_LINE requests to this level. The cache is
+ * write-through: stored lines are kept, but are also always sent on to main
+ * memory. This means there are never any dirty lines to write back, and other
+ * slices holding a stale copy of a line can simply be invalidated.
+ *
+ * Word accesses and atomic operations which bypass all caches are passed
+ * straight through to main memory, which serialises all such operations on
+ * each address.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_TILE_MEMORY_LASTLEVELCACHE_H_
+#define SRC_TILE_MEMORY_LASTLEVELCACHE_H_
+
+#include <memory>
+#include "../../Memory/MemoryBase.h"
+#include "../../Network/FIFOs/DelayFIFO.h"
+
+class Chip;
+class MainMemory;
+
+class LastLevelCache: public MemoryBase {
+
+//============================================================================//
+// Ports
+//============================================================================//
+
+public:
+
+  ClockInput     iClock;
+
+  // Requests from on-chip, and responses to them.
+  sc_port<network_source_ifc<Word>> iRequest;
+  sc_port<network_source_ifc<Word>> oResponse;
+
+  // Requests to main memory, and responses from it.
+  sc_port<network_sink_ifc<Word>>   oMemoryRequest;
+  sc_port<network_source_ifc<Word>> iMemoryResponse;
+
+//============================================================================//
+// Constructors and destructors
+//============================================================================//
+
+public:
+
+  SC_HAS_PROCESS(LastLevelCache);
+  LastLevelCache(sc_module_name name, const ComponentID& id,
+                 const main_memory_parameters_t& params, MainMemory& memory);
+  virtual ~LastLevelCache();
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  // Compute the position in SRAM that the given memory address is to be found.
+  virtual SRAMAddress getPosition(MemoryAddr address, MemoryAccessMode mode) const;
+
+  // Return the position in the memory address space of the data stored at the
+  // given position.
+  virtual MemoryAddr getAddress(SRAMAddress position) const;
+
+  // Return whether data from `address` can be found at `position` in the SRAM.
+  virtual bool contains(MemoryAddr address, SRAMAddress position, MemoryAccessMode mode) const;
+
+  // Ensure that a valid copy of data from `address` can be found at `position`.
+  virtual void allocate(MemoryAddr address, SRAMAddress position, MemoryAccessMode mode);
+
+  // Ensure that there is a space to write data to `address` at `position`.
+  virtual void validate(MemoryAddr address, SRAMAddress position, MemoryAccessMode mode);
+
+  // Invalidate the cache line which contains `position`.
+  virtual void invalidate(SRAMAddress position, MemoryAccessMode mode);
+
+  // Flush the cache line containing `position` down the memory hierarchy, if
+  // necessary. The line is not invalidated, but is no longer dirty.
+  virtual void flush(SRAMAddress position, MemoryAccessMode mode);
+
+  // Return whether a payload flit is available. `level` tells whether this bank
+  // is being treated as an L1 or L2 cache.
+  virtual bool payloadAvailable(MemoryLevel level) const;
+
+  // Retrieve a payload flit. `level` tells whether this bank is being treated
+  // as an L1 or L2 cache.
+  virtual uint32_t getPayload(MemoryLevel level);
+
+  // Send a result to the requested destination.
+  virtual void sendResponse(NetworkResponse response, MemoryLevel level);
+
+  // Make a load-linked reservation.
+  virtual void makeReservation(ComponentID requester, MemoryAddr address, MemoryAccessMode mode);
+
+  // Return whether a load-linked reservation is still valid.
+  virtual bool checkReservation(ComponentID requester, MemoryAddr address, MemoryAccessMode mode) const;
+
+  // Check whether it is safe for the given operation to modify memory.
+  virtual void preWriteCheck(const MemoryOperation& operation) const;
+
+  // Check whether instructions may be fetched by the given operation.
+  virtual void preExecuteCheck(const MemoryOperation& operation) const;
+
+  // Discard any copy of the cache line containing `address`. Used when the
+  // line has been modified elsewhere.
+  void invalidateLine(MemoryAddr address);
+
+protected:
+
+  virtual const vector<uint32_t>& dataArray() const;
+  virtual vector<uint32_t>& dataArray();
+
+private:
+
+  void mainLoop();
+  void processIdle();
+  void processRequest();
+  void processRefill();
+  void processBypass();
+
+  // Find the way holding `address` in its set, or -1 if there is none.
+  int findWay(MemoryAddr address) const;
+
+  // Choose which way of a set to replace.
+  uint chooseVictim(uint set) const;
+
+  // Update replacement information after an access.
+  void touch(uint line);
+
+  // Step the pseudo-random replacement state after each allocation.
+  void nextRandom();
+
+  uint getSet(MemoryAddr address) const;
+
+  Chip& chip() const;
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+private:
+
+  enum ReplacementPolicy {
+    REPLACE_LRU,
+    REPLACE_FIFO,
+    REPLACE_RANDOM
+  };
+
+  enum CacheState {
+    STATE_IDLE,                        // No active request
+    STATE_REQUEST,                     // Serving active request
+    STATE_REFILL,                      // Waiting for data from main memory
+    STATE_BYPASS,                      // Passing a request to main memory
+  };
+
+  typedef struct {
+    MemoryTag address;  // Which data is stored here?
+    bool      valid;    // Is the data present?
+    uint64_t  stamp;    // Last use (LRU) or allocation time (FIFO)
+  } TagData;
+
+  const uint associativity;
+  const uint numSets;
+  const ReplacementPolicy replacement;
+
+  CacheState            state;
+
+  std::unique_ptr<MemoryOperation> activeRequest; // The request being served.
+  NetworkRequest        activeHeader;  // Head flit of the active request.
+
+  vector<uint32_t>      data;
+  vector<TagData>       metadata;
+
+  // Incremented on every access, to order the stamps in the tag array.
+  uint64_t              accessCount;
+
+  // State for pseudo-random replacement.
+  uint32_t              lfsr;
+
+  // Position of the next word to arrive from main memory.
+  unsigned int          cacheLineCursor;
+
+  // The active request's line was modified elsewhere, and must be invalidated
+  // once the request completes.
+  bool                  invalidateActiveLine;
+
+  // A request passing through to main memory still has payload flits to send
+  // and/or a response to wait for.
+  bool                  bypassPayload;
+  bool                  bypassResponse;
+
+  DelayFIFO<Word>       outputQueue; // Model cache latency
+
+  // Magic connection to main memory, used for coherence bookkeeping.
+  MainMemory&           mainMemory;
+
+};
+
+#endif /* SRC_TILE_MEMORY_LASTLEVELCACHE_H_ */
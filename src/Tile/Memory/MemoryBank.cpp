@@ -13,13 +13,17 @@ using namespace std;
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include "MemoryBank.h"
 #include "../../Datatype/MemoryOperations/MemoryOperationDecode.h"
 #include "../ComputeTile.h"
 #include "../../Chip.h"
 #include "../../Utility/Assert.h"
+#include "../../Utility/Instrumentation.h"
 #include "../../Utility/Instrumentation/Latency.h"
 #include "../../Utility/Instrumentation/L1Cache.h"
+#include "../../Utility/Instrumentation/WriteBuffer.h"
+#include "../../Utility/Trace/MemoryTrace.h"
 #include "../../Utility/Warnings.h"
 #include "../../Exceptions/ReadOnlyException.h"
 #include "../../Exceptions/UnsupportedFeatureException.h"
@@ -68,14 +72,31 @@ size_t MemoryBank::cacheLineSize() const {
 //
 // Note that this can result in a deterministic but counter-intuitive mapping
 // of addresses in scratchpad mode.
+//
+// Cache accesses use the AddressHash function selected by the
+// memory-bank-set-hash parameter. Its default, HASH_GROUP_XOR, matches the
+// mapping above. Scratchpad accesses always use the mapping above.
 SRAMAddress MemoryBank::getPosition(MemoryAddr address, MemoryAccessMode mode) const {
+  if (mode != MEMORY_CACHE)
+    return defaultPosition(address);
+
+  SRAMAddress position = computePosition(address);
+
   // Slight hack: the contains() method is where one might expect a tag check
   // to happen, but I use that method frequently to help with assertions. I
   // instead perform the instrumentation here, as this method will be executed
   // exactly once per operation.
-  if (mode == MEMORY_CACHE)
-    Instrumentation::L1Cache::checkTags(id, address);
+  Instrumentation::L1Cache::checkTags(id, address, getLine(position));
 
+  return position;
+}
+
+SRAMAddress MemoryBank::computePosition(MemoryAddr address) const {
+  uint slot = setHash.map(address >> log2CacheLineSize, numCacheLines());
+  return (slot << log2CacheLineSize) | getOffset(address);
+}
+
+SRAMAddress MemoryBank::defaultPosition(MemoryAddr address) const {
   static const uint indexBits = log2(numCacheLines());
   uint offset = getOffset(address);
   uint bank = (address >> log2CacheLineSize) & 0x7;
@@ -115,7 +136,7 @@ void MemoryBank::allocate(MemoryAddr address, SRAMAddress position, MemoryAccess
       if (!contains(address, position, mode)) {
         LOKI_LOG(2) << this->name() << " cache miss at address " << LOKI_HEX(address) << endl;
         TagData tag = metadata[getLine(position)];
-        Instrumentation::L1Cache::replaceCacheLine(id, tag.valid, tag.dirty);
+        Instrumentation::L1Cache::replaceCacheLine(id, getLine(position), tag.valid, tag.dirty);
 
         // Send a request for the missing cache line.
         // TODO: create a FetchLine request and let it do all the work.
@@ -157,7 +178,8 @@ void MemoryBank::validate(MemoryAddr address, SRAMAddress position, MemoryAccess
       bool inMainMemory = chip().backedByMainMemory(id.tile, address);
       if (inMainMemory) {
         MemoryAddr globalAddress = chip().getAddressTranslation(id.tile, address);
-        mainMemory->claimCacheLine(id, globalAddress);
+        cycle_count_t delay = mainMemory->claimCacheLine(id, globalAddress);
+        coherenceReady = std::max(coherenceReady, Instrumentation::currentCycle() + delay);
       }
 
       break;
@@ -283,6 +305,18 @@ bool MemoryBank::checkReservation(ComponentID requester, MemoryAddr address, Mem
 }
 
 void MemoryBank::writeWord(SRAMAddress position, uint32_t value, MemoryAccessMode mode, bool magic) {
+  // The first write to a clean line may need permission from the coherence
+  // directory. Magic writes (refills, debug) do not represent new data.
+  if (mode == MEMORY_CACHE && !magic && !metadata[getLine(position)].dirty
+      && mainMemory->coherent()) {
+    MemoryAddr address = metadata[getLine(position)].address;
+    if (chip().backedByMainMemory(id.tile, address)) {
+      MemoryAddr globalAddress = chip().getAddressTranslation(id.tile, address);
+      cycle_count_t delay = mainMemory->requestWritePermission(id, globalAddress);
+      coherenceReady = std::max(coherenceReady, Instrumentation::currentCycle() + delay);
+    }
+  }
+
   MemoryBase::writeWord(position, value, mode, magic);
 
   if (mode == MEMORY_CACHE)
@@ -300,6 +334,14 @@ bool MemoryBank::flushing(MemoryAddr address) const {
   return pendingFlushes.find(cacheLine) != pendingFlushes.end();
 }
 
+bool MemoryBank::holdsLine(MemoryAddr address) const {
+  return contains(address, computePosition(address), MEMORY_CACHE);
+}
+
+uint MemoryBank::occupancy() const {
+  return inputQueue.items() + (currentlyIdle ? 0 : 1);
+}
+
 uint MemoryBank::memoryIndex() const {
   return parent().memoryIndex(id);
 }
@@ -325,11 +367,27 @@ uint MemoryBank::globalCoreIndex(ComponentID core) const {
   return parent().globalCoreIndex(core);
 }
 
+void MemoryBank::countRequesterEvent(const MemoryOperation& request, bool hit) const {
+  // L2 requests have the requesting L1 bank's index as their destination, so
+  // may look like a core.
+  if (request.getMemoryLevel() != MEMORY_L1)
+    return;
+
+  ChannelID requester = request.getDestination();
+  if (isCore(requester))
+    chip().countCoreEvent(requester.component, hit ? ControlRegisters::EVENT_L1_HIT
+                                                   : ControlRegisters::EVENT_L1_MISS);
+}
+
 void MemoryBank::processIdle() {
   loki_assert_with_message(state == STATE_IDLE, "State = %d", state);
 
+  // Finish moving a store into the write buffer before anything else.
+  if (bufferedStore != NULL) {
+    completeBufferedStore();
+  }
   // Refills have priority because other requests may depend on them.
-  if (responseAvailable()) {
+  else if (responseAvailable()) {
     state = STATE_REFILL;
     cacheLineCursor = 0;
     next_trigger(sc_core::SC_ZERO_TIME);
@@ -343,6 +401,9 @@ void MemoryBank::processIdle() {
     // but it only needs to be called once.
     hitRequest = peekRequest();
 
+    if (writeBuffer.enabled() && serveFromWriteBuffer())
+      return;
+
     if (hitUnderMiss && (missRequest != NULL)) {
       // Don't reorder data being sent to the same channel.
       if (missRequest->getDestination() == hitRequest->getDestination())
@@ -379,18 +440,215 @@ void MemoryBank::processIdle() {
     }
 
     consumeRequest(hitRequest->getMemoryLevel());
+    countRequesterEvent(*hitRequest, hitRequest->inCache());
     state = STATE_REQUEST;
     next_trigger(sc_core::SC_ZERO_TIME);
 
     LOKI_LOG(2) << this->name() << " starting " << memoryOpName(hitRequest->getMetadata().opcode)
         << " request from component " << hitRequest->getDestination().component << endl;
   }
+  // Nothing else to do - use the spare cycle to drain the write buffer.
+  else if (!writeBuffer.empty() && canDrain(writeBuffer.oldest())) {
+    startDrain(writeBuffer.oldest(), true);
+  }
   // Nothing to do - wait for input to arrive.
   else {
     next_trigger(responseAvailableEvent() | requestAvailableEvent());
   }
 }
 
+// The number of bytes accessed by a single load or store.
+static uint accessBytes(MemoryOpcode opcode) {
+  switch (opcode) {
+    case LOAD_HW:
+    case STORE_HW:
+      return BYTES_PER_WORD/2;
+    case LOAD_B:
+    case STORE_B:
+      return 1;
+    default:
+      return BYTES_PER_WORD;
+  }
+}
+
+bool MemoryBank::serveFromWriteBuffer() {
+  // Scratchpad data and requests which bypass this cache never interact with
+  // buffered stores.
+  if (hitRequest->getAccessMode() != MEMORY_CACHE || hitRequest->needsForwarding())
+    return false;
+
+  MemoryAddr address = hitRequest->getAddress();
+
+  switch (hitRequest->getMetadata().opcode) {
+    case STORE_W:
+    case STORE_HW:
+    case STORE_B:
+      if (hitRequest->getMemoryLevel() == MEMORY_L1)
+        return bufferStore();
+      break;
+
+    case LOAD_W:
+    case LOAD_HW:
+    case LOAD_B:
+      return forwardLoad();
+
+    // Directory and DMA operations do not access cached data.
+    case UPDATE_DIRECTORY_ENTRY:
+    case UPDATE_DIRECTORY_MASK:
+    case DMA_COMMAND:
+      return false;
+
+    // Operations on every line must see all buffered data.
+    case FLUSH_ALL_LINES:
+    case INVALIDATE_ALL_LINES:
+      if (writeBuffer.empty())
+        return false;
+      startDrain(writeBuffer.oldest(), false);
+      return true;
+
+    // Instruction packets may continue into the next cache line.
+    case IPK_READ:
+      if (writeBuffer.holdsLine(address + cacheLineSize())) {
+        startDrain(address + cacheLineSize(), false);
+        return true;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  // Any other access to a buffered line must wait until the line is drained.
+  if (writeBuffer.holdsLine(address)) {
+    startDrain(address, false);
+    return true;
+  }
+  else
+    return false;
+}
+
+bool MemoryBank::bufferStore() {
+  MemoryAddr address = hitRequest->getAddress();
+  MemoryMetadata metadata = hitRequest->getMetadata();
+
+  // Wait for the payload so the store can complete in one go.
+  // +1 because we haven't dequeued the head flit yet.
+  if (inputQueue.items() < 1+hitRequest->payloadFlitsRemaining())
+    return true;
+
+  // Make space if necessary. A line which can't be coalesced with must be
+  // drained before the new data arrives, to keep the stores in order.
+  if (!writeBuffer.canAccept(address, metadata)) {
+    if (writeBuffer.holdsLine(address))
+      startDrain(address, false);
+    else
+      startDrain(writeBuffer.oldest(), false);
+    return true;
+  }
+
+  // The payload can't be read until next cycle.
+  consumeRequest(MEMORY_L1);
+  countRequesterEvent(*hitRequest, true);
+  bufferedStore = hitRequest;
+  hitRequest.reset();
+  next_trigger(iClock.posedge_event());
+  return true;
+}
+
+void MemoryBank::completeBufferedStore() {
+  loki_assert(bufferedStore != NULL);
+
+  if (!payloadAvailable(MEMORY_L1)) {
+    next_trigger(iClock.posedge_event());
+    return;
+  }
+
+  MemoryAddr address = bufferedStore->getAddress();
+  MemoryMetadata metadata = bufferedStore->getMetadata();
+  uint32_t data = getPayload(MEMORY_L1);
+
+  bool coalesced = writeBuffer.write(address, data,
+      accessBytes(metadata.opcode), metadata, bufferedStore->getDestination());
+  Instrumentation::WriteBuffer::store(coalesced, writeBuffer.occupancy());
+
+  LOKI_LOG(2) << this->name() << " buffered " << memoryOpName(metadata.opcode)
+      << " to " << LOKI_HEX(address) << endl;
+
+  bufferedStore.reset();
+  next_trigger(sc_core::SC_ZERO_TIME);
+}
+
+bool MemoryBank::forwardLoad() {
+  MemoryAddr address = hitRequest->getAddress();
+  uint bytes = accessBytes(hitRequest->getMetadata().opcode);
+
+  if (!writeBuffer.holdsLine(address))
+    return false;
+
+  if (!writeBuffer.covers(address, bytes)) {
+    if (startDrain(address, false))
+      Instrumentation::WriteBuffer::load(false);
+    return true;
+  }
+
+  ChannelID destination = hitRequest->getDestination();
+  MemoryLevel level = hitRequest->getMemoryLevel();
+
+  // Don't reorder data being sent to the same channel.
+  if (missRequest != NULL && missRequest->getDestination() == destination)
+    return true;
+
+  if (!canSendResponse(destination, level)) {
+    next_trigger(canSendResponseEvent(destination, level));
+    return true;
+  }
+
+  consumeRequest(level);
+  countRequesterEvent(*hitRequest, true);
+
+  NetworkResponse response(Word(writeBuffer.read(address, bytes)), destination, true);
+  sendResponse(response, level);
+  Instrumentation::Latency::memoryBufferedResult(id, *hitRequest, response,
+      true, level == MEMORY_L1);
+  Instrumentation::WriteBuffer::load(true);
+
+  LOKI_LOG(2) << this->name() << " forwarded " << memoryOpName(hitRequest->getMetadata().opcode)
+      << " from write buffer" << endl;
+
+  hitRequest.reset();
+  next_trigger(iClock.posedge_event());
+  return true;
+}
+
+bool MemoryBank::canDrain(MemoryAddr address) const {
+  if (missRequest == NULL)
+    return true;
+
+  // The same restrictions as for any hit-under-miss request: the drain must
+  // not touch the missing line, and must not miss itself.
+  return hitUnderMiss
+      && (getTag(missRequest->getAddress()) != getTag(address))
+      && contains(address, computePosition(address), MEMORY_CACHE);
+}
+
+bool MemoryBank::startDrain(MemoryAddr address, bool opportunistic) {
+  // Try again later.
+  if (!canDrain(address))
+    return false;
+
+  hitRequest.reset(new DrainWriteBuffer(writeBuffer.remove(address)));
+  hitRequest->assignToMemory(*this, MEMORY_L1);
+  Instrumentation::WriteBuffer::drain(opportunistic);
+
+  state = STATE_REQUEST;
+  next_trigger(sc_core::SC_ZERO_TIME);
+
+  LOKI_LOG(2) << this->name() << " draining write buffer line "
+      << LOKI_HEX(hitRequest->getAddress()) << endl;
+
+  return true;
+}
+
 void MemoryBank::processRequest(DecodedRequest& request) {
   loki_assert_with_message(state == STATE_REQUEST, "State = %d", state);
   loki_assert(request != NULL);
@@ -415,6 +673,10 @@ void MemoryBank::processRequest(DecodedRequest& request) {
   else if (!canRead() || !canWrite()) {  // Check for available memory bandwidth
     next_trigger(iClock.posedge_event());
   }
+  else if (Instrumentation::currentCycle() < coherenceReady) {
+    // Wait for other tiles to give up their copies of a line.
+    next_trigger(iClock.posedge_event());
+  }
   else if (!request->preconditionsMet()) {
     request->prepare();
   }
@@ -699,11 +961,20 @@ void MemoryBank::forwardRequest(DecodedRequest& request) {
   LOKI_LOG(2) << this->name() << " bypassed by request " << request << endl;
   NetworkRequest flit = request->toFlit();
 
-  if (!flit.channelID().isNullMapping())
+  if (!flit.channelID().isNullMapping()) {
+    // Requests which also bypass the L2 must still do so. Once past the L2,
+    // the bit has served its purpose.
+    bool skipL2 = flit.getMemoryMetadata().skipL2
+               && request->getMemoryLevel() == MEMORY_L1;
     flit = NetworkRequest(flit.payload(), id,
                           flit.getMemoryMetadata().opcode,
                           flit.getMetadata().endOfPacket);
 
+    MemoryMetadata metadata = flit.getMemoryMetadata();
+    metadata.skipL2 = skipL2;
+    flit.setMetadata(metadata.flatten());
+  }
+
   sendRequest(flit);
 }
 
@@ -854,9 +1125,34 @@ void MemoryBank::preWriteCheck(const MemoryOperation& operation) const {
   }
 }
 
+void MemoryBank::preExecuteCheck(const MemoryOperation& operation) const {
+  MemoryAddr globalAddress = chip().getAddressTranslation(id.tile, operation.getAddress());
+  bool scratchpad = operation.getAccessMode() == MEMORY_SCRATCHPAD;
+  bool inMainMemory = !scratchpad && chip().backedByMainMemory(id.tile, operation.getAddress());
+  if (inMainMemory && mainMemory->noExecute(globalAddress) && WARN_NO_EXECUTE) {
+    LOKI_WARN << this->name() << " fetching instructions from no-execute address" << endl;
+    LOKI_WARN << "  " << operation.toString() << endl;
+  }
+}
+
+bool MemoryBank::bypassesCaches(const MemoryOperation& operation) const {
+  // Only individual word accesses and atomics can be performed at main memory.
+  if (operation.getAccessMode() != MEMORY_CACHE ||
+      !MainMemory::nearMemoryOperation(operation.getMetadata().opcode))
+    return false;
+
+  if (!chip().backedByMainMemory(id.tile, operation.getAddress()))
+    return false;
+
+  MemoryAddr globalAddress = chip().getAddressTranslation(id.tile, operation.getAddress());
+  return mainMemory->uncached(globalAddress);
+}
+
 // Instrumentation only.
 void MemoryBank::coreRequestArrived() {
   Instrumentation::Latency::memoryReceivedRequest(id, inputQueue.lastDataWritten());
+  if (MemoryTrace::capturing())
+    MemoryTrace::requestArrived(id, inputQueue.lastDataWritten());
 }
 
 // Instrumentation only.
@@ -865,6 +1161,8 @@ void MemoryBank::coreDataSent() {
   if (ENERGY_TRACE)
     Instrumentation::Network::traffic(id, flit.channelID().component);
   Instrumentation::Latency::memorySentResult(id, flit, true);
+  if (MemoryTrace::capturing())
+    MemoryTrace::responseSent(flit);
 }
 
 // Instrumentation only.
@@ -873,6 +1171,8 @@ void MemoryBank::coreInstructionSent() {
   if (ENERGY_TRACE)
     Instrumentation::Network::traffic(id, flit.channelID().component);
   Instrumentation::Latency::memorySentResult(id, flit, true);
+  if (MemoryTrace::capturing())
+    MemoryTrace::responseSent(flit);
 }
 
 void MemoryBank::memoryRequestSent() {
@@ -949,6 +1249,7 @@ MemoryBank::MemoryBank(sc_module_name name, const ComponentID& ID, uint numBanks
   oResponse("oResponse"),
   hitUnderMiss(params.hitUnderMiss),
   log2NumBanks(log2(numBanks)),
+  setHash(params.setHash, params.setPermutation, log2NumBanks),
   inputQueue("inputQueue", params.inputFIFO),
   inResponseQueue("inResponseQueue", params.inputFIFO),
   outputDataQueue("outputDataQueue", params.outputFIFO, artificialDelayRequired(params)),
@@ -957,13 +1258,15 @@ MemoryBank::MemoryBank(sc_module_name name, const ComponentID& ID, uint numBanks
   outputRespQueue("outputRespQueue", params.outputFIFO, artificialDelayRequired(params)),
   data(params.size/BYTES_PER_WORD, 0),
   metadata(params.size/params.cacheLineSize),
-  reservations(1),
+  reservations(params.reservations),
+  writeBuffer(params.writeBuffer, params.cacheLineSize),
   missBuffer("mMissBuffer", params.cacheLineSize/BYTES_PER_WORD),
   cacheMissEvent(sc_core::sc_gen_unique_name("mCacheMissEvent")),
   l2RequestFilter("request_filter", *this)
 {
   state = STATE_IDLE;
   previousState = STATE_IDLE;
+  coherenceReady = 0;
 
   cacheLineCursor = 0;
 
@@ -1039,6 +1342,84 @@ void MemoryBank::end_of_elaboration() {
 MemoryBank::~MemoryBank() {
 }
 
+bool MemoryBank::recallCacheLine(MemoryAddr address, bool invalidate) {
+  // Buffered stores are newer than anything in the cache.
+  bool dirty = recallWriteBuffer(address);
+
+  // Tags hold tile-local addresses. Usually these match main memory addresses,
+  // so only one position needs checking. Otherwise search all tags.
+  if (chip().getAddressTranslation(id.tile, address) == address)
+    return recallCacheLine(getLine(computePosition(address)), address, invalidate) || dirty;
+
+  for (uint line=0; line<metadata.size(); line++)
+    dirty |= recallCacheLine(line, address, invalidate);
+  return dirty;
+}
+
+bool MemoryBank::recallCacheLine(uint line, MemoryAddr address, bool invalidate) {
+  TagData& tag = metadata[line];
+
+  if (!tag.valid || chip().getAddressTranslation(id.tile, tag.address) != address)
+    return false;
+
+  bool dirty = tag.dirty;
+  SRAMAddress position = line << log2CacheLineSize;
+
+  if (dirty) {
+    for (uint offset=0; offset<cacheLineSize(); offset+=BYTES_PER_WORD) {
+      uint32_t value = readWord(position + offset, MEMORY_CACHE, true);
+      mainMemory->writeWord(address + offset, value, MEMORY_SCRATCHPAD, true);
+    }
+    tag.dirty = false;
+  }
+
+  if (invalidate) {
+    tag.valid = false;
+    reservations.clearReservationRange(tag.address, tag.address + cacheLineSize());
+  }
+
+  return dirty;
+}
+
+bool MemoryBank::recallWriteBuffer(MemoryAddr address) {
+  bool found = false;
+  uint index = 0;
+
+  while (index < writeBuffer.occupancy()) {
+    MemoryAddr line = writeBuffer.entry(index).line;
+    if (chip().getAddressTranslation(id.tile, line) != address) {
+      index++;
+      continue;
+    }
+
+    WriteBuffer::Entry entry = writeBuffer.remove(line);
+    SRAMAddress position = computePosition(line);
+    bool cached = contains(line, position, MEMORY_CACHE);
+
+    for (uint word=0; word<entry.words(); word++) {
+      uint32_t mask = entry.mask(word);
+      if (mask == 0)
+        continue;
+
+      uint offset = word * BYTES_PER_WORD;
+      if (cached) {
+        uint32_t old = readWord(position + offset, MEMORY_CACHE, true);
+        writeWord(position + offset, (old & ~mask) | (entry.word(word) & mask),
+                  MEMORY_CACHE, true);
+      }
+      else {
+        uint32_t old = mainMemory->readWord(address + offset, MEMORY_SCRATCHPAD, true);
+        mainMemory->writeWord(address + offset, (old & ~mask) | (entry.word(word) & mask),
+                              MEMORY_SCRATCHPAD, true);
+      }
+    }
+
+    found = true;
+  }
+
+  return found;
+}
+
 void MemoryBank::setBackgroundMemory(MainMemory* memory) {
   assert(memory != NULL);
   mainMemory = memory;
@@ -1066,15 +1447,21 @@ Word MemoryBank::readWordDebug(MemoryAddr addr) {
 
   SRAMAddress position = getPosition(addr, MEMORY_CACHE);
 
+  uint32_t data;
   if (contains(addr, position, MEMORY_CACHE))
-    return readWord(position, MEMORY_CACHE, true);
+    data = readWord(position, MEMORY_CACHE, true);
   else
-    return mainMemory->readWord(addr, MEMORY_SCRATCHPAD, true);
+    data = mainMemory->readWord(addr, MEMORY_SCRATCHPAD, true);
+
+  return writeBuffer.merge(addr, data);
 }
 
 Word MemoryBank::readByteDebug(MemoryAddr addr) {
   loki_assert(mainMemory != NULL);
 
+  if (writeBuffer.covers(addr, 1))
+    return writeBuffer.read(addr, 1);
+
   SRAMAddress position = getPosition(addr, MEMORY_CACHE);
 
   if (contains(addr, position, MEMORY_CACHE))
@@ -1087,6 +1474,8 @@ void MemoryBank::writeWordDebug(MemoryAddr addr, Word data) {
   loki_assert(mainMemory != NULL);
   loki_assert_with_message(addr % BYTES_PER_WORD == 0, "Address = 0x%x", addr);
 
+  writeBuffer.update(addr, data.toUInt(), BYTES_PER_WORD);
+
   SRAMAddress position = getPosition(addr, MEMORY_CACHE);
 
   if (contains(addr, position, MEMORY_CACHE))
@@ -1098,6 +1487,8 @@ void MemoryBank::writeWordDebug(MemoryAddr addr, Word data) {
 void MemoryBank::writeByteDebug(MemoryAddr addr, Word data) {
   loki_assert(mainMemory != NULL);
 
+  writeBuffer.update(addr, data.toUInt(), 1);
+
   SRAMAddress position = getPosition(addr, MEMORY_CACHE);
 
   if (contains(addr, position, MEMORY_CACHE))
@@ -17,9 +17,11 @@
 
 #include <memory>
 #include <set>
+#include "../../Memory/AddressHash.h"
 #include "../../Memory/MemoryBase.h"
 #include "L2RequestFilter.h"
 #include "ReservationHandler.h"
+#include "WriteBuffer.h"
 #include "../../Network/FIFOs/DelayFIFO.h"
 #include "../../Network/FIFOs/NetworkFIFO.h"
 #include "../../Utility/BlockingInterface.h"
@@ -121,6 +123,9 @@ public:
   // Check whether it is safe for the given operation to modify memory.
   virtual void preWriteCheck(const MemoryOperation& operation) const;
 
+  // Check whether instructions may be fetched by the given operation.
+  virtual void preExecuteCheck(const MemoryOperation& operation) const;
+
   // Override writeWord so we can update metadata (valid, dirty, etc.).
   virtual void writeWord(SRAMAddress position, uint32_t data, MemoryAccessMode mode, bool magic=true);
 
@@ -130,6 +135,14 @@ public:
   // Determine whether we are currently flushing data from the given address.
   bool flushing(MemoryAddr address) const;
 
+  // Determine whether a valid copy of the given address is held in cache mode.
+  // A tag lookup with no side effects, used to model the tile's L2 tag
+  // directory.
+  bool holdsLine(MemoryAddr address) const;
+
+  // The number of requests queued or in progress at this bank.
+  uint occupancy() const;
+
   // Access data based on its position in the address space, and bypass the
   // usual tag checks.
   Word readWordDebug(MemoryAddr addr);
@@ -145,6 +158,10 @@ public:
 
   bool storedLocally(MemoryAddr address) const;
 
+  // Coherence: write back any dirty copy of the given main memory cache line,
+  // and optionally invalidate it. Returns whether any dirty data was found.
+  bool recallCacheLine(MemoryAddr address, bool invalidate);
+
   // The index of this memory bank, with the first bank being 0.
   uint memoryIndex() const;
   uint memoriesThisTile() const;
@@ -155,6 +172,14 @@ public:
   uint coresThisTile() const;
   uint globalCoreIndex(ComponentID core) const;
 
+  // Returns whether the operation accesses a page marked uncached, and should
+  // be performed at main memory rather than in any cache.
+  bool bypassesCaches(const MemoryOperation& operation) const;
+
+  // Update the performance counters of the core which sent a request. Only
+  // requests arriving directly from cores are counted.
+  void countRequesterEvent(const MemoryOperation& request, bool hit) const;
+
 private:
 
   typedef std::shared_ptr<MemoryOperation> DecodedRequest;
@@ -173,6 +198,41 @@ private:
   // will come back to it later.
   void finishedRequestForNow(DecodedRequest& request);
 
+  // getPosition for cache accesses, without instrumentation.
+  SRAMAddress computePosition(MemoryAddr address) const;
+
+  // The fixed mapping from addresses to positions. Index bits come from above
+  // the bank selection bits, and the bank bits are XORed into the upper index
+  // bits. Always used for scratchpad accesses, so a scratchpad region keeps a
+  // predictable layout.
+  SRAMAddress defaultPosition(MemoryAddr address) const;
+
+  // Perform a coherence recall on a single cache line.
+  bool recallCacheLine(uint line, MemoryAddr address, bool invalidate);
+
+  // Write any buffered stores to the given main memory cache line into the
+  // cache, or into main memory if the line is not cached. Returns whether any
+  // buffered data was found.
+  bool recallWriteBuffer(MemoryAddr address);
+
+  // Give the write buffer a chance to handle the request in `hitRequest`.
+  // Returns whether the request should not be started yet, either because it
+  // has already been completed, or because buffered data must be drained
+  // first.
+  bool serveFromWriteBuffer();
+  bool bufferStore();
+  bool forwardLoad();
+
+  // Move the payload of `bufferedStore` into the write buffer.
+  void completeBufferedStore();
+
+  // Determine whether a buffered line can be written to the cache now.
+  bool canDrain(MemoryAddr address) const;
+
+  // Begin writing the buffered line containing `address` into the cache.
+  // Returns false if the drain must wait until later.
+  bool startDrain(MemoryAddr address, bool opportunistic);
+
   bool requestAvailable() const;
   const sc_event_or_list& requestAvailableEvent() const;
   DecodedRequest peekRequest();
@@ -229,6 +289,9 @@ private:
   const bool hitUnderMiss;
   const size_t log2NumBanks;
 
+  // Mapping from cache lines to positions in the bank when in cache mode.
+  const AddressHash setHash;
+
   enum MemoryState {
     STATE_IDLE,                          // No active request
     STATE_REQUEST,                       // Serving active request
@@ -269,8 +332,14 @@ private:
   // we currently allow a hitting request and a missing request.
   DecodedRequest hitRequest, missRequest;
 
+  // A store whose head flit has been consumed, but whose payload has not yet
+  // been moved into the write buffer.
+  DecodedRequest bufferedStore;
+
   ReservationHandler    reservations;    // Data keeping track of current atomic transactions.
 
+  WriteBuffer           writeBuffer;     // Stores not yet written to the cache.
+
   unsigned int          cacheLineCursor; // Used to step through a cache line.
 
   FIFO<NetworkRequest>  missBuffer; // Payloads for a request which is currently missing.
@@ -278,6 +347,10 @@ private:
   bool                  copyingToMissBuffer;   // Tell whether the miss buffer needs filling.
   bool                  readingFromMissBuffer; // Tell whether the miss buffer needs emptying.
 
+  // Cycle at which other tiles will have acknowledged this bank's most recent
+  // coherence request. No further requests are served until then.
+  cycle_count_t         coherenceReady;
+
   sc_event              cacheMissEvent;  // Event triggered on each cache miss.
 
   // L2 requests are broadcast to all banks to allow high associativity. This
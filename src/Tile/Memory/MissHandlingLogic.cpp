@@ -90,6 +90,10 @@ void MissHandlingLogic::localRequestLoop() {
           handleDirectoryMaskUpdate(flit);
           break;
 
+        case DMA_COMMAND:
+          handleDMACommand(flit);
+          break;
+
         default:
           loki_assert_with_message(false,
               "Request type = %s", memoryOpName(requestHeader.getMemoryMetadata().opcode).c_str());
@@ -105,12 +109,14 @@ void MissHandlingLogic::localRequestLoop() {
       // or Skip L2 bit, we let the MemoryBank copy whichever bit is appropriate
       // into the Scratchpad bit. This bit is always overwritten when forwarding
       // the request.
+      // DMA commands always target this tile's DMA engine.
       MemoryOpcode op = flit.getMemoryMetadata().opcode;
       bool updateDirectory = (op == UPDATE_DIRECTORY_ENTRY ||
                               op == UPDATE_DIRECTORY_MASK)
                           && !flit.getMemoryMetadata().scratchpad;
+      bool dmaCommand = (op == DMA_COMMAND);
 
-      if (updateDirectory) {
+      if (updateDirectory || dmaCommand) {
         // Store the head flit and wait for the payload.
         requestHeader = flit;
         requestHeaderValid = true;
@@ -121,6 +127,17 @@ void MissHandlingLogic::localRequestLoop() {
         if (newLocalRequest) {
           flit = directory.updateRequest(flit);
 
+          // Requests for main memory go to the controller which owns the
+          // address, if memory is interleaved. Otherwise, the directory's
+          // choice of controller stands.
+          ChannelID destination = flit.channelID();
+          if (chip().memoryInterleaved() &&
+              chip().isMemoryController(destination.component.tile)) {
+            TileID controller = chip().memoryController(tile().id, flit.payload().toUInt());
+            flit.setChannelID(ChannelID(controller, destination.component.position,
+                                        destination.channel));
+          }
+
           // Save the network destination so it can be reused for all other
           // flits in the same packet.
           requestDestination = flit.channelID();
@@ -145,17 +162,28 @@ void MissHandlingLogic::handleDirectoryUpdate(const NetworkRequest& flit) {
   MemoryRequest request = static_cast<MemoryRequest>(flit.payload());
 
   MemoryAddr address = requestHeader.payload().toUInt();
-  unsigned int entry = directory.getEntry(address);
-  uint data = request.getPayload();
-
-  directory.setEntry(entry, data);
+  updateDirectoryEntry(address, request.getPayload());
 }
 
 void MissHandlingLogic::handleDirectoryMaskUpdate(const NetworkRequest& flit) {
   MemoryRequest request = static_cast<MemoryRequest>(flit.payload());
 
-  unsigned int maskLSB = request.getPayload();
+  updateDirectoryMask(request.getPayload());
+}
+
+void MissHandlingLogic::handleDMACommand(const NetworkRequest& flit) {
+  MemoryRequest request = static_cast<MemoryRequest>(flit.payload());
+
+  uint reg = requestHeader.payload().toUInt();
+  tile().dma.writeRegister(reg, request.getPayload());
+}
+
+void MissHandlingLogic::updateDirectoryEntry(MemoryAddr address, uint data) {
+  unsigned int entry = directory.getEntry(address);
+  directory.setEntry(entry, data);
+}
 
+void MissHandlingLogic::updateDirectoryMask(uint maskLSB) {
   directory.setBitmaskLSB(maskLSB);
 }
 
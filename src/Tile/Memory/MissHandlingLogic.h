@@ -5,6 +5,7 @@
  *  * Arbitrating between the memory banks
  *  * Directing flushed data to the appropriate location
  *  * Requesting new data from the appropriate location
+ *  * Passing commands on to the tile's DMA engine
  *
  *  Created on: 8 Oct 2014
  *      Author: db434
@@ -77,12 +78,19 @@ public:
   // Determine the address in main memory represented by the given address.
   MemoryAddr getAddressTranslation(MemoryAddr address) const;
 
+  // Set the directory entry used by the given address.
+  void updateDirectoryEntry(MemoryAddr address, uint data);
+
+  // Set which address bits are used to index the directory.
+  void updateDirectoryMask(uint maskLSB);
+
 private:
 
   // Process requests from the local memory banks.
   void localRequestLoop();
   void handleDirectoryUpdate(const NetworkRequest& flit);
   void handleDirectoryMaskUpdate(const NetworkRequest& flit);
+  void handleDMACommand(const NetworkRequest& flit);
 
   // The network address of the memory controller.
   TileID nearestMemoryController() const;
@@ -6,54 +6,122 @@
  */
 
 #include "ReservationHandler.h"
+#include "../../Utility/Instrumentation/Reservations.h"
+
+#include <algorithm>
+#include <assert.h>
 
 void ReservationHandler::makeReservation(ComponentID requester, MemoryAddr address, SRAMAddress position) {
-  // Determine which reservation slot to write into. First look for a free slot.
-  // If there are none, use the slot next to the one used previously.
-  for (uint i=0; i<reservations.size(); i++) {
-    currentSlot = (currentSlot + 1) % reservations.size();
-    if (reservations[currentSlot].valid)
-      break;
-  }
+  uint id = key(requester);
+  SRAMAddress word = position & ~0x3;
+
+  // A requester only holds one reservation at a time, so a new one replaces
+  // the old.
+  auto existing = reservations.find(id);
+  if (existing != reservations.end() && existing->second.status == RESERVED)
+    release(id, existing->second, CONFLICT);
+  else if (maxReservations > 0 && numValid >= maxReservations)
+    evictOldest();
 
-  reservations[currentSlot].requester = requester;
-  reservations[currentSlot].address = address;
-  reservations[currentSlot].position = position;
-  reservations[currentSlot].valid = true;
+  Reservation& reservation = reservations[id];
+  reservation.address = address;
+  reservation.position = word;
+  reservation.status = RESERVED;
+  reservation.age = numMade++;
+
+  lines[line(word)].push_back(id);
+  numValid++;
+
+  Instrumentation::Reservations::reserve();
 }
 
 bool ReservationHandler::checkReservation(ComponentID requester, MemoryAddr address) const {
-  for (uint i=0; i<reservations.size(); i++) {
-    if (reservations[i].requester == requester &&
-        reservations[i].address == address &&
-        reservations[i].valid)
-      return true;
+  auto it = reservations.find(key(requester));
+  bool sameAddress = (it != reservations.end()) && (it->second.address == address);
+
+  if (sameAddress && it->second.status == RESERVED) {
+    Instrumentation::Reservations::check(Instrumentation::Reservations::SUCCESS);
+    return true;
   }
+  else if (sameAddress && it->second.status == EVICTED)
+    Instrumentation::Reservations::check(Instrumentation::Reservations::FAIL_EVICTED);
+  else if (sameAddress && it->second.status == CONFLICT)
+    Instrumentation::Reservations::check(Instrumentation::Reservations::FAIL_CONFLICT);
+  else
+    Instrumentation::Reservations::check(Instrumentation::Reservations::FAIL_NO_RESERVATION);
 
   return false;
 }
 
 void ReservationHandler::clearReservation(SRAMAddress address) {
   SRAMAddress word = address & ~0x3; // Mask to invalidate the whole word
-  for (uint i=0; i<reservations.size(); i++) {
-    if (reservations[i].position == word)
-      reservations[i].valid = false;
+
+  auto it = lines.find(line(word));
+  if (it == lines.end())
+    return;
+
+  // Copy the list of requesters: releasing a reservation modifies it.
+  std::vector<uint> requesters = it->second;
+  for (uint i=0; i<requesters.size(); i++) {
+    Reservation& reservation = reservations[requesters[i]];
+    if (reservation.position == word)
+      release(requesters[i], reservation, CONFLICT);
   }
 }
 
 void ReservationHandler::clearReservationRange(MemoryAddr start, MemoryAddr end) {
-  for (uint i=0; i<reservations.size(); i++) {
-    if ((reservations[i].address >= start) && (reservations[i].address < end))
-      reservations[i].valid = false;
+  // Only used when whole cache lines are invalidated, so is rare enough to
+  // search all reservations.
+  for (auto it = reservations.begin(); it != reservations.end(); ++it) {
+    Reservation& reservation = it->second;
+    if ((reservation.status == RESERVED) &&
+        (reservation.address >= start) && (reservation.address < end))
+      release(it->first, reservation, CONFLICT);
   }
 }
 
+uint ReservationHandler::key(const ComponentID& requester) {
+  return (requester.tile.x << 16) | (requester.tile.y << 8) | requester.position;
+}
+
+SRAMAddress ReservationHandler::line(SRAMAddress position) {
+  return position / CACHE_LINE_BYTES;
+}
+
+void ReservationHandler::release(uint requester, Reservation& reservation, Status status) {
+  assert(reservation.status == RESERVED);
+
+  std::vector<uint>& holders = lines[line(reservation.position)];
+  holders.erase(std::find(holders.begin(), holders.end(), requester));
+  if (holders.empty())
+    lines.erase(line(reservation.position));
+
+  reservation.status = status;
+  numValid--;
+}
+
+void ReservationHandler::evictOldest() {
+  auto oldest = reservations.end();
+
+  for (auto it = reservations.begin(); it != reservations.end(); ++it) {
+    if (it->second.status != RESERVED)
+      continue;
+    if (oldest == reservations.end() || it->second.age < oldest->second.age)
+      oldest = it;
+  }
+
+  assert(oldest != reservations.end());
+  release(oldest->first, oldest->second, EVICTED);
+
+  Instrumentation::Reservations::evict();
+}
+
 ReservationHandler::ReservationHandler(uint maxReservations) :
-    reservations(maxReservations) {
-  currentSlot = 0;
+    maxReservations(maxReservations) {
+  numValid = 0;
+  numMade = 0;
 }
 
 ReservationHandler::~ReservationHandler() {
   // Do nothing
 }
-
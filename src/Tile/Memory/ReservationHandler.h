@@ -7,8 +7,15 @@
  * effect if the address to which they are storing is still reserved. Any
  * conflicting operation (e.g. overwriting the data) clears the reservation.
  *
- * In the case that more reservations are made than can be handled
- * simultaneously, reservations are overwritten in a roughly-FIFO order.
+ * Each requester holds at most one reservation, as with a hardware link
+ * register, so contending requesters cannot displace each other's
+ * reservations. Reservations are indexed by cache line so that writes only
+ * need to examine reservations on the line they modify, and only a write to
+ * the reserved word clears a reservation.
+ *
+ * Optionally, the total number of reservations held can be capped. When full,
+ * the oldest reservation is evicted, and any store-conditional which fails as
+ * a result is recorded as a spurious failure.
  *
  *  Created on: 7 May 2015
  *      Author: db434
@@ -17,6 +24,8 @@
 #ifndef SRC_TILE_MEMORY_RESERVATIONHANDLER_H_
 #define SRC_TILE_MEMORY_RESERVATIONHANDLER_H_
 
+#include <unordered_map>
+#include <vector>
 #include "../../Datatype/Identifier.h"
 #include "../../Memory/MemoryTypes.h"
 
@@ -38,24 +47,47 @@ public:
   void clearReservationRange(MemoryAddr start, MemoryAddr end);
 
 public:
+
+  // maxReservations = 0 allows one reservation for every requester.
   ReservationHandler(uint maxReservations);
   virtual ~ReservationHandler();
 
 private:
 
+  enum Status {
+    RESERVED,   // Reservation is valid
+    CONFLICT,   // Data was modified or invalidated
+    EVICTED     // Displaced to make room for another reservation
+  };
+
   // The requesting component and the memory address together form the "tag" for
   // a reservation. Both of these must match for a reservation to be valid.
-  // The position in the SRAM is also included, as this will alias more often,
-  // resulting in invalidated reservations.
+  // The position in the SRAM is used to detect conflicting writes.
   struct Reservation {
-    ComponentID requester;
     MemoryAddr  address;
     SRAMAddress position;
-    bool        valid;
+    Status      status;
+    uint64_t    age;      // Order in which reservations were made
   };
 
-  std::vector<Reservation> reservations;
-  uint currentSlot;
+  static uint key(const ComponentID& requester);
+  static SRAMAddress line(SRAMAddress position);
+
+  // Remove a reservation from the line index, and change its status.
+  void release(uint requester, Reservation& reservation, Status status);
+
+  // Evict the oldest valid reservation.
+  void evictOldest();
+
+  // The most recent reservation of each requester, valid or not.
+  std::unordered_map<uint, Reservation> reservations;
+
+  // Requesters holding valid reservations on each cache line of the SRAM.
+  std::unordered_map<SRAMAddress, std::vector<uint>> lines;
+
+  const uint maxReservations;
+  uint       numValid;
+  uint64_t   numMade;
 };
 
 #endif /* SRC_TILE_MEMORY_RESERVATIONHANDLER_H_ */
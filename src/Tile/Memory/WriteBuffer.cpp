@@ -0,0 +1,179 @@
+/*
+ * WriteBuffer.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "WriteBuffer.h"
+
+#include <assert.h>
+
+uint WriteBuffer::Entry::words() const {
+  return data.size() / BYTES_PER_WORD;
+}
+
+uint32_t WriteBuffer::Entry::word(uint index) const {
+  uint32_t result = 0;
+  for (uint byte=0; byte<BYTES_PER_WORD; byte++)
+    result |= (uint32_t)data[index*BYTES_PER_WORD + byte] << (byte * 8);
+  return result;
+}
+
+uint32_t WriteBuffer::Entry::mask(uint index) const {
+  uint32_t result = 0;
+  for (uint byte=0; byte<BYTES_PER_WORD; byte++)
+    if ((valid >> (index*BYTES_PER_WORD + byte)) & 1)
+      result |= 0xFFU << (byte * 8);
+  return result;
+}
+
+bool WriteBuffer::Entry::complete() const {
+  uint64_t all = (data.size() == 64) ? ~0ULL : ((1ULL << data.size()) - 1);
+  return valid == all;
+}
+
+WriteBuffer::WriteBuffer(uint entries, uint lineBytes) :
+    capacity(entries),
+    lineBytes(lineBytes) {
+  // One bit of `valid` per byte.
+  assert(lineBytes <= 64);
+}
+
+bool WriteBuffer::enabled() const {
+  return capacity > 0;
+}
+
+bool WriteBuffer::empty() const {
+  return entries.empty();
+}
+
+bool WriteBuffer::full() const {
+  return entries.size() >= capacity;
+}
+
+uint WriteBuffer::occupancy() const {
+  return entries.size();
+}
+
+bool WriteBuffer::holdsLine(MemoryAddr address) const {
+  return find(address) >= 0;
+}
+
+bool WriteBuffer::canAccept(MemoryAddr address, MemoryMetadata metadata) const {
+  int index = find(address);
+  if (index < 0)
+    return !full();
+  else
+    return entries[index].metadata.skipL2 == metadata.skipL2;
+}
+
+bool WriteBuffer::write(MemoryAddr address, uint32_t value, uint bytes,
+                        MemoryMetadata metadata, ChannelID returnAddress) {
+  assert(canAccept(address, metadata));
+
+  int index = find(address);
+  bool coalesced = (index >= 0);
+
+  if (!coalesced) {
+    Entry newEntry;
+    newEntry.line = lineAddress(address);
+    newEntry.metadata = metadata;
+    newEntry.returnAddress = returnAddress;
+    newEntry.data.assign(lineBytes, 0);
+    newEntry.valid = 0;
+    entries.push_back(newEntry);
+    index = entries.size() - 1;
+  }
+
+  Entry& target = entries[index];
+  uint offset = address - target.line;
+  assert(offset + bytes <= lineBytes);
+
+  for (uint byte=0; byte<bytes; byte++) {
+    target.data[offset + byte] = (value >> (byte * 8)) & 0xFF;
+    target.valid |= 1ULL << (offset + byte);
+  }
+
+  return coalesced;
+}
+
+bool WriteBuffer::covers(MemoryAddr address, uint bytes) const {
+  int index = find(address);
+  if (index < 0)
+    return false;
+
+  const Entry& target = entries[index];
+  uint offset = address - target.line;
+  for (uint byte=0; byte<bytes; byte++)
+    if (!((target.valid >> (offset + byte)) & 1))
+      return false;
+
+  return true;
+}
+
+uint32_t WriteBuffer::read(MemoryAddr address, uint bytes) const {
+  assert(covers(address, bytes));
+
+  const Entry& target = entries[find(address)];
+  uint offset = address - target.line;
+
+  uint32_t result = 0;
+  for (uint byte=0; byte<bytes; byte++)
+    result |= (uint32_t)target.data[offset + byte] << (byte * 8);
+  return result;
+}
+
+uint32_t WriteBuffer::merge(MemoryAddr address, uint32_t word) const {
+  int index = find(address);
+  if (index < 0)
+    return word;
+
+  const Entry& target = entries[index];
+  uint wordIndex = (address - target.line) / BYTES_PER_WORD;
+  uint32_t mask = target.mask(wordIndex);
+  return (word & ~mask) | (target.word(wordIndex) & mask);
+}
+
+void WriteBuffer::update(MemoryAddr address, uint32_t value, uint bytes) {
+  int index = find(address);
+  if (index < 0)
+    return;
+
+  Entry& target = entries[index];
+  uint offset = address - target.line;
+  for (uint byte=0; byte<bytes; byte++)
+    if ((target.valid >> (offset + byte)) & 1)
+      target.data[offset + byte] = (value >> (byte * 8)) & 0xFF;
+}
+
+const WriteBuffer::Entry& WriteBuffer::entry(uint index) const {
+  assert(index < entries.size());
+  return entries[index];
+}
+
+MemoryAddr WriteBuffer::oldest() const {
+  assert(!empty());
+  return entries.front().line;
+}
+
+WriteBuffer::Entry WriteBuffer::remove(MemoryAddr address) {
+  int index = find(address);
+  assert(index >= 0);
+
+  Entry result = entries[index];
+  entries.erase(entries.begin() + index);
+  return result;
+}
+
+int WriteBuffer::find(MemoryAddr address) const {
+  MemoryAddr line = lineAddress(address);
+  for (uint i=0; i<entries.size(); i++)
+    if (entries[i].line == line)
+      return i;
+  return -1;
+}
+
+MemoryAddr WriteBuffer::lineAddress(MemoryAddr address) const {
+  return address & ~(MemoryAddr)(lineBytes - 1);
+}
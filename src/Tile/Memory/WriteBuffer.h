@@ -0,0 +1,136 @@
+/*
+ * WriteBuffer.h
+ *
+ * Stores waiting to be written into a memory bank.
+ *
+ * Stores complete as soon as they are added to the buffer. Stores to the same
+ * cache line are coalesced into a single entry, which is later written to the
+ * cache in one operation. Loads may read buffered data if every byte they need
+ * is present.
+ *
+ * Entries are kept in the order in which they were created, so the oldest line
+ * can be drained first.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_TILE_MEMORY_WRITEBUFFER_H_
+#define SRC_TILE_MEMORY_WRITEBUFFER_H_
+
+#include <deque>
+#include <vector>
+#include "../../Datatype/Flit.h"
+#include "../../Datatype/Identifier.h"
+#include "../../Memory/MemoryTypes.h"
+
+class WriteBuffer {
+
+//============================================================================//
+// Local types
+//============================================================================//
+
+public:
+
+  // All buffered data for one cache line.
+  struct Entry {
+    MemoryAddr            line;          // Address of first byte in line
+    MemoryMetadata        metadata;      // Taken from the first store
+    ChannelID             returnAddress; // Taken from the first store
+    std::vector<uint8_t>  data;          // One element per byte of the line
+    uint64_t              valid;         // One bit per byte of the line
+
+    // The number of words in the cache line.
+    uint words() const;
+
+    // Buffered data for word `index` of the line. Bytes which have not been
+    // written are zero.
+    uint32_t word(uint index) const;
+
+    // A mask selecting the bytes of word `index` which have been written.
+    uint32_t mask(uint index) const;
+
+    // Has every byte of the line been written?
+    bool complete() const;
+  };
+
+//============================================================================//
+// Constructors and destructors
+//============================================================================//
+
+public:
+
+  WriteBuffer(uint entries, uint lineBytes);
+
+//============================================================================//
+// Methods
+//============================================================================//
+
+public:
+
+  // A write buffer with no entries is disabled.
+  bool enabled() const;
+  bool empty() const;
+  bool full() const;
+
+  // The number of cache lines currently buffered.
+  uint occupancy() const;
+
+  // Return whether there is buffered data for the line containing `address`.
+  bool holdsLine(MemoryAddr address) const;
+
+  // Return whether a store to `address` can be added without first draining an
+  // entry. Stores are only coalesced if they agree on how the line is to be
+  // treated further down the memory hierarchy.
+  bool canAccept(MemoryAddr address, MemoryMetadata metadata) const;
+
+  // Add a store of `bytes` bytes to the buffer. `value` holds the data in its
+  // least significant bits. Returns whether the store was coalesced into an
+  // existing entry.
+  bool write(MemoryAddr address, uint32_t value, uint bytes,
+             MemoryMetadata metadata, ChannelID returnAddress);
+
+  // Return whether every byte of an access is buffered.
+  bool covers(MemoryAddr address, uint bytes) const;
+
+  // Read `bytes` bytes of buffered data. All must be present.
+  uint32_t read(MemoryAddr address, uint bytes) const;
+
+  // Replace any bytes of the word at `address` which are buffered.
+  uint32_t merge(MemoryAddr address, uint32_t word) const;
+
+  // Overwrite buffered bytes in the given range, but do not add any new ones.
+  // Used by accesses which bypass the buffer, so that stale data is not later
+  // written over them.
+  void update(MemoryAddr address, uint32_t value, uint bytes);
+
+  // Access the entry at position `index`, where 0 is the oldest.
+  const Entry& entry(uint index) const;
+
+  // The address of the oldest buffered line.
+  MemoryAddr oldest() const;
+
+  // Remove and return the entry holding data for the line containing `address`.
+  Entry remove(MemoryAddr address);
+
+private:
+
+  // Position of the entry holding `address`, or -1 if there is none.
+  int find(MemoryAddr address) const;
+
+  MemoryAddr lineAddress(MemoryAddr address) const;
+
+//============================================================================//
+// Local state
+//============================================================================//
+
+private:
+
+  const uint capacity;
+  const uint lineBytes;
+
+  std::deque<Entry> entries;
+
+};
+
+#endif /* SRC_TILE_MEMORY_WRITEBUFFER_H_ */
@@ -6,10 +6,12 @@
  */
 
 #include "MemoryControllerTile.h"
+#include "../Chip.h"
 #include "../Utility/Assert.h"
 #include "../Utility/Instrumentation/Network.h"
 
-MemoryControllerTile::MemoryControllerTile(const sc_module_name& name, const TileID id) :
+MemoryControllerTile::MemoryControllerTile(const sc_module_name& name, const TileID id,
+                                           const main_memory_parameters_t& params) :
     Tile(name, id),
     oRequestToMainMemory("oRequestToMainMemory"),
     iResponseFromMainMemory("iResponseFromMainMemory"),
@@ -32,20 +34,36 @@ MemoryControllerTile::MemoryControllerTile(const sc_module_name& name, const Til
 
   iResponse(responseDeadEnd);
   // Write to oResponse directly.
+
+  if (params.llc.size > 0) {
+    llc.reset(new LastLevelCache("llc", ComponentID(id, 0), params, chip().mainMemory));
+    llc->iClock(clock);
+    llc->iRequest(incomingRequests);
+    llc->oMemoryRequest(oRequestToMainMemory);
+    llc->iMemoryResponse(iResponseFromMainMemory);
+  }
 }
 
 MemoryControllerTile::~MemoryControllerTile() {
   // Nothing
 }
 
+void MemoryControllerTile::invalidateCachedLine(MemoryAddr address) {
+  if (llc)
+    llc->invalidateLine(address);
+}
+
 void MemoryControllerTile::end_of_elaboration() {
-  // Register methods to deal with input/output.
-  SC_METHOD(requestLoop);
-  sensitive << incomingRequests.canReadEvent();
-  dont_initialize();
+  // Register methods to deal with input/output. If there is a cache, it
+  // handles all requests itself.
+  if (!llc) {
+    SC_METHOD(requestLoop);
+    sensitive << incomingRequests.canReadEvent();
+    dont_initialize();
+  }
 
   SC_METHOD(responseLoop);
-  sensitive << iResponseFromMainMemory->canReadEvent();
+  sensitive << responses()->canReadEvent();
   dont_initialize();
 }
 
@@ -68,13 +86,17 @@ void MemoryControllerTile::responseLoop() {
   if (!oResponse->canWrite()) {
     next_trigger(oResponse->canWriteEvent());
   }
-  else if (iResponseFromMainMemory->canRead()) {
-    Flit<Word> flit = iResponseFromMainMemory->read();
+  else if (responses()->canRead()) {
+    Flit<Word> flit = responses()->read();
 
-    LOKI_LOG(3) << this->name() << " forwarding response from main memory: "
-        << flit << endl;
+    LOKI_LOG(3) << this->name() << " forwarding response from "
+        << (llc ? "last-level cache: " : "main memory: ") << flit << endl;
 
     oResponse->write(flit);
   }
   // Default trigger: new data to send
 }
+
+sc_port<network_source_ifc<Word>>& MemoryControllerTile::responses() {
+  return llc ? llc->oResponse : iResponseFromMainMemory;
+}
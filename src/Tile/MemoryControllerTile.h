@@ -10,7 +10,9 @@
 #ifndef SRC_TILE_MEMORYCONTROLLERTILE_H_
 #define SRC_TILE_MEMORYCONTROLLERTILE_H_
 
+#include <memory>
 #include "Tile.h"
+#include "Memory/LastLevelCache.h"
 #include "../Network/Global/NetworkDeadEnd.h"
 #include "../Network/NetworkChannel.h"
 
@@ -53,13 +55,20 @@ public:
 public:
 
   SC_HAS_PROCESS(MemoryControllerTile);
-  MemoryControllerTile(const sc_module_name& name, const TileID id);
+  MemoryControllerTile(const sc_module_name& name, const TileID id,
+                       const main_memory_parameters_t& params);
   virtual ~MemoryControllerTile();
 
 //============================================================================//
 // Methods
 //============================================================================//
 
+public:
+
+  // Discard any copy of the given cache line held in this tile's last-level
+  // cache.
+  void invalidateCachedLine(MemoryAddr address);
+
 private:
 
   // Extra initialisation once all ports have been bound.
@@ -71,6 +80,9 @@ private:
   // Pass responses back to the on-chip network.
   void responseLoop();
 
+  // The source of responses: either main memory or the last-level cache.
+  sc_port<network_source_ifc<Word>>& responses();
+
 //============================================================================//
 // Local state
 //============================================================================//
@@ -88,6 +100,12 @@ private:
   NetworkDeadEnd<Word> requestDeadEnd;
   NetworkDeadEnd<Word> responseDeadEnd;
 
+  // Optional cache in front of main memory. If this is not present, requests
+  // are sent straight to main memory.
+  std::unique_ptr<LastLevelCache> llc;
+
+  friend class LastLevelCache;
+
 };
 
 #endif /* SRC_TILE_MEMORYCONTROLLERTILE_H_ */
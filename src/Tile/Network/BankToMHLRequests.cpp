@@ -9,7 +9,7 @@
 
 BankToMHLRequests::BankToMHLRequests(const sc_module_name name,
                                      const tile_parameters_t& params) :
-    Network<Word>(name, params.numMemories, 1) {
+    Network<Word>(name, params.numMemories + 1, 1) {
 
   // Nothing
 
@@ -2,7 +2,7 @@
  * BankToMHLRequests.h
  *
  * Simple network connecting all banks of a tile with the miss handling logic
- * of the same tile.
+ * of the same tile. The DMA engine's requests use the final input.
  *
  *  Created on: 3 Apr 2019
  *      Author: db434
@@ -25,7 +25,7 @@ public:
 //
 //  ClockInput clock;
 //
-//  LokiVector<InPort> inputs;    // One per memory
+//  LokiVector<InPort> inputs;    // One per memory + DMA engine
 //  LokiVector<OutPort> outputs;  // Only one port
 
 //============================================================================//
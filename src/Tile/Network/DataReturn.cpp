@@ -15,7 +15,7 @@
 
 DataReturn::DataReturn(const sc_module_name name,
                        const tile_parameters_t& params) :
-    Network<Word>(name, params.numMemories + 1,
+    Network<Word>(name, params.numMemories + 2,
         params.numCores * params.core.numInputChannels),
     outputsPerCore(params.core.numInputChannels),
     outputCores(params.numCores) {
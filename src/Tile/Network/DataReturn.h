@@ -2,8 +2,8 @@
  * DataReturn.h
  *
  * Network returning data from memory banks to cores.
- * A final input is provided for data returning from the core-to-core data
- * network.
+ * An input after the banks carries DMA completion notifications, and a final
+ * input is provided for data returning from the core-to-core data network.
  *
  *  Created on: 13 Dec 2016
  *      Author: db434
@@ -26,7 +26,7 @@ public:
 //
 //  ClockInput clock;
 //
-//  LokiVector<InPort> inputs;    // One per memory + 1
+//  LokiVector<InPort> inputs;    // One per memory + 2
 //  LokiVector<OutPort> outputs;  // One per core input buffer
 //                                // Numbered core*(buffers per core) + buffer
 
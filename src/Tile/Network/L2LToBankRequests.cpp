@@ -15,9 +15,14 @@ L2LToBankRequests::L2LToBankRequests(sc_module_name name, uint numBanks) :
   // Pretend we have finished a request (allows some more-aggressive
   // assertions).
   numResponses = numBanks;
+  numExpected = numBanks;
   hit = false;
   consumed = true;
   target = -1;
+  isDirected = false;
+
+  for (uint i=0; i<numBanks; i++)
+    newRequestEvent.push_back(new sc_event());
 
 }
 
@@ -41,6 +46,11 @@ MemoryIndex L2LToBankRequests::targetBank() const {
   return target;
 }
 
+// Returns whether the request was sent only to the target bank.
+bool L2LToBankRequests::directed() const {
+  return isDirected;
+}
+
 // Notify of a cache hit.
 void L2LToBankRequests::cacheHit() {
   loki_assert_with_message(!hit, "Two cache hits for same request", 0);
@@ -58,7 +68,7 @@ void L2LToBankRequests::cacheMiss() {
 // If the target bank has a cache miss, it is only allowed to begin a request
 // once all banks have responded.
 bool L2LToBankRequests::allResponsesReceived() const {
-  return (numResponses == numBanks);
+  return (numResponses == numExpected);
 }
 
 const sc_event& L2LToBankRequests::allResponsesReceivedEvent() const {
@@ -70,9 +80,11 @@ bool L2LToBankRequests::associativeHit() const {
   return hit;
 }
 
-// Event triggered when the first flit of a new request arrives.
-const sc_event& L2LToBankRequests::newRequestArrived() const {
-  return newRequestEvent;
+// Event triggered when the first flit of a new request for the given bank
+// arrives.
+const sc_event& L2LToBankRequests::newRequestArrived(MemoryIndex bank) const {
+  loki_assert(bank < numBanks);
+  return newRequestEvent[bank];
 }
 
 // Event triggered whenever any flit arrives.
@@ -81,17 +93,25 @@ const sc_event& L2LToBankRequests::newFlitArrived() const {
 }
 
 // Clear any state and begin a new request.
-void L2LToBankRequests::newRequest(NetworkRequest request, MemoryIndex targetBank) {
+void L2LToBankRequests::newRequest(NetworkRequest request, MemoryIndex targetBank,
+                                   bool directed) {
   loki_assert(allResponsesReceived());
   loki_assert(targetBank < numBanks);
 
   numResponses = 0;
+  numExpected = directed ? 1 : numBanks;
   hit = false;
   consumed = false;
   flit = request;
   target = targetBank;
+  isDirected = directed;
+
+  if (directed)
+    newRequestEvent[targetBank].notify(sc_core::SC_ZERO_TIME);
+  else
+    for (uint i=0; i<numBanks; i++)
+      newRequestEvent[i].notify(sc_core::SC_ZERO_TIME);
 
-  newRequestEvent.notify(sc_core::SC_ZERO_TIME);
   newFlitEvent.notify(sc_core::SC_ZERO_TIME);
 }
 
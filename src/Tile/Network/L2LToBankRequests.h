@@ -4,6 +4,10 @@
  * Network allowing all memory banks in a tile to coordinate ownership of an
  * associative L2 memory request.
  *
+ * A request may instead be directed at a single bank, if it is already known
+ * which bank should serve it. Only that bank sees the request, and only that
+ * bank needs to respond.
+ *
  *  Created on: 3 Apr 2019
  *      Author: db434
  */
@@ -13,6 +17,7 @@
 
 #include "../../LokiComponent.h"
 #include "../../Network/NetworkTypes.h"
+#include "../../Utility/LokiVector.h"
 
 using sc_core::sc_event;
 using sc_core::sc_interface;
@@ -29,6 +34,10 @@ public:
   // The bank responsible for handling this request if all banks miss.
   virtual MemoryIndex targetBank() const = 0;
 
+  // Returns whether the request was sent only to the target bank. If so, the
+  // target bank must serve it.
+  virtual bool directed() const = 0;
+
   // Notify of a cache hit.
   virtual void cacheHit() = 0;
 
@@ -44,8 +53,9 @@ public:
   virtual bool allResponsesReceived() const = 0;
   virtual const sc_event& allResponsesReceivedEvent() const = 0;
 
-  // Event triggered when the first flit of a new request arrives.
-  virtual const sc_event& newRequestArrived() const = 0;
+  // Event triggered when the first flit of a new request for the given bank
+  // arrives.
+  virtual const sc_event& newRequestArrived(MemoryIndex bank) const = 0;
 
   // Event triggered whenever any flit arrives.
   virtual const sc_event& newFlitArrived() const = 0;
@@ -57,8 +67,10 @@ class l2_request_l2l_ifc : virtual public sc_interface {
 
 public:
 
-  // Clear any state and begin a new request.
-  virtual void newRequest(NetworkRequest flit, MemoryIndex targetBank) = 0;
+  // Clear any state and begin a new request. If `directed` is set, only the
+  // target bank sees the request.
+  virtual void newRequest(NetworkRequest flit, MemoryIndex targetBank,
+                          bool directed) = 0;
 
   // Supply a new flit for an existing request.
   virtual void newPayload(NetworkRequest flit) = 0;
@@ -94,6 +106,9 @@ public:
   // The bank responsible for handling this request if all banks miss.
   virtual MemoryIndex targetBank() const;
 
+  // Returns whether the request was sent only to the target bank.
+  virtual bool directed() const;
+
   // Notify of a cache hit.
   virtual void cacheHit();
 
@@ -109,14 +124,16 @@ public:
   // Returns whether one of the banks had a cache hit.
   virtual bool associativeHit() const;
 
-  // Event triggered when the first flit of a new request arrives.
-  virtual const sc_event& newRequestArrived() const;
+  // Event triggered when the first flit of a new request for the given bank
+  // arrives.
+  virtual const sc_event& newRequestArrived(MemoryIndex bank) const;
 
   // Event triggered whenever any flit arrives.
   virtual const sc_event& newFlitArrived() const;
 
   // Clear any state and begin a new request.
-  virtual void newRequest(NetworkRequest flit, MemoryIndex targetBank);
+  virtual void newRequest(NetworkRequest flit, MemoryIndex targetBank,
+                          bool directed);
 
   // Supply a new flit for an existing request.
   virtual void newPayload(NetworkRequest flit);
@@ -139,9 +156,10 @@ private:
   // The number of memory banks connected to this network.
   const uint numBanks;
 
-  // The number of responses received for the current request. All banks must
-  // respond to a request before a new one can begin.
+  // The number of responses received for the current request. All banks which
+  // saw the request must respond before a new one can begin.
   uint numResponses;
+  uint numExpected;
 
   // Has any bank had a cache hit?
   bool hit;
@@ -155,11 +173,15 @@ private:
   // The target bank for the current request.
   MemoryIndex target;
 
+  // Whether the current request was sent only to the target bank.
+  bool isDirected;
+
   // Event triggered once all banks have responded.
   sc_event finalResponseReceived;
 
-  // Event triggered when the first flit of a new request arrives.
-  sc_event newRequestEvent;
+  // Events triggered when the first flit of a new request arrives. One per
+  // bank.
+  LokiVector<sc_event> newRequestEvent;
 
   // Event triggered when any flit arrives.
   sc_event newFlitEvent;
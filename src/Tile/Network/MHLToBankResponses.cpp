@@ -9,7 +9,7 @@
 
 MHLToBankResponses::MHLToBankResponses(const sc_module_name name,
                                        const tile_parameters_t& params) :
-    Network<Word>(name, 1, params.numMemories) {
+    Network<Word>(name, 1, params.numMemories + params.dma.buffers) {
 
   // Nothing
 
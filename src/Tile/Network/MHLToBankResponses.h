@@ -26,7 +26,7 @@ public:
 //  ClockInput clock;
 //
 //  LokiVector<InPort> inputs;    // Only one port
-//  LokiVector<OutPort> outputs;  // One per memory
+//  LokiVector<OutPort> outputs;  // One per memory, then one per DMA buffer
 
 //============================================================================//
 // Constructors and destructors
@@ -105,6 +105,10 @@ int  Tile::readRegisterInternal(const ComponentID& component, RegisterIndex reg)
   return 0;
 }
 
+void Tile::countCoreEvent(const ComponentID& core, uint event) {
+  throw UnsupportedFeatureException("Tile::countCoreEvent");
+}
+
 bool Tile::readPredicateInternal(const ComponentID& component) const {
   throw UnsupportedFeatureException("Tile::readPredicateInternal");
   return false;
@@ -118,8 +122,9 @@ void Tile::networkSendCreditInternal(const NetworkCredit& flit) {
   throw UnsupportedFeatureException("Tile::networkSendCreditInternal");
 }
 
-void Tile::magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload) {
-  chip().magicMemoryAccess(opcode, address, returnChannel, payload);
+void Tile::magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload,
+                             MemoryAccessMode mode, ComponentID bank) {
+  chip().magicMemoryAccess(opcode, address, returnChannel, payload, mode, bank);
 }
 
 Chip& Tile::chip() const {
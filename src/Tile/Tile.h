@@ -101,8 +101,10 @@ public:
   virtual bool readPredicateInternal(const ComponentID& component) const;
   virtual void networkSendDataInternal(const NetworkData& flit);
   virtual void networkSendCreditInternal(const NetworkCredit& flit);
+  virtual void countCoreEvent(const ComponentID& core, uint event);
 
-  virtual void magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload = 0);
+  virtual void magicMemoryAccess(MemoryOpcode opcode, MemoryAddr address, ChannelID returnChannel, Word payload = 0,
+                                 MemoryAccessMode mode = MEMORY_CACHE, ComponentID bank = ComponentID());
 
 
 protected:
@@ -49,6 +49,9 @@ typedef uint32_t MapIndex;
 // The index of a register within a register file.
 typedef uint32_t RegisterIndex;
 
+// The index of a hardware thread context within a core.
+typedef uint32_t ThreadIndex;
+
 // An offset (in words) to jump by in the instruction packet cache.
 typedef int32_t  JumpOffset;
 
@@ -13,6 +13,7 @@
 #include "StringManipulation.h"
 #include "StartUp/DataBlock.h"
 #include "Trace/Callgrind.h"
+#include "Trace/MemoryTrace.h"
 #include "../Chip.h"
 #include "Warnings.h"
 
@@ -24,6 +25,8 @@ char** Arguments::programArgv = NULL;
 
 vector<string> Arguments::programFiles;
 
+string Arguments::memTraceFile_ = "";
+string Arguments::memReplayFile_ = "";
 string Arguments::energyTraceFile_ = "";
 string Arguments::stallsTraceFile_ = "";
 string Arguments::callgrindTraceFile_ = "";
@@ -40,6 +43,9 @@ bool Arguments::silent_ = false;
 vector<string> Arguments::parameterNames;
 vector<string> Arguments::parameterValues;
 
+vector<MemoryAddr> Arguments::uncachedStart;
+vector<MemoryAddr> Arguments::uncachedEnd;
+
 void Arguments::parse(int argc, char* argv[]) {
 
   bool useDefaultSettings = true;
@@ -111,10 +117,30 @@ void Arguments::parse(int argc, char* argv[]) {
       // Wait until all arguments have been parsed before starting the trace.
       // We need to be sure that we know the location of the binary too.
     }
+    else if (argument == "-memtrace") {
+      // Record all requests from cores to memory in a binary file.
+      memTraceFile_ = string(argv[i+1]);
+      i++;  // Have used two arguments in this iteration.
+    }
+    else if (argument == "-memreplay") {
+      // Replace all cores with the memory requests from a trace.
+      memReplayFile_ = string(argv[i+1]);
+      i++;  // Have used two arguments in this iteration.
+    }
     else if (argument == "-ipkstats") {
       ipkStatsFile_ = string(argv[i+1]);
       i++;  // Have used two arguments in this iteration.
     }
+    else if (argument == "-uncached") {
+      // Use "-uncached start:end" to make a region of memory bypass the caches.
+      vector<string>& parts = StringManipulation::split(string(argv[i+1]), ':');
+      assert(parts.size() == 2);
+      uncachedStart.push_back(StringManipulation::strToInt(parts[0]));
+      uncachedEnd.push_back(StringManipulation::strToInt(parts[1]));
+      assert(uncachedEnd.back() > uncachedStart.back());
+      delete &parts;
+      i++;  // Have used two arguments in this iteration.
+    }
     else if (argument == "-summary") {
       summarise_ = true;
     }
@@ -196,6 +222,10 @@ void Arguments::updateState(chip_parameters_t& params) {
   // Perform any setup which must wait until all arguments have been parsed.
   if (!callgrindTraceFile_.empty())
     Callgrind::startTrace(callgrindTraceFile_, programFiles[0], params);
+  if (!memTraceFile_.empty())
+    MemoryTrace::startCapture(memTraceFile_);
+  if (!memReplayFile_.empty())
+    MemoryTrace::loadReplay(memReplayFile_);
 
 }
 
@@ -249,6 +279,11 @@ void Arguments::storeArguments(Chip& chip) {
   chip.storeData(DataBlock(&data, ComponentID(2,0,0), 0, true));
 }
 
+void Arguments::setMemoryAttributes(Chip& chip) {
+  for (uint i=0; i<uncachedStart.size(); i++)
+    chip.setUncached(uncachedStart[i], uncachedEnd[i]);
+}
+
 void Arguments::setCommandLineParameters(chip_parameters_t& params) {
   assert(parameterNames.size() == parameterValues.size());
   for (uint i=0; i<parameterNames.size(); i++)
@@ -274,6 +309,8 @@ const string& Arguments::ipkStatsFile() {
 bool Arguments::csimTrace()               {return csimTrace_;}
 bool Arguments::instructionTrace()        {return instructionTrace_;}
 bool Arguments::instructionAddressTrace() {return instructionAddressTrace_;}
+bool Arguments::memoryTrace()             {return memTraceFile_.length() > 0;}
+bool Arguments::memoryReplay()            {return memReplayFile_.length() > 0;}
 bool Arguments::energyTrace()             {return energyTraceFile_.length() > 0;}
 bool Arguments::stallTrace()              {return stallsTraceFile_.length() > 0;}
 bool Arguments::callgrindTrace()          {return callgrindTraceFile_.length() > 0;}
@@ -297,9 +334,12 @@ void Arguments::printHelp() {
     "  -energytrace <file>\n\tDump counts of all significant energy-consuming events to a file\n"
     "  -stalltrace <file>\n\tDump information about each processor stall to a file\n"
     "  -callgrind <file>\n\tDump output in the Callgrind format\n"
+    "  -memtrace <file>\n\tRecord every request from a core to memory in a binary file\n"
+    "  -memreplay <file>\n\tReplace cores with the memory requests recorded using -memtrace\n"
     "  -ipkstats <file>\n\tDump the number of times each instruction packet was executed\n"
     "  -insttrace\n\tPrint the text form of each instruction executed to stdout\n"
     "  -instaddrtrace\n\tPrint the address of each instruction executed to stdout\n"
+    "  -uncached <start>:<end>\n\tPerform word accesses and atomics to main memory addresses [start, end)\n\tat main memory, bypassing the caches. May be used more than once\n"
     "  -Wwarning=value\n\tSwitch on/off a named warning\n"
     "  --parameter=value\n\tSet a named parameter to a particular value. List parameters using\n\t`--list-parameters`.\n"
     "  --help\n\tDisplay this information and exit\n"
@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 #include "Parameters.h"
+#include "../Memory/MemoryTypes.h"
 
 using std::string;
 using std::vector;
@@ -37,6 +38,10 @@ public:
   // These arguments are separated from the simulator arguments by "--args".
   static void storeArguments(Chip& chip);
 
+  // Apply any memory attributes requested on the command line, e.g. regions
+  // of main memory which bypass the caches.
+  static void setMemoryAttributes(Chip& chip);
+
   // Tells whether simulation should actually take place.
   static bool simulate();
 
@@ -50,6 +55,7 @@ public:
   static bool csimTrace();
   static bool coreTrace();
   static bool memoryTrace();
+  static bool memoryReplay();
   static bool energyTrace();
   static bool softwareTrace();
   static bool lbtTrace();
@@ -93,6 +99,7 @@ private:
   // Filenames used for dumping information.
   static string coreTraceFile_,
                 memTraceFile_,
+                memReplayFile_,
                 energyTraceFile_,
                 softwareTraceFile_,
                 lbtTraceFile_,
@@ -117,6 +124,9 @@ private:
   // Store up any parameters set on the command line.
   static vector<string> parameterNames, parameterValues;
 
+  // Regions of main memory which bypass the caches: [start, end).
+  static vector<MemoryAddr> uncachedStart, uncachedEnd;
+
 };
 
 #endif /* ARGUMENTS_H_ */
@@ -14,19 +14,19 @@
 bool ISA::storesResult(opcode_t opcode) {return hasDestReg(opcode);} // remove?
 
 bool ISA::hasDestReg(opcode_t opcode) {
-  static const bool _hasDestReg[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  static const bool _hasDestReg[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
 
   return _hasDestReg[opcode];
 }
 
 bool ISA::hasSrcReg1(opcode_t opcode) {
-  static const bool _hasSrcReg1[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  static const bool _hasSrcReg1[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
 
   return _hasSrcReg1[opcode];
 }
 
 bool ISA::hasSrcReg2(opcode_t opcode) {
-  static const bool _hasSrcReg2[] = {1, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  static const bool _hasSrcReg2[] = {1, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
 
   return _hasSrcReg2[opcode];
 }
@@ -38,7 +38,7 @@ bool ISA::hasImmediate(opcode_t opcode) {
 }
 
 bool ISA::hasRemoteChannel(opcode_t opcode) {
-  static const bool _hasRemoteChannel[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  static const bool _hasRemoteChannel[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
 
   return _hasRemoteChannel[opcode];
 }
@@ -50,7 +50,7 @@ bool ISA::setsPredicate(opcode_t opcode) {
 }
 
 bool ISA::isALUOperation(opcode_t opcode) {
-  static const bool _isALUOperation[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  static const bool _isALUOperation[] = {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
 
   return _isALUOperation[opcode];
 }
@@ -61,10 +61,10 @@ bool ISA::hasSignedImmediate(opcode_t opcode) {
   return _hasSignedImmediate[opcode];
 }
 
-int  ISA::numInstructions() {return 104;} // 128?
+int  ISA::numInstructions() {return 118;} // 128?
 
 const inst_name_t& ISA::name(opcode_t opcode, function_t function) {
-  static const inst_name_t opcode_to_name[] = {"subu", "subu.p", "nori", "nori.p", "psel", "nxipk", "andi", "andi.p", "mulhw", "", "ori", "ori.p", "mullw", "", "xori", "xori.p", "mulhwu", "", "seteqi", "seteqi.p", "", "", "setnei", "setnei.p", "", "", "setlti", "setlti.p", "", "", "setltui", "setltui.p", "stc", "", "setgtei", "setgtei.p", "ldadd", "", "setgteui", "setgteui.p", "ldor", "", "slli", "", "ldand", "", "srli", "srli.p", "ldxor", "", "srai", "", "exchange", "", "addui", "addui.p", "", "", "", "", "", "", "clz", "", "iwtr", "rmtnxipk", "ldw", "ldl", "psel.fetch", "rmtexecute", "ldhwu", "sendconfig", "stw", "syscall", "ldbu", "", "scratchwr", "ibjmp", "scratchwri", "", "setchmap", "woche", "setchmapi", "", "sthw", "fetchr", "fetch", "", "stb", "fillr", "fetchpst", "", "lui", "fetchpstr", "fill", "cregwri", "psel.fetchr", "selch", "irdr", "cregrdi", "", "tstchi", "", "tstchi.p", "", "getchmapi", "getchmap", "lli", "", "scratchrdi", "scratchrd", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", ""};
+  static const inst_name_t opcode_to_name[] = {"subu", "subu.p", "nori", "nori.p", "psel", "nxipk", "andi", "andi.p", "mulhw", "", "ori", "ori.p", "mullw", "", "xori", "xori.p", "mulhwu", "", "seteqi", "seteqi.p", "", "", "setnei", "setnei.p", "", "", "setlti", "setlti.p", "", "", "setltui", "setltui.p", "stc", "", "setgtei", "setgtei.p", "ldadd", "", "setgteui", "setgteui.p", "ldor", "", "slli", "", "ldand", "", "srli", "srli.p", "ldxor", "", "srai", "", "exchange", "", "addui", "addui.p", "", "", "", "", "", "", "clz", "", "iwtr", "rmtnxipk", "ldw", "ldl", "psel.fetch", "rmtexecute", "ldhwu", "sendconfig", "stw", "syscall", "ldbu", "", "scratchwr", "ibjmp", "scratchwri", "", "setchmap", "woche", "setchmapi", "", "sthw", "fetchr", "fetch", "", "stb", "fillr", "fetchpst", "", "lui", "fetchpstr", "fill", "cregwri", "psel.fetchr", "selch", "irdr", "cregrdi", "", "tstchi", "", "tstchi.p", "", "getchmapi", "getchmap", "lli", "", "scratchrdi", "scratchrd", "addb", "addh", "subb", "subh", "addusb", "addsh", "subusb", "subsh", "minub", "maxub", "minh", "maxh", "dotb", "doth", "", "", ""};
   
   static const inst_name_t function_to_name[] = {"nor", "and", "or", "xor", "seteq", "setne", "setlt", "setltu", "setgte", "setgteu", "sll", "srl", "sra", "addu", "subu", ""};
   
@@ -76,7 +76,7 @@ const inst_name_t& ISA::name(opcode_t opcode, function_t function) {
 }
 
 format_t ISA::format(opcode_t opcode) {
-  static const format_t opcode_to_format[] = {FMT_3R, FMT_3R, FMT_2R, FMT_2R, FMT_3R, FMT_0R, FMT_2R, FMT_2R, FMT_3R, (format_t)0, FMT_2R, FMT_2R, FMT_3R, (format_t)0, FMT_2R, FMT_2R, FMT_3R, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, FMT_2R, FMT_2R, FMT_2R, (format_t)0, FMT_2R, FMT_2R, FMT_2R, (format_t)0, FMT_2R, FMT_2R, FMT_2R, (format_t)0, FMT_2Rs, (format_t)0, FMT_2R, (format_t)0, FMT_2Rs, FMT_2Rs, FMT_2R, (format_t)0, FMT_2Rs, (format_t)0, FMT_2R, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, FMT_2R, (format_t)0, FMT_2R, FMT_0R, FMT_1R, FMT_1R, FMT_2Rnc, FMT_0R, FMT_1R, FMT_1R, FMT_2R, FMT_0Rnc, FMT_1R, (format_t)0, FMT_2Rnc, FMT_0R, FMT_1Rnc, (format_t)0, FMT_2Rnc, FMT_0R, FMT_1Rnc, (format_t)0, FMT_2R, FMT_FF, FMT_1Rnc, (format_t)0, FMT_2R, FMT_FF, FMT_1Rnc, (format_t)0, FMT_1Rnc, FMT_FF, FMT_1Rnc, FMT_1Rnc, FMT_PFF, FMT_1Rnc, FMT_2R, FMT_1R, (format_t)0, FMT_1R, (format_t)0, FMT_1R, (format_t)0, FMT_1R, FMT_2R, FMT_1Rnc, (format_t)0, FMT_1R, FMT_2R, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0};
+  static const format_t opcode_to_format[] = {FMT_3R, FMT_3R, FMT_2R, FMT_2R, FMT_3R, FMT_0R, FMT_2R, FMT_2R, FMT_3R, (format_t)0, FMT_2R, FMT_2R, FMT_3R, (format_t)0, FMT_2R, FMT_2R, FMT_3R, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, FMT_2R, FMT_2R, FMT_2R, (format_t)0, FMT_2R, FMT_2R, FMT_2R, (format_t)0, FMT_2R, FMT_2R, FMT_2R, (format_t)0, FMT_2Rs, (format_t)0, FMT_2R, (format_t)0, FMT_2Rs, FMT_2Rs, FMT_2R, (format_t)0, FMT_2Rs, (format_t)0, FMT_2R, (format_t)0, FMT_2R, FMT_2R, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, (format_t)0, FMT_2R, (format_t)0, FMT_2R, FMT_0R, FMT_1R, FMT_1R, FMT_2Rnc, FMT_0R, FMT_1R, FMT_1R, FMT_2R, FMT_0Rnc, FMT_1R, (format_t)0, FMT_2Rnc, FMT_0R, FMT_1Rnc, (format_t)0, FMT_2Rnc, FMT_0R, FMT_1Rnc, (format_t)0, FMT_2R, FMT_FF, FMT_1Rnc, (format_t)0, FMT_2R, FMT_FF, FMT_1Rnc, (format_t)0, FMT_1Rnc, FMT_FF, FMT_1Rnc, FMT_1Rnc, FMT_PFF, FMT_1Rnc, FMT_2R, FMT_1R, (format_t)0, FMT_1R, (format_t)0, FMT_1R, (format_t)0, FMT_1R, FMT_2R, FMT_1Rnc, (format_t)0, FMT_1R, FMT_2R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, FMT_3R, (format_t)0, (format_t)0, (format_t)0};
 
   return opcode_to_format[opcode];
 }
@@ -138,6 +138,13 @@ opcode_t ISA::opcode(const inst_name_t& name) {
     name_to_opcode["exchange"] = OP_EXCHANGE;         name_to_opcode["selch"] = OP_SELCH;           
     name_to_opcode["tstchi"] = OP_TSTCHI;             name_to_opcode["tstchi.p"] = OP_TSTCHI_P;     
     name_to_opcode["sendconfig"] = OP_SENDCONFIG;     name_to_opcode["nxipk"] = OP_NXIPK;           
+    name_to_opcode["addb"] = OP_ADDB;                 name_to_opcode["addh"] = OP_ADDH;
+    name_to_opcode["subb"] = OP_SUBB;                 name_to_opcode["subh"] = OP_SUBH;
+    name_to_opcode["addusb"] = OP_ADDUSB;             name_to_opcode["addsh"] = OP_ADDSH;
+    name_to_opcode["subusb"] = OP_SUBUSB;             name_to_opcode["subsh"] = OP_SUBSH;
+    name_to_opcode["minub"] = OP_MINUB;               name_to_opcode["maxub"] = OP_MAXUB;
+    name_to_opcode["minh"] = OP_MINH;                 name_to_opcode["maxh"] = OP_MAXH;
+    name_to_opcode["dotb"] = OP_DOTB;                 name_to_opcode["doth"] = OP_DOTH;
 
     initialised = true;
   }
@@ -177,7 +184,7 @@ function_t ISA::function(const inst_name_t& name) {
 }
 
 function_t ISA::function(opcode_t opcode) {
-  static const function_t opcode_to_function[] = {(function_t)14, (function_t)14, (function_t)0, (function_t)0, (function_t)16, (function_t)-1, (function_t)1, (function_t)1, (function_t)17, (function_t)0, (function_t)2, (function_t)2, (function_t)18, (function_t)0, (function_t)3, (function_t)3, (function_t)19, (function_t)0, (function_t)4, (function_t)4, (function_t)0, (function_t)0, (function_t)5, (function_t)5, (function_t)0, (function_t)0, (function_t)6, (function_t)6, (function_t)0, (function_t)0, (function_t)7, (function_t)7, (function_t)13, (function_t)0, (function_t)8, (function_t)8, (function_t)13, (function_t)0, (function_t)9, (function_t)9, (function_t)13, (function_t)0, (function_t)10, (function_t)0, (function_t)13, (function_t)0, (function_t)11, (function_t)11, (function_t)13, (function_t)0, (function_t)12, (function_t)0, (function_t)13, (function_t)0, (function_t)13, (function_t)13, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)20, (function_t)0, (function_t)31, (function_t)31, (function_t)13, (function_t)13, (function_t)-1, (function_t)-1, (function_t)13, (function_t)31, (function_t)13, (function_t)-1, (function_t)13, (function_t)0, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)0, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)0, (function_t)13, (function_t)-1, (function_t)-1, (function_t)0, (function_t)13, (function_t)-1, (function_t)-1, (function_t)0, (function_t)2, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)31, (function_t)31, (function_t)-1, (function_t)0, (function_t)31, (function_t)0, (function_t)31, (function_t)0, (function_t)-1, (function_t)-1, (function_t)31, (function_t)0, (function_t)-1, (function_t)-1, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0};
+  static const function_t opcode_to_function[] = {(function_t)14, (function_t)14, (function_t)0, (function_t)0, (function_t)16, (function_t)-1, (function_t)1, (function_t)1, (function_t)17, (function_t)0, (function_t)2, (function_t)2, (function_t)18, (function_t)0, (function_t)3, (function_t)3, (function_t)19, (function_t)0, (function_t)4, (function_t)4, (function_t)0, (function_t)0, (function_t)5, (function_t)5, (function_t)0, (function_t)0, (function_t)6, (function_t)6, (function_t)0, (function_t)0, (function_t)7, (function_t)7, (function_t)13, (function_t)0, (function_t)8, (function_t)8, (function_t)13, (function_t)0, (function_t)9, (function_t)9, (function_t)13, (function_t)0, (function_t)10, (function_t)0, (function_t)13, (function_t)0, (function_t)11, (function_t)11, (function_t)13, (function_t)0, (function_t)12, (function_t)0, (function_t)13, (function_t)0, (function_t)13, (function_t)13, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)0, (function_t)20, (function_t)0, (function_t)31, (function_t)31, (function_t)13, (function_t)13, (function_t)-1, (function_t)-1, (function_t)13, (function_t)31, (function_t)13, (function_t)-1, (function_t)13, (function_t)0, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)0, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)0, (function_t)13, (function_t)-1, (function_t)-1, (function_t)0, (function_t)13, (function_t)-1, (function_t)-1, (function_t)0, (function_t)2, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)-1, (function_t)31, (function_t)31, (function_t)-1, (function_t)0, (function_t)31, (function_t)0, (function_t)31, (function_t)0, (function_t)-1, (function_t)-1, (function_t)31, (function_t)0, (function_t)-1, (function_t)-1, (function_t)32, (function_t)33, (function_t)34, (function_t)35, (function_t)36, (function_t)37, (function_t)38, (function_t)39, (function_t)40, (function_t)41, (function_t)42, (function_t)43, (function_t)44, (function_t)45, (function_t)0, (function_t)0, (function_t)0};
 
   return opcode_to_function[opcode];
 }
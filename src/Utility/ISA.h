@@ -123,7 +123,21 @@ public:
     OP_TSTCHI = 101,    // tstchi rd, immed (-> ch)
     OP_TSTCHI_P = 103,  // tstchi.p rd, immed (-> ch)
     OP_SENDCONFIG = 71, // sendconfig rs, immed -> ch
-    OP_NXIPK = 5        // nxipk
+    OP_NXIPK = 5,       // nxipk
+    OP_ADDB = 111,      // addb rd, rs, rt (-> ch)
+    OP_ADDH = 112,      // addh rd, rs, rt (-> ch)
+    OP_SUBB = 113,      // subb rd, rs, rt (-> ch)
+    OP_SUBH = 114,      // subh rd, rs, rt (-> ch)
+    OP_ADDUSB = 115,    // addusb rd, rs, rt (-> ch)
+    OP_ADDSH = 116,     // addsh rd, rs, rt (-> ch)
+    OP_SUBUSB = 117,    // subusb rd, rs, rt (-> ch)
+    OP_SUBSH = 118,     // subsh rd, rs, rt (-> ch)
+    OP_MINUB = 119,     // minub rd, rs, rt (-> ch)
+    OP_MAXUB = 120,     // maxub rd, rs, rt (-> ch)
+    OP_MINH = 121,      // minh rd, rs, rt (-> ch)
+    OP_MAXH = 122,      // maxh rd, rs, rt (-> ch)
+    OP_DOTB = 123,      // dotb rd, rs, rt (-> ch)
+    OP_DOTH = 124       // doth rd, rs, rt (-> ch)
 
   };
   
@@ -150,6 +164,20 @@ public:
     FN_MULLW = 18,
     FN_MULHWU = 19,
     FN_CLZ = 20,
+    FN_ADDB = 32,
+    FN_ADDH = 33,
+    FN_SUBB = 34,
+    FN_SUBH = 35,
+    FN_ADDUSB = 36,
+    FN_ADDSH = 37,
+    FN_SUBUSB = 38,
+    FN_SUBSH = 39,
+    FN_MINUB = 40,
+    FN_MAXUB = 41,
+    FN_MINH = 42,
+    FN_MAXH = 43,
+    FN_DOTB = 44,
+    FN_DOTH = 45,
   };
   
   enum Format {
@@ -11,16 +11,23 @@
 #include "Arguments.h"
 #include "Debugger.h"
 #include "Instrumentation/ChannelMap.h"
+#include "Instrumentation/Coherence.h"
+#include "Instrumentation/DMA.h"
 #include "Instrumentation/FIFO.h"
 #include "Instrumentation/IPKCache.h"
+#include "Instrumentation/L2Cache.h"
+#include "Instrumentation/LastLevelCache.h"
 #include "Instrumentation/Latency.h"
 #include "Instrumentation/MainMemory.h"
 #include "Instrumentation/Network.h"
 #include "Instrumentation/Operations.h"
 #include "Instrumentation/PipelineReg.h"
 #include "Instrumentation/Registers.h"
+#include "Instrumentation/Reservations.h"
 #include "Instrumentation/Scratchpad.h"
 #include "Instrumentation/Stalls.h"
+#include "Instrumentation/Threads.h"
+#include "Instrumentation/WriteBuffer.h"
 #include "../Datatype/DecodedInst.h"
 #include "Instrumentation/L1Cache.h"
 
@@ -35,8 +42,12 @@ cycle_count_t cyclesRecorded = 0;
 
 void Instrumentation::initialise(const chip_parameters_t& params) {
   ChannelMap::init(params);
+  Coherence::init(params);
+  DMA::init(params);
   FIFO::init(params);
   IPKCache::init(params);
+  LastLevelCache::init(params);
+  L2Cache::init(params);
   Latency::init(params);
   MainMemory::init(params);
   L1Cache::init(params);
@@ -44,16 +55,23 @@ void Instrumentation::initialise(const chip_parameters_t& params) {
   Operations::init(params);
   PipelineReg::init(params);
   Registers::init(params);
+  Reservations::init(params);
   Scratchpad::init(params);
   Stalls::init(params);
+  Threads::init(params);
+  WriteBuffer::init(params);
 
   reset();
 }
 
 void Instrumentation::reset() {
   ChannelMap::reset();
+  Coherence::reset();
+  DMA::reset();
   FIFO::reset();
   IPKCache::reset();
+  LastLevelCache::reset();
+  L2Cache::reset();
   Latency::reset();
   MainMemory::reset();
   L1Cache::reset();
@@ -61,8 +79,11 @@ void Instrumentation::reset() {
   Operations::reset();
   PipelineReg::reset();
   Registers::reset();
+  Reservations::reset();
   Scratchpad::reset();
   Stalls::reset();
+  Threads::reset();
+  WriteBuffer::reset();
 
   statsWiped = currentCycle();
   if (collecting)
@@ -72,8 +93,12 @@ void Instrumentation::reset() {
 
 void Instrumentation::start() {
   ChannelMap::start();
+  Coherence::start();
+  DMA::start();
   FIFO::start();
   IPKCache::start();
+  LastLevelCache::start();
+  L2Cache::start();
   Latency::start();
   MainMemory::start();
   L1Cache::start();
@@ -81,8 +106,11 @@ void Instrumentation::start() {
   Operations::start();
   PipelineReg::start();
   Registers::start();
+  Reservations::start();
   Scratchpad::start();
   Stalls::start();
+  Threads::start();
+  WriteBuffer::start();
 
   if (!collecting)
     statsStarted = currentCycle();
@@ -91,8 +119,12 @@ void Instrumentation::start() {
 
 void Instrumentation::stop() {
   ChannelMap::stop();
+  Coherence::stop();
+  DMA::stop();
   FIFO::stop();
   IPKCache::stop();
+  LastLevelCache::stop();
+  L2Cache::stop();
   Latency::stop();
   MainMemory::stop();
   L1Cache::stop();
@@ -100,8 +132,11 @@ void Instrumentation::stop() {
   Operations::stop();
   PipelineReg::stop();
   Registers::stop();
+  Reservations::stop();
   Scratchpad::stop();
   Stalls::stop();
+  Threads::stop();
+  WriteBuffer::stop();
 
   if (collecting) {
     statsStopped = currentCycle();
@@ -115,8 +150,12 @@ void Instrumentation::end() {
   stop();
 
   ChannelMap::end();
+  Coherence::end();
+  DMA::end();
   FIFO::end();
   IPKCache::end();
+  LastLevelCache::end();
+  L2Cache::end();
   Latency::end();
   MainMemory::end();
   L1Cache::end();
@@ -124,8 +163,11 @@ void Instrumentation::end() {
   Operations::end();
   PipelineReg::end();
   Registers::end();
+  Reservations::end();
   Scratchpad::end();
   Stalls::end();
+  Threads::end();
+  WriteBuffer::end();
 }
 
 bool Instrumentation::collectingStats() {
@@ -157,15 +199,22 @@ void Instrumentation::dumpEventCounts(std::ostream& os, const chip_parameters_t&
   os << "\n";
 
   ChannelMap::dumpEventCounts(os, params);    os << "\n";
+  Coherence::dumpEventCounts(os, params);     os << "\n";
+  DMA::dumpEventCounts(os, params);           os << "\n";
   FIFO::dumpEventCounts(os, params);          os << "\n";
   IPKCache::dumpEventCounts(os, params);      os << "\n";
   L1Cache::dumpEventCounts(os, params);       os << "\n";
+  LastLevelCache::dumpEventCounts(os, params); os << "\n";
+  L2Cache::dumpEventCounts(os, params);        os << "\n";
   Network::dumpEventCounts(os, params);       os << "\n";
   Operations::dumpEventCounts(os, params);    os << "\n";
   PipelineReg::dumpEventCounts(os, params);   os << "\n";
   Registers::dumpEventCounts(os, params);     os << "\n";
+  Reservations::dumpEventCounts(os, params);  os << "\n";
   Scratchpad::dumpEventCounts(os, params);    os << "\n";
   Stalls::dumpEventCounts(os, params);        os << "\n";
+  Threads::dumpEventCounts(os, params);       os << "\n";
+  WriteBuffer::dumpEventCounts(os, params);   os << "\n";
 
   os << "</lokitrace>\n";
 }
@@ -174,10 +223,17 @@ void Instrumentation::printSummary(const chip_parameters_t& params) {
   Stalls::printStats(params);
   IPKCache::printSummary(params);
   L1Cache::printSummary(params);
+  WriteBuffer::printSummary(params);
+  L2Cache::printSummary(params);
+  LastLevelCache::printSummary(params);
   MainMemory::printStats(params);
+  Coherence::printSummary(params);
+  DMA::printSummary(params);
+  Reservations::printSummary(params);
   Latency::printSummary(params);
   Network::printSummary(params);
   Operations::printSummary(params);
+  Threads::printSummary(params);
 }
 
 bool Instrumentation::haveEnergyData() {
@@ -222,6 +278,7 @@ bool Instrumentation::executionFinished() {
 
 void Instrumentation::executed(const Core& core, const DecodedInst& inst, bool executed) {
   Operations::executed(core, inst, executed);
+  Threads::executed(core, inst, executed);
 
   if (Debugger::mode == Debugger::DEBUGGER)
     Debugger::executedInstruction(inst, core, executed);
@@ -0,0 +1,107 @@
+/*
+ * Coherence.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "Coherence.h"
+
+#include "../Instrumentation.h"
+#include "../Parameters.h"
+
+using namespace Instrumentation;
+
+count_t Coherence::numInvalidations_;
+count_t Coherence::numDowngrades_;
+count_t Coherence::numUpgrades_;
+count_t Coherence::numSilentUpgrades_;
+count_t Coherence::numWritebacks_;
+count_t Coherence::numRecallCycles_;
+
+void Coherence::reset() {
+  numInvalidations_ = 0;
+  numDowngrades_ = 0;
+  numUpgrades_ = 0;
+  numSilentUpgrades_ = 0;
+  numWritebacks_ = 0;
+  numRecallCycles_ = 0;
+}
+
+void Coherence::invalidation(bool dirty) {
+  if (!Instrumentation::collectingStats()) return;
+
+  numInvalidations_++;
+  if (dirty)
+    numWritebacks_++;
+}
+
+void Coherence::downgrade(bool dirty) {
+  if (!Instrumentation::collectingStats()) return;
+
+  numDowngrades_++;
+  if (dirty)
+    numWritebacks_++;
+}
+
+void Coherence::upgrade() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numUpgrades_++;
+}
+
+void Coherence::silentUpgrade() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numSilentUpgrades_++;
+}
+
+void Coherence::recallDelay(cycle_count_t cycles) {
+  if (!Instrumentation::collectingStats()) return;
+
+  numRecallCycles_ += cycles;
+}
+
+count_t Coherence::numInvalidations() {return numInvalidations_;}
+count_t Coherence::numDowngrades()    {return numDowngrades_;}
+count_t Coherence::numUpgrades()      {return numUpgrades_;}
+count_t Coherence::numWritebacks()    {return numWritebacks_;}
+count_t Coherence::numRecallCycles()  {return numRecallCycles_;}
+
+count_t Coherence::numFlits(const chip_parameters_t& params) {
+  // Every message is a single head flit followed by a single acknowledgement.
+  // Written-back data adds one flit per word.
+  count_t messages = numInvalidations_ + numDowngrades_ + numUpgrades_;
+  count_t lineFlits = params.memory.cacheLineSize / BYTES_PER_WORD;
+  return 2*messages + lineFlits*numWritebacks_;
+}
+
+void Coherence::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
+  os << "<coherence protocol=\"" << params.memory.coherence << "\">\n"
+     << xmlNode("invalidate", numInvalidations_)      << "\n"
+     << xmlNode("downgrade", numDowngrades_)          << "\n"
+     << xmlNode("upgrade", numUpgrades_)              << "\n"
+     << xmlNode("silent_upgrade", numSilentUpgrades_) << "\n"
+     << xmlNode("writeback", numWritebacks_)          << "\n"
+     << xmlNode("flits", numFlits(params))            << "\n"
+     << xmlNode("recall_cycles", numRecallCycles_)    << "\n"
+     << xmlEnd("coherence")                           << "\n";
+}
+
+void Coherence::printSummary(const chip_parameters_t& params) {
+  if (params.memory.coherence == 0)
+    return;
+
+  count_t messages = numInvalidations_ + numDowngrades_ + numUpgrades_;
+
+  std::clog <<
+    "Coherence:\n" <<
+    "  Protocol messages: " << messages << "\n" <<
+    "    Invalidations:   " << numInvalidations_ << " (" << percentage(numInvalidations_, messages) << ")\n" <<
+    "    Downgrades:      " << numDowngrades_ << " (" << percentage(numDowngrades_, messages) << ")\n" <<
+    "    Upgrades:        " << numUpgrades_ << " (" << percentage(numUpgrades_, messages) << ")\n" <<
+    "  Silent upgrades:   " << numSilentUpgrades_ << "\n" <<
+    "  Dirty writebacks:  " << numWritebacks_ << "\n" <<
+    "  Network traffic:   " << numFlits(params) << " flits" << "\n" <<
+    "  Recall latency:    " << numRecallCycles_ << " cycles" << endl;
+}
@@ -0,0 +1,62 @@
+/*
+ * Coherence.h
+ *
+ * Traffic generated by the hardware cache coherence protocol.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_INSTRUMENTATION_COHERENCE_H_
+#define SRC_UTILITY_INSTRUMENTATION_COHERENCE_H_
+
+#include "InstrumentationBase.h"
+
+namespace Instrumentation {
+
+  class Coherence : public InstrumentationBase {
+
+  public:
+
+    static void reset();
+
+    // A tile was told to discard its copy of a cache line.
+    static void invalidation(bool dirty);
+
+    // The exclusive owner of a cache line was told to give up write
+    // permission because another tile wants to read it.
+    static void downgrade(bool dirty);
+
+    // A tile holding a shared copy of a line asked for write permission.
+    static void upgrade();
+
+    // A tile holding an exclusive clean copy started modifying it without
+    // contacting the directory (MESI only).
+    static void silentUpgrade();
+
+    // A request waited for recalled tiles to acknowledge.
+    static void recallDelay(cycle_count_t cycles);
+
+    static count_t numInvalidations();
+    static count_t numDowngrades();
+    static count_t numUpgrades();
+    static count_t numWritebacks();
+    static count_t numRecallCycles();
+
+    // Total flits sent on behalf of the protocol, including acknowledgements
+    // and written-back data.
+    static count_t numFlits(const chip_parameters_t& params);
+
+    static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
+    static void printSummary(const chip_parameters_t& params);
+
+  private:
+
+    static count_t numInvalidations_, numDowngrades_, numUpgrades_,
+                   numSilentUpgrades_, numWritebacks_, numRecallCycles_;
+
+  };
+
+}
+
+#endif /* SRC_UTILITY_INSTRUMENTATION_COHERENCE_H_ */
@@ -0,0 +1,82 @@
+/*
+ * DMA.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "DMA.h"
+
+#include <algorithm>
+#include "../Instrumentation.h"
+#include "../Parameters.h"
+
+using namespace Instrumentation;
+
+count_t DMA::numTransfers_;
+count_t DMA::numFetches_;
+count_t DMA::numStores_;
+count_t DMA::numBytes_;
+cycle_count_t DMA::transferCycles_;
+double DMA::peakBandwidth_;
+
+void DMA::reset() {
+  numTransfers_ = 0;
+  numFetches_ = 0;
+  numStores_ = 0;
+  numBytes_ = 0;
+  transferCycles_ = 0;
+  peakBandwidth_ = 0.0;
+}
+
+void DMA::fetchLine() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numFetches_++;
+}
+
+void DMA::storeLine() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numStores_++;
+}
+
+void DMA::transferComplete(count_t bytes, cycle_count_t cycles) {
+  if (!Instrumentation::collectingStats()) return;
+
+  numTransfers_++;
+  numBytes_ += bytes;
+  transferCycles_ += cycles;
+
+  if (cycles > 0)
+    peakBandwidth_ = std::max(peakBandwidth_, (double)bytes / cycles);
+}
+
+count_t DMA::numTransfers()     {return numTransfers_;}
+count_t DMA::bytesTransferred() {return numBytes_;}
+
+void DMA::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
+  os << "<dma>\n"
+     << xmlNode("transfers", numTransfers_)       << "\n"
+     << xmlNode("fetch_line", numFetches_)        << "\n"
+     << xmlNode("store_line", numStores_)         << "\n"
+     << xmlNode("bytes", numBytes_)               << "\n"
+     << xmlNode("active_cycles", transferCycles_) << "\n"
+     << xmlEnd("dma")                             << "\n";
+}
+
+void DMA::printSummary(const chip_parameters_t& params) {
+  if (numTransfers_ == 0)
+    return;
+
+  double average = (transferCycles_ == 0) ? 0.0 : (double)numBytes_ / transferCycles_;
+
+  std::clog <<
+    "DMA:\n" <<
+    "  Transfers:           " << numTransfers_ << "\n" <<
+    "  Bytes transferred:   " << numBytes_ << "\n" <<
+    "  Lines fetched:       " << numFetches_ << "\n" <<
+    "  Lines stored:        " << numStores_ << "\n" <<
+    "  Achieved bandwidth:  " << average << " bytes/cycle while active\n" <<
+    "  Best transfer:       " << peakBandwidth_ << " bytes/cycle" << endl;
+}
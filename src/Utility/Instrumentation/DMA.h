@@ -0,0 +1,51 @@
+/*
+ * DMA.h
+ *
+ * Bulk transfers performed by each tile's DMA engine.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_INSTRUMENTATION_DMA_H_
+#define SRC_UTILITY_INSTRUMENTATION_DMA_H_
+
+#include "InstrumentationBase.h"
+
+namespace Instrumentation {
+
+  class DMA : public InstrumentationBase {
+
+  public:
+
+    static void reset();
+
+    // A cache line was requested from the source.
+    static void fetchLine();
+
+    // A cache line was sent to the destination.
+    static void storeLine();
+
+    // A transfer of `bytes` bytes finished, `cycles` cycles after it started.
+    static void transferComplete(count_t bytes, cycle_count_t cycles);
+
+    static count_t numTransfers();
+    static count_t bytesTransferred();
+
+    static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
+    static void printSummary(const chip_parameters_t& params);
+
+  private:
+
+    static count_t numTransfers_, numFetches_, numStores_, numBytes_;
+
+    // Sum of all transfers' durations, and the best bandwidth achieved by any
+    // single transfer (bytes per cycle).
+    static cycle_count_t transferCycles_;
+    static double peakBandwidth_;
+
+  };
+
+}
+
+#endif /* SRC_UTILITY_INSTRUMENTATION_DMA_H_ */
@@ -26,6 +26,9 @@ count_t IPKCache::tagsActive_ = 0;
 count_t IPKCache::dataActive_ = 0;
 
 CounterMap<MemoryAddr> IPKCache::packetsExecuted;
+CounterMap<MemoryAddr> IPKCache::packetsLoaded;
+CounterMap<MemoryAddr> IPKCache::packetsEvicted;
+CounterMap<MemoryAddr> IPKCache::residencyCycles;
 
 void IPKCache::init(const chip_parameters_t& params) {
   perCore.resize(params.totalCores());
@@ -36,12 +39,18 @@ void IPKCache::reset() {
   total.misses = 0;
   total.reads = 0;
   total.writes = 0;
+  total.prefetches = 0;
+  total.usefulPrefetches = 0;
+  total.prefetchCyclesSaved = 0;
 
   perCore.assign(perCore.size(), total);
 
   tagWriteHD_ = tagWrites_ = tagReadHD_ = tagsActive_ = dataActive_ = 0;
 
   packetsExecuted.clear();
+  packetsLoaded.clear();
+  packetsEvicted.clear();
+  residencyCycles.clear();
 }
 
 void IPKCache::tagCheck(const Core& core, bool hit, const MemoryAddr tag, const MemoryAddr prevCheck) {
@@ -97,11 +106,43 @@ void IPKCache::dataActivity() {
   dataActive_++;
 }
 
+void IPKCache::prefetch(const Core& core) {
+  if (!Instrumentation::collectingStats()) return;
+
+  total.prefetches++;
+  perCore[core.globalCoreIndex()].prefetches++;
+}
+
+void IPKCache::prefetchUsed(const Core& core, cycle_count_t latencyHidden) {
+  if (!Instrumentation::collectingStats()) return;
+
+  total.usefulPrefetches++;
+  total.prefetchCyclesSaved += latencyHidden;
+  perCore[core.globalCoreIndex()].usefulPrefetches++;
+  perCore[core.globalCoreIndex()].prefetchCyclesSaved += latencyHidden;
+}
+
+void IPKCache::packetLoaded(const MemoryAddr tag) {
+  if (!Instrumentation::collectingStats()) return;
+
+  packetsLoaded.increment(tag);
+}
+
+void IPKCache::packetEvicted(const MemoryAddr tag, cycle_count_t residency) {
+  if (!Instrumentation::collectingStats()) return;
+
+  packetsEvicted.increment(tag);
+  residencyCycles.increment(tag, residency);
+}
+
 count_t IPKCache::numTagChecks() {return total.hits + total.misses;}
 count_t IPKCache::numHits()      {return total.hits;}
 count_t IPKCache::numMisses()    {return total.misses;}
 count_t IPKCache::numReads()     {return total.reads;}
 count_t IPKCache::numWrites()    {return total.writes;}
+count_t IPKCache::numPrefetches() {return total.prefetches;}
+count_t IPKCache::numUsefulPrefetches() {return total.usefulPrefetches;}
+count_t IPKCache::numPrefetchCyclesSaved() {return total.prefetchCyclesSaved;}
 
 void IPKCache::printStats() {
   if (numTagChecks() > 0) {
@@ -121,11 +162,19 @@ void IPKCache::printSummary(const chip_parameters_t& params) {
   clog << "L0 cache activity:" << endl;
   clog << "  Total instruction reads: " << numReads() << endl;
   clog << "  Packet hit rate:         " << numHits() << "/" << numTagChecks() << " (" << percentage(numHits(),numTagChecks()) << ")" << endl;
+  if (numPrefetches() > 0) {
+    clog << "  Useful prefetches:       " << numUsefulPrefetches() << "/" << numPrefetches() << " (" << percentage(numUsefulPrefetches(),numPrefetches()) << ")" << endl;
+    clog << "  Stall cycles saved:      " << numPrefetchCyclesSaved() << " (upper bound)" << endl;
+  }
 
   for (uint core = 0; core < params.totalCores(); core++) {
     struct CoreStats stats = perCore[core];
     if (stats.hits>0 || stats.misses>0 || stats.reads>0 || stats.writes>0) {
-      clog << "    Core " << core << ": " << stats.hits << "/" << (stats.hits+stats.misses) << " (" << percentage(stats.hits, stats.hits+stats.misses) << ")" << endl;
+      clog << "    Core " << core << ": " << stats.hits << "/" << (stats.hits+stats.misses) << " (" << percentage(stats.hits, stats.hits+stats.misses) << ")";
+      if (stats.prefetches > 0)
+        clog << ", prefetch accuracy " << stats.usefulPrefetches << "/" << stats.prefetches << " (" << percentage(stats.usefulPrefetches, stats.prefetches) << ")"
+             << ", at most " << stats.prefetchCyclesSaved << " cycles saved";
+      clog << endl;
     }
   }
 }
@@ -133,7 +182,14 @@ void IPKCache::printSummary(const chip_parameters_t& params) {
 void IPKCache::instructionPacketStats(std::ostream& os) {
   CounterMap<MemoryAddr>::iterator it;
   for (it = packetsExecuted.begin(); it != packetsExecuted.end(); it++) {
-    os << std::setfill('0') << setw(8) << std::hex << it->first << std::dec << "\t" << it->second << endl;
+    MemoryAddr tag = it->first;
+    os << std::setfill('0') << setw(8) << std::hex << tag << std::dec << "\t" << it->second
+       << "\t" << packetsLoaded[tag] << "\t";
+
+    if (packetsEvicted[tag] > 0)
+      os << (residencyCycles[tag] / packetsEvicted[tag]) << endl;
+    else
+      os << "-" << endl;
   }
 }
 
@@ -144,6 +200,9 @@ void IPKCache::dumpEventCounts(std::ostream& os, const chip_parameters_t& params
      << xmlNode("active", dataActive_) << "\n"
      << xmlNode("read", numReads()) << "\n"
      << xmlNode("write", numWrites()) << "\n"
+     << xmlNode("prefetch", numPrefetches()) << "\n"
+     << xmlNode("prefetch_useful", numUsefulPrefetches()) << "\n"
+     << xmlNode("prefetch_cycles_saved", numPrefetchCyclesSaved()) << "\n"
      << xmlEnd("ipkcache") << "\n";
 
   os << "<ipkcachetags entries=\"" << params.tile.core.cache.numTags << "\">\n"
@@ -34,14 +34,26 @@ public:
   static void write(const Core& core);
   static void dataActivity();
 
+  static void prefetch(const Core& core);
+  static void prefetchUsed(const Core& core, cycle_count_t latencyHidden);
+
+  static void packetLoaded(const MemoryAddr tag);
+  static void packetEvicted(const MemoryAddr tag, cycle_count_t residency);
+
   static count_t numTagChecks();
   static count_t numHits();
   static count_t numMisses();
   static count_t numReads();
   static count_t numWrites();
+  static count_t numPrefetches();
+  static count_t numUsefulPrefetches();
+  static count_t numPrefetchCyclesSaved();
 
   static void printStats();
   static void printSummary(const chip_parameters_t& params);
+
+  // One line per executed packet: address, times executed, times loaded into
+  // a cache, and mean cycles resident per eviction ("-" if never evicted).
   static void instructionPacketStats(std::ostream& os);
   static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
 
@@ -52,6 +64,9 @@ private:
     count_t misses;
     count_t reads;
     count_t writes;
+    count_t prefetches;
+    count_t usefulPrefetches;
+    count_t prefetchCyclesSaved; // Fetch latency hidden by useful prefetches.
   };
   static vector<struct CoreStats> perCore;
   static struct CoreStats total;
@@ -63,6 +78,11 @@ private:
 
   // Count how many times each instruction packet was executed.
   static CounterMap<MemoryAddr> packetsExecuted;
+
+  // Count how many times each packet was brought into a cache and removed
+  // again, and the total number of cycles it spent in caches before removal.
+  static CounterMap<MemoryAddr> packetsLoaded, packetsEvicted;
+  static CounterMap<MemoryAddr> residencyCycles;
 };
 
 }
@@ -6,6 +6,7 @@
  */
 
 
+#include <iomanip>
 #include <map>
 #include "../Parameters.h"
 #include "../../Exceptions/InvalidOptionException.h"
@@ -31,6 +32,9 @@ CounterMap<ComponentID> L1Cache::replaceInvalidLine;
 CounterMap<ComponentID> L1Cache::replaceCleanLine;
 CounterMap<ComponentID> L1Cache::replaceDirtyLine;
 
+CounterMap<uint> L1Cache::setAccesses;
+CounterMap<uint> L1Cache::setConflicts;
+
 vector<vector<struct L1Cache::ChannelStats> > L1Cache::coreStats;
 
 void L1Cache::init(const chip_parameters_t& params) {
@@ -72,6 +76,8 @@ void L1Cache::reset() {
   replaceInvalidLine.clear();
   replaceCleanLine.clear();
   replaceDirtyLine.clear();
+  setAccesses.clear();
+  setConflicts.clear();
 }
 
 void L1Cache::startOperation(const MemoryBank& bank, MemoryOpcode op,
@@ -95,6 +101,7 @@ void L1Cache::startOperation(const MemoryBank& bank, MemoryOpcode op,
     case EXCHANGE:
     case UPDATE_DIRECTORY_ENTRY:
     case UPDATE_DIRECTORY_MASK:
+    case DMA_COMMAND:
       if (miss)
         misses[op].increment(bank.id);
       else
@@ -159,17 +166,21 @@ void L1Cache::continueOperation(const MemoryBank& bank, MemoryOpcode op,
   }
 }
 
-void L1Cache::checkTags(ComponentID bank, MemoryAddr address) {
+void L1Cache::checkTags(ComponentID bank, MemoryAddr address, uint line) {
   if (!Instrumentation::collectingStats()) return;
 
   tagChecks.increment(bank);
+  setAccesses.increment(line);
 
   // Do something with Hamming distance of address?
 }
 
-void L1Cache::replaceCacheLine(ComponentID bank, bool isValid, bool isDirty) {
+void L1Cache::replaceCacheLine(ComponentID bank, uint line, bool isValid, bool isDirty) {
   if (!Instrumentation::collectingStats()) return;
 
+  if (isValid)
+    setConflicts.increment(line);
+
   if (!isValid)
     replaceInvalidLine.increment(bank);
   else if (isDirty)
@@ -263,6 +274,46 @@ void L1Cache::printSummary(const chip_parameters_t& params) {
   clog << "  Data read hits:   " << dataReadHits << "/" << dataReads << " (" << percentage(dataReadHits, dataReads) << ")\n";
   clog << "  Data write hits:  " << dataWriteHits << "/" << dataWrites << " (" << percentage(dataWriteHits, dataWrites) << ")\n";
   clog << "  Total hits:       " << totalHits << "/" << totalAccesses << " (" << percentage(totalHits, totalAccesses) << ")\n";
+
+  printBalance(params);
+}
+
+void L1Cache::printBalance(const chip_parameters_t& params) {
+  count_t accesses = tagChecks.numEvents();
+  if (accesses == 0)
+    return;
+
+  using std::clog;
+
+  clog << "  Bank accesses:\n";
+  for (CounterMap<ComponentID>::iterator it = tagChecks.begin(); it != tagChecks.end(); ++it)
+    clog << "    " << it->first << ": " << it->second << " (" << percentage(it->second, accesses) << ")\n";
+
+  uint numSets = params.tile.memory.size / params.tile.memory.cacheLineSize;
+  uint setsUsed = 0;
+  uint hottestSet = 0;
+  count_t hottestCount = 0;
+  for (CounterMap<uint>::iterator it = setAccesses.begin(); it != setAccesses.end(); ++it) {
+    if (it->second == 0)
+      continue;
+    setsUsed++;
+    if (it->second > hottestCount) {
+      hottestSet = it->first;
+      hottestCount = it->second;
+    }
+  }
+
+  uint conflictSets = 0;
+  for (CounterMap<uint>::iterator it = setConflicts.begin(); it != setConflicts.end(); ++it)
+    if (it->second > 0)
+      conflictSets++;
+
+  double mean = (double)accesses / numSets;
+
+  clog << "  Sets accessed:    " << setsUsed << "/" << numSets << "\n";
+  clog << "  Hottest set:      " << hottestSet << " (" << hottestCount << " accesses, "
+       << std::fixed << std::setprecision(1) << (hottestCount / mean) << "x mean)\n";
+  clog << "  Conflict misses:  " << setConflicts.numEvents() << " in " << conflictSets << " sets\n";
 }
 
 void L1Cache::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
@@ -285,6 +336,23 @@ void L1Cache::dumpEventCounts(std::ostream& os, const chip_parameters_t& params)
      << xmlNode("burst_write",    totalBurstWrites())            << "\n"
      << xmlNode("replace_line",   totalLineReplacements())       << "\n"
      << xmlEnd("memory")                                         << "\n";
+
+  // Access histograms, to help find hot spots.
+  for (CounterMap<ComponentID>::iterator it = tagChecks.begin(); it != tagChecks.end(); ++it) {
+    ComponentID bank = it->first;
+    os << "<l1_bank id=\"" << bank << "\">\n"
+       << xmlNode("tag_check", it->second)                                     << "\n"
+       << xmlNode("replace_valid", replaceCleanLine[bank] + replaceDirtyLine[bank]) << "\n"
+       << xmlEnd("l1_bank")                                                    << "\n";
+  }
+
+  for (CounterMap<uint>::iterator it = setAccesses.begin(); it != setAccesses.end(); ++it) {
+    uint line = it->first;
+    os << "<l1_set index=\"" << line << "\">\n"
+       << xmlNode("tag_check", it->second)                  << "\n"
+       << xmlNode("replace_valid", setConflicts[line])      << "\n"
+       << xmlEnd("l1_set")                                  << "\n";
+  }
 }
 
 count_t L1Cache::totalReads() {
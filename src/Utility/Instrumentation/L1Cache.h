@@ -29,13 +29,16 @@ namespace Instrumentation {
     static void continueOperation(const MemoryBank& bank, MemoryOpcode op,
         MemoryAddr address, bool miss, ChannelID returnChannel);
 
-    static void checkTags(ComponentID bank, MemoryAddr address);
-    static void replaceCacheLine(ComponentID bank, bool isValid, bool isDirty);
+    // `line` is the position in the bank chosen for `address`. It is used to
+    // build a histogram of accesses to each set, to help find hot spots.
+    static void checkTags(ComponentID bank, MemoryAddr address, uint line);
+    static void replaceCacheLine(ComponentID bank, uint line, bool isValid, bool isDirty);
 
     static void updateCoreStats(const MemoryBank& bank,
         ChannelID returnChannel, MemoryOpcode op, bool miss);
 
     static void printSummary(const chip_parameters_t& params);
+    static void printBalance(const chip_parameters_t& params);
     static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
 
     // Some very crude access methods to give energy estimation some concept
@@ -77,6 +80,11 @@ namespace Instrumentation {
     static CounterMap<ComponentID>          replaceCleanLine;
     static CounterMap<ComponentID>          replaceDirtyLine;
 
+    // Histograms of tag checks and of replacements of valid lines, indexed by
+    // cache line position. Summed over all banks.
+    static CounterMap<uint>                 setAccesses;
+    static CounterMap<uint>                 setConflicts;
+
     // Stats stored from the perspective of each input channel of each core.
     // It would make more sense to use output channels (input channels don't
     // write any data), but we do not have this information at the memory bank.
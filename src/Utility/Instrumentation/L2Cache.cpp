@@ -0,0 +1,123 @@
+/*
+ * L2Cache.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "L2Cache.h"
+
+#include "../Instrumentation.h"
+#include "../Parameters.h"
+
+using namespace Instrumentation;
+
+count_t L2Cache::numBroadcasts_;
+count_t L2Cache::numDirectedHits_;
+count_t L2Cache::numDirectedMisses_;
+count_t L2Cache::numNamedBank_;
+
+CounterMap<ComponentID> L2Cache::accesses;
+CounterMap<ComponentID> L2Cache::hits;
+
+static const char* policyNames[] = {
+  "pseudo-random", "address-interleaved", "least-recently-allocated",
+  "least-loaded", "requester affinity"
+};
+
+void L2Cache::reset() {
+  numBroadcasts_ = 0;
+  numDirectedHits_ = 0;
+  numDirectedMisses_ = 0;
+  numNamedBank_ = 0;
+  accesses.clear();
+  hits.clear();
+}
+
+void L2Cache::broadcastRequest() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numBroadcasts_++;
+}
+
+void L2Cache::directedRequest(bool hit) {
+  if (!Instrumentation::collectingStats()) return;
+
+  if (hit)
+    numDirectedHits_++;
+  else
+    numDirectedMisses_++;
+}
+
+void L2Cache::namedBankRequest() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numNamedBank_++;
+}
+
+void L2Cache::access(ComponentID bank, bool hit) {
+  if (!Instrumentation::collectingStats()) return;
+
+  accesses.increment(bank);
+  if (hit)
+    hits.increment(bank);
+}
+
+count_t L2Cache::numRequests() {
+  return numBroadcasts_ + numDirectedHits_ + numDirectedMisses_ + numNamedBank_;
+}
+
+count_t L2Cache::numBroadcasts() {
+  return numBroadcasts_;
+}
+
+count_t L2Cache::numAccesses() {
+  return accesses.numEvents();
+}
+
+count_t L2Cache::numHits() {
+  return hits.numEvents();
+}
+
+void L2Cache::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
+  os << "<l2 tag_directory=\"" << params.tile.l2.tagDirectory
+     << "\" allocation=\"" << params.tile.l2.allocation << "\">\n"
+     << xmlNode("access", accesses.numEvents())      << "\n"
+     << xmlNode("hit", hits.numEvents())             << "\n"
+     << xmlNode("broadcast", numBroadcasts_)         << "\n"
+     << xmlNode("directed_hit", numDirectedHits_)    << "\n"
+     << xmlNode("directed_miss", numDirectedMisses_) << "\n"
+     << xmlNode("named_bank", numNamedBank_)         << "\n"
+     << xmlEnd("l2")                                 << "\n";
+}
+
+void L2Cache::printSummary(const chip_parameters_t& params) {
+  count_t requests = numRequests();
+  if (requests == 0)
+    return;
+
+  const char* policy = (params.tile.l2.allocation < 5)
+                     ? policyNames[params.tile.l2.allocation] : "unknown";
+
+  std::clog <<
+    "L2 cache (" << policy << " allocation):\n" <<
+    "  Accesses:         " << accesses.numEvents() << "\n" <<
+    "    Hit rate:       " << percentage(hits.numEvents(), accesses.numEvents()) << "\n";
+
+  if (!params.tile.l2.tagDirectory)
+    return;
+
+  // Every request which was not broadcast saved a tag check in each of the
+  // other banks.
+  count_t directed = requests - numBroadcasts_;
+  count_t avoided = directed * (params.tile.numMemories - 1);
+
+  std::clog <<
+    "L2 tag directory:\n" <<
+    "  Remote requests:  " << requests << "\n" <<
+    "    Broadcast:      " << numBroadcasts_ << " (" << percentage(numBroadcasts_, requests) << ")\n" <<
+    "    Directed hit:   " << numDirectedHits_ << " (" << percentage(numDirectedHits_, requests) << ")\n" <<
+    "    Directed miss:  " << numDirectedMisses_ << " (" << percentage(numDirectedMisses_, requests) << ")\n" <<
+    "    Named bank:     " << numNamedBank_ << " (" << percentage(numNamedBank_, requests) << ")\n" <<
+    "  Bank tag checks avoided: " << avoided << endl;
+}
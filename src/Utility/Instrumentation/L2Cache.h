@@ -0,0 +1,61 @@
+/*
+ * L2Cache.h
+ *
+ * Requests from other tiles to the memory banks of a tile, when those banks are
+ * acting together as an associative L2 cache.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_INSTRUMENTATION_L2CACHE_H_
+#define SRC_UTILITY_INSTRUMENTATION_L2CACHE_H_
+
+#include "InstrumentationBase.h"
+#include "CounterMap.h"
+#include "../../Datatype/Identifier.h"
+
+namespace Instrumentation {
+
+  class L2Cache : public InstrumentationBase {
+
+  public:
+
+    static void reset();
+
+    // A request was sent to every bank on the tile so they could check their
+    // tags.
+    static void broadcastRequest();
+
+    // The tag directory sent a request straight to one bank: either the bank
+    // holding the line (hit), or the bank which will allocate it.
+    static void directedRequest(bool hit);
+
+    // A request named the bank it must access (e.g. scratchpad mode), so only
+    // that bank was involved.
+    static void namedBankRequest();
+
+    // A cache-mode request was claimed by a bank. On a miss, the bank
+    // allocates the line.
+    static void access(ComponentID bank, bool hit);
+
+    static count_t numRequests();
+    static count_t numBroadcasts();
+    static count_t numAccesses();
+    static count_t numHits();
+
+    static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
+    static void printSummary(const chip_parameters_t& params);
+
+  private:
+
+    static count_t numBroadcasts_, numDirectedHits_, numDirectedMisses_,
+                   numNamedBank_;
+
+    static CounterMap<ComponentID> accesses, hits;
+
+  };
+
+}
+
+#endif /* SRC_UTILITY_INSTRUMENTATION_L2CACHE_H_ */
@@ -0,0 +1,82 @@
+/*
+ * LastLevelCache.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "LastLevelCache.h"
+
+#include "../Instrumentation.h"
+#include "../Parameters.h"
+
+using namespace Instrumentation;
+
+count_t LastLevelCache::numReads_;
+count_t LastLevelCache::numReadHits_;
+count_t LastLevelCache::numWrites_;
+count_t LastLevelCache::numWriteHits_;
+count_t LastLevelCache::numInvalidations_;
+
+void LastLevelCache::reset() {
+  numReads_ = 0;
+  numReadHits_ = 0;
+  numWrites_ = 0;
+  numWriteHits_ = 0;
+  numInvalidations_ = 0;
+}
+
+void LastLevelCache::access(bool read, bool hit) {
+  if (!Instrumentation::collectingStats()) return;
+
+  if (read) {
+    numReads_++;
+    if (hit)
+      numReadHits_++;
+  }
+  else {
+    numWrites_++;
+    if (hit)
+      numWriteHits_++;
+  }
+}
+
+void LastLevelCache::invalidate() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numInvalidations_++;
+}
+
+count_t LastLevelCache::numReads()     {return numReads_;}
+count_t LastLevelCache::numReadHits()  {return numReadHits_;}
+count_t LastLevelCache::numWrites()    {return numWrites_;}
+count_t LastLevelCache::numWriteHits() {return numWriteHits_;}
+
+void LastLevelCache::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
+  os << "<llc size=\"" << params.memory.llc.size << "\" ways=\""
+     << params.memory.llc.associativity << "\">\n"
+     << xmlNode("read", numReads_)                   << "\n"
+     << xmlNode("read_hit", numReadHits_)            << "\n"
+     << xmlNode("write", numWrites_)                 << "\n"
+     << xmlNode("write_hit", numWriteHits_)          << "\n"
+     << xmlNode("invalidate", numInvalidations_)     << "\n"
+     << xmlEnd("llc")                                << "\n";
+}
+
+void LastLevelCache::printSummary(const chip_parameters_t& params) {
+  if (numReads_ == 0 && numWrites_ == 0)
+    return;
+
+  count_t accesses = numReads_ + numWrites_;
+  count_t hits = numReadHits_ + numWriteHits_;
+  count_t offChip = numReads_ - numReadHits_ + numWrites_;
+
+  std::clog <<
+    "Last-level cache:\n" <<
+    "  Accesses:         " << accesses << "\n" <<
+    "    Hit rate:       " << percentage(hits, accesses) << "\n" <<
+    "    Read hit rate:  " << percentage(numReadHits_, numReads_) << "\n" <<
+    "    Write hit rate: " << percentage(numWriteHits_, numWrites_) << "\n" <<
+    "  Off-chip traffic: " << offChip << " requests (" << percentage(offChip, accesses) << ")\n" <<
+    "  Invalidations:    " << numInvalidations_ << endl;
+}
@@ -0,0 +1,44 @@
+/*
+ * LastLevelCache.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_INSTRUMENTATION_LASTLEVELCACHE_H_
+#define SRC_UTILITY_INSTRUMENTATION_LASTLEVELCACHE_H_
+
+#include "InstrumentationBase.h"
+
+namespace Instrumentation {
+
+  class LastLevelCache : public InstrumentationBase {
+
+  public:
+
+    static void reset();
+
+    // A cache line was requested (read) or written back (write).
+    static void access(bool read, bool hit);
+
+    // A copy of a line was discarded because it was updated elsewhere.
+    static void invalidate();
+
+    static count_t numReads();
+    static count_t numReadHits();
+    static count_t numWrites();
+    static count_t numWriteHits();
+
+    static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
+    static void printSummary(const chip_parameters_t& params);
+
+  private:
+
+    static count_t numReads_, numReadHits_, numWrites_, numWriteHits_;
+    static count_t numInvalidations_;
+
+  };
+
+}
+
+#endif /* SRC_UTILITY_INSTRUMENTATION_LASTLEVELCACHE_H_ */
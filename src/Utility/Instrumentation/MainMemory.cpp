@@ -16,42 +16,64 @@ count_t MainMemory::numReads_;
 count_t MainMemory::numWrites_;
 count_t MainMemory::numWordsRead_;
 count_t MainMemory::numWordsWritten_;
+count_t MainMemory::numAtomics_;
 count_t MainMemory::numSends_;
 count_t MainMemory::numReceives_;
+uint MainMemory::numChannels_ = 1;
+CounterMap<uint> MainMemory::channelRequests;
+CounterMap<uint> MainMemory::channelFlits;
 
 void MainMemory::reset() {
   numReads_ = 0;
   numWrites_ = 0;
   numWordsRead_ = 0;
   numWordsWritten_ = 0;
+  numAtomics_ = 0;
   numSends_ = 0;
   numReceives_ = 0;
+  channelRequests.clear();
+  channelFlits.clear();
 }
 
-void MainMemory::read(MemoryAddr address, count_t words) {
+void MainMemory::setNumChannels(uint channels) {
+  numChannels_ = channels;
+}
+
+void MainMemory::read(uint channel, MemoryAddr address, count_t words) {
   if (!Instrumentation::collectingStats()) return;
 
+  channelRequests.increment(channel);
   numReads_++;
   numWordsRead_ += words;
 }
 
-void MainMemory::write(MemoryAddr address, count_t words) {
+void MainMemory::write(uint channel, MemoryAddr address, count_t words) {
   if (!Instrumentation::collectingStats()) return;
 
+  channelRequests.increment(channel);
   numWrites_++;
   numWordsWritten_ += words;
 }
 
-void MainMemory::sendData(NetworkResponse& data) {
+void MainMemory::atomic(uint channel, MemoryAddr address) {
   if (!Instrumentation::collectingStats()) return;
 
+  channelRequests.increment(channel);
+  numAtomics_++;
+}
+
+void MainMemory::sendData(uint channel, NetworkResponse& data) {
+  if (!Instrumentation::collectingStats()) return;
+
+  channelFlits.increment(channel);
   numSends_++;
   // Could also record Hamming distance.
 }
 
-void MainMemory::receiveData(NetworkRequest& data) {
+void MainMemory::receiveData(uint channel, NetworkRequest& data) {
   if (!Instrumentation::collectingStats()) return;
 
+  channelFlits.increment(channel);
   numReceives_++;
   // Could also record Hamming distance.
 }
@@ -60,16 +82,20 @@ count_t MainMemory::numReads()          {return numReads_;}
 count_t MainMemory::numWrites()         {return numWrites_;}
 count_t MainMemory::numWordsRead()      {return numWordsRead_;}
 count_t MainMemory::numWordsWritten()   {return numWordsWritten_;}
+count_t MainMemory::numAtomics()        {return numAtomics_;}
 
 void MainMemory::printStats(const chip_parameters_t& params) {
-  if (numReads_ > 0 || numWrites_ > 0) {
-    count_t accesses = numReads_ + numWrites_;
+  if (numReads_ > 0 || numWrites_ > 0 || numAtomics_ > 0) {
+    count_t accesses = numReads_ + numWrites_ + numAtomics_;
     count_t words = numWordsRead_ + numWordsWritten_;
 
     // Memory can sustain processing one input flit OR one output flit each
-    // clock cycle on each of its interfaces.
+    // clock cycle on each of its interfaces. Interleaved channels each have
+    // their own interface.
+    bool interleaved = (params.memory.interleaving != 0);
     count_t flits = numSends_ + numReceives_;
-    count_t bandwidthAvailable = cyclesStatsCollected() * params.memory.bandwidth;
+    count_t bandwidthAvailable = cyclesStatsCollected() *
+        (interleaved ? numChannels_ : params.memory.bandwidth);
 
     std::clog <<
       "Main memory:\n" <<
@@ -78,6 +104,16 @@ void MainMemory::printStats(const chip_parameters_t& params) {
       "    Words read:     " << numWordsRead_ << " (" << percentage(numWordsRead_, words) << ")\n" <<
       "    Write requests: " << numWrites_ << " (" << percentage(numWrites_, accesses) << ")\n" <<
       "    Words written:  " << numWordsWritten_ << " (" << percentage(numWordsWritten_, words) << ")\n" <<
+      "    Atomics:        " << numAtomics_ << " (" << percentage(numAtomics_, accesses) << ")\n" <<
       "  Bandwidth used:   " << flits << " words (" << percentage(flits, bandwidthAvailable) << ")" << endl;
+
+    if (interleaved) {
+      for (uint channel=0; channel<numChannels_; channel++)
+        std::clog << "    Channel " << channel << ":      "
+            << channelRequests[channel] << " requests ("
+            << percentage(channelRequests[channel], accesses) << "), "
+            << channelFlits[channel] << " words ("
+            << percentage(channelFlits[channel], cyclesStatsCollected()) << " of bandwidth)" << endl;
+    }
   }
 }
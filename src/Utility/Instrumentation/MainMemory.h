@@ -19,23 +19,38 @@ namespace Instrumentation {
 
     static void reset();
 
-    static void read(MemoryAddr address, count_t words);
-    static void write(MemoryAddr address, count_t words);
+    // Record how many independent channels main memory has. Only used if
+    // addresses are interleaved between channels.
+    static void setNumChannels(uint channels);
 
-    static void sendData(NetworkResponse& data);
-    static void receiveData(NetworkRequest& data);
+    // `channel` is the memory controller port which served the request.
+    static void read(uint channel, MemoryAddr address, count_t words);
+    static void write(uint channel, MemoryAddr address, count_t words);
+
+    // An atomic operation (or load-linked/store-conditional) was performed
+    // directly on main memory.
+    static void atomic(uint channel, MemoryAddr address);
+
+    static void sendData(uint channel, NetworkResponse& data);
+    static void receiveData(uint channel, NetworkRequest& data);
 
     static count_t numReads();
     static count_t numWrites();
     static count_t numWordsRead();
     static count_t numWordsWritten();
+    static count_t numAtomics();
 
     static void printStats(const chip_parameters_t& params);
 
   private:
 
     static count_t numReads_, numWrites_, numWordsRead_, numWordsWritten_;
+    static count_t numAtomics_;
     static count_t numSends_, numReceives_;
+    static uint numChannels_;
+
+    // Requests and flits handled by each channel.
+    static CounterMap<uint> channelRequests, channelFlits;
 
   };
 
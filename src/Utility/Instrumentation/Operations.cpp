@@ -45,6 +45,7 @@ CounterMap<ComponentID> Operations::numChanWrites;
 CounterMap<ComponentID> Operations::numMergedChanWrites;
 CounterMap<ComponentID> Operations::numArithOps;
 CounterMap<ComponentID> Operations::numCondOps;
+CounterMap<ComponentID> Operations::numPackedOps;
 
 
 void Operations::init(const chip_parameters_t& params) {
@@ -74,6 +75,7 @@ void Operations::reset() {
   numMergedChanWrites.clear();
   numArithOps.clear();
   numCondOps.clear();
+  numPackedOps.clear();
 }
 
 void Operations::decoded(const ComponentID& core, const DecodedInst& dec) {
@@ -174,6 +176,24 @@ void Operations::executed(const Core& core, const DecodedInst& dec, bool execute
       numArithOps.increment(core.id);
       break;
 
+    case ISA::OP_ADDB:
+    case ISA::OP_ADDH:
+    case ISA::OP_SUBB:
+    case ISA::OP_SUBH:
+    case ISA::OP_ADDUSB:
+    case ISA::OP_ADDSH:
+    case ISA::OP_SUBUSB:
+    case ISA::OP_SUBSH:
+    case ISA::OP_MINUB:
+    case ISA::OP_MAXUB:
+    case ISA::OP_MINH:
+    case ISA::OP_MAXH:
+    case ISA::OP_DOTB:
+    case ISA::OP_DOTH:
+      numArithOps.increment(core.id);
+      numPackedOps.increment(core.id);
+      break;
+
     case ISA::OP_SETEQI:
     case ISA::OP_SETEQI_P:
     case ISA::OP_SETNEI:
@@ -329,6 +349,8 @@ void Operations::dumpEventCounts(std::ostream& os, const chip_parameters_t& para
                      - executedOps[ISA::OP_MULHW]
                      - executedOps[ISA::OP_MULHWU]
                      - executedOps[ISA::OP_MULLW]
+                     - executedOps[ISA::OP_DOTB]
+                     - executedOps[ISA::OP_DOTH]
                      - executedOps[ISA::OP_TSTCHI]
                      - executedOps[ISA::OP_TSTCHI_P]
                      - executedOps[ISA::OP_SELCH]
@@ -336,6 +358,11 @@ void Operations::dumpEventCounts(std::ostream& os, const chip_parameters_t& para
                      - executedOps[ISA::OP_RMTEXECUTE]
                      - executedOps[ISA::OP_RMTNXIPK];
 
+  // Packed operations are also included in the totals above.
+  count_t packed = 0;
+  for (int op = ISA::OP_ADDB; op <= ISA::OP_MAXH; op++)
+    packed += executedOps[(opcode_t)op];
+
   os << xmlNode("hd_in1", hdIn1)            << "\n"
      << xmlNode("hd_in2", hdIn2)            << "\n"
      << xmlNode("hd_out", hdOut)            << "\n"
@@ -343,11 +370,16 @@ void Operations::dumpEventCounts(std::ostream& os, const chip_parameters_t& para
      << xmlNode("total_ops", totalOps)      << "\n"
      << xmlNode("active", totalOps)         << "\n"
      << xmlNode("high_energy", highEnergy)  << "\n"
+     << xmlNode("packed", packed)           << "\n"
      << xmlEnd("alu")                       << "\n";
 
   count_t multiplies = executedOps[ISA::OP_MULHW]
                      + executedOps[ISA::OP_MULHWU]
-                     + executedOps[ISA::OP_MULLW];
+                     + executedOps[ISA::OP_MULLW]
+                     + executedOps[ISA::OP_DOTB]
+                     + executedOps[ISA::OP_DOTH];
+  count_t dotProducts= executedOps[ISA::OP_DOTB]
+                     + executedOps[ISA::OP_DOTH];
   count_t highWord   = executedOps[ISA::OP_MULHW]
                      + executedOps[ISA::OP_MULHWU];
 
@@ -355,6 +387,7 @@ void Operations::dumpEventCounts(std::ostream& os, const chip_parameters_t& para
      << xmlNode("instances", params.totalCores()) << "\n"
      << xmlNode("active", multiplies)   << "\n"
      << xmlNode("high_word", highWord)  << "\n"
+     << xmlNode("packed", dotProducts)  << "\n"
      << xmlEnd("multiplier")            << "\n";
 
   // All operations, including non-ALU ones.
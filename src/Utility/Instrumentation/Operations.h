@@ -51,6 +51,7 @@ public:
   static CounterMap<ComponentID> numMergedChanWrites;
   static CounterMap<ComponentID> numArithOps;
   static CounterMap<ComponentID> numCondOps;
+  static CounterMap<ComponentID> numPackedOps;    // Sub-word SIMD, also in numArithOps
 
 private:
 
@@ -0,0 +1,84 @@
+/*
+ * Reservations.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "Reservations.h"
+
+#include "../Instrumentation.h"
+#include "../Parameters.h"
+
+using namespace Instrumentation;
+
+count_t Reservations::numReservations_;
+count_t Reservations::numEvictions_;
+count_t Reservations::numSuccesses_;
+count_t Reservations::numConflicts_;
+count_t Reservations::numSpurious_;
+count_t Reservations::numUnreserved_;
+
+void Reservations::reset() {
+  numReservations_ = 0;
+  numEvictions_ = 0;
+  numSuccesses_ = 0;
+  numConflicts_ = 0;
+  numSpurious_ = 0;
+  numUnreserved_ = 0;
+}
+
+void Reservations::reserve() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numReservations_++;
+}
+
+void Reservations::evict() {
+  if (!Instrumentation::collectingStats()) return;
+
+  numEvictions_++;
+}
+
+void Reservations::check(Outcome outcome) {
+  if (!Instrumentation::collectingStats()) return;
+
+  switch (outcome) {
+    case SUCCESS:             numSuccesses_++;  break;
+    case FAIL_CONFLICT:       numConflicts_++;  break;
+    case FAIL_EVICTED:        numSpurious_++;   break;
+    case FAIL_NO_RESERVATION: numUnreserved_++; break;
+  }
+}
+
+count_t Reservations::numReservations()     {return numReservations_;}
+count_t Reservations::numChecks()           {return numSuccesses_ + numConflicts_ + numSpurious_ + numUnreserved_;}
+count_t Reservations::numSpuriousFailures() {return numSpurious_;}
+
+void Reservations::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
+  os << "<reservations>\n"
+     << xmlNode("reserve", numReservations_)        << "\n"
+     << xmlNode("evict", numEvictions_)             << "\n"
+     << xmlNode("sc_success", numSuccesses_)        << "\n"
+     << xmlNode("sc_conflict", numConflicts_)       << "\n"
+     << xmlNode("sc_spurious", numSpurious_)        << "\n"
+     << xmlNode("sc_unreserved", numUnreserved_)    << "\n"
+     << xmlEnd("reservations")                      << "\n";
+}
+
+void Reservations::printSummary(const chip_parameters_t& params) {
+  count_t checks = numChecks();
+
+  if (numReservations_ == 0 && checks == 0)
+    return;
+
+  std::clog <<
+    "Load-linked/store-conditional:\n" <<
+    "  Reservations made:   " << numReservations_ << "\n" <<
+    "    Evicted:           " << numEvictions_ << " (" << percentage(numEvictions_, numReservations_) << ")\n" <<
+    "  Store-conditionals:  " << checks << "\n" <<
+    "    Succeeded:         " << numSuccesses_ << " (" << percentage(numSuccesses_, checks) << ")\n" <<
+    "    Failed (conflict): " << numConflicts_ << " (" << percentage(numConflicts_, checks) << ")\n" <<
+    "    Failed (spurious): " << numSpurious_ << " (" << percentage(numSpurious_, checks) << ")\n" <<
+    "    Failed (no LL):    " << numUnreserved_ << " (" << percentage(numUnreserved_, checks) << ")" << endl;
+}
@@ -0,0 +1,59 @@
+/*
+ * Reservations.h
+ *
+ * Load-linked reservations and the outcomes of store-conditionals, in both
+ * memory banks and main memory.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_INSTRUMENTATION_RESERVATIONS_H_
+#define SRC_UTILITY_INSTRUMENTATION_RESERVATIONS_H_
+
+#include "InstrumentationBase.h"
+
+namespace Instrumentation {
+
+  class Reservations : public InstrumentationBase {
+
+  public:
+
+    enum Outcome {
+      SUCCESS,              // Reservation still held
+      FAIL_CONFLICT,        // Reserved data was modified or invalidated
+      FAIL_EVICTED,         // Reservation displaced by other reservations
+      FAIL_NO_RESERVATION   // No reservation on this address
+    };
+
+    static void reset();
+
+    // A load-linked made a reservation.
+    static void reserve();
+
+    // A reservation was displaced because the table was full.
+    static void evict();
+
+    // A store-conditional checked its reservation.
+    static void check(Outcome outcome);
+
+    static count_t numReservations();
+    static count_t numChecks();
+
+    // Store-conditionals which failed only because the reservation table was
+    // too small.
+    static count_t numSpuriousFailures();
+
+    static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
+    static void printSummary(const chip_parameters_t& params);
+
+  private:
+
+    static count_t numReservations_, numEvictions_;
+    static count_t numSuccesses_, numConflicts_, numSpurious_, numUnreserved_;
+
+  };
+
+}
+
+#endif /* SRC_UTILITY_INSTRUMENTATION_RESERVATIONS_H_ */
@@ -9,6 +9,7 @@
 #include <map>
 #include "Stalls.h"
 #include "Operations.h"
+#include "Threads.h"
 #include "../../Exceptions/InvalidOptionException.h"
 #include "../Instrumentation.h"
 #include "../Parameters.h"
@@ -217,8 +218,10 @@ void Stalls::unstall(const ComponentID id, cycle_count_t cycle, StallReason reas
         break;
 
       default:
-        if (collectingStats())
+        if (collectingStats()) {
           timeSpent[reason].increment(id, cycle - startStall[reason][id]);
+          Threads::stalled(id, reason, cycle - startStall[reason][id]);
+        }
         startStall[reason][id] = UNSTALLED;
         break;
     }
@@ -266,6 +269,20 @@ bool Stalls::executionFinished() {
   return endExecutionCalled;
 }
 
+bool Stalls::isStalled(const ComponentID id, StallReason reason) {
+  auto it = stallReason.find(id);
+  uint reasons = (it == stallReason.end()) ? NOT_STALLED : it->second;
+
+  switch (reason) {
+    case NOT_STALLED:
+      return reasons == NOT_STALLED;
+    case STALL_ANY:
+      return (reasons & ~(1 << IDLE)) != 0;
+    default:
+      return (reasons & (1 << reason)) != 0;
+  }
+}
+
 count_t Stalls::stalledComponents() {
   return numStalled;
 }
@@ -366,6 +383,7 @@ void Stalls::printStats(const chip_parameters_t& params) {
           printInstrStat("    numMergedChanWrites", id, Operations::numMergedChanWrites);
           printInstrStat("    numArithOps        ", id, Operations::numArithOps);
           printInstrStat("    numCondOps         ", id, Operations::numCondOps);
+          printInstrStat("    numPackedOps       ", id, Operations::numPackedOps);
           clog << "\n";
         }
       }
@@ -59,6 +59,11 @@ public:
 
   static bool executionFinished();
 
+  // Tell whether a component is currently stalled for the given reason.
+  // NOT_STALLED asks whether it is doing useful work, and STALL_ANY whether it
+  // is stalled for any reason other than being idle.
+  static bool isStalled(const ComponentID id, StallReason reason);
+
   static count_t stalledComponents();
   static cycle_count_t cyclesIdle();
 
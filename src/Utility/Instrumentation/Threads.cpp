@@ -0,0 +1,176 @@
+/*
+ * Threads.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "Threads.h"
+
+#include "Stalls.h"
+#include "../Instrumentation.h"
+#include "../Parameters.h"
+#include "../../Datatype/DecodedInst.h"
+#include "../../Tile/Core/Core.h"
+
+using namespace Instrumentation;
+
+uint Threads::numThreads;
+std::vector<CounterMap<ComponentID>> Threads::instructions_;
+std::vector<CounterMap<ComponentID>> Threads::cycles_;
+std::vector<std::vector<CounterMap<ComponentID>>> Threads::stallCycles_;
+CounterMap<ComponentID> Threads::switches_;
+std::map<ComponentID, ThreadIndex> Threads::running_;
+std::map<ComponentID, cycle_count_t> Threads::runningSince_;
+
+void Threads::init(const chip_parameters_t& params) {
+  InstrumentationBase::init(params);
+
+  numThreads = params.tile.core.threads;
+
+  instructions_.assign(numThreads, CounterMap<ComponentID>());
+  cycles_.assign(numThreads, CounterMap<ComponentID>());
+  stallCycles_.assign(numThreads,
+      std::vector<CounterMap<ComponentID>>(Stalls::NUM_STALL_REASONS));
+
+  for (uint col = 1; col <= params.numComputeTiles.width; col++) {
+    for (uint row = 1; row <= params.numComputeTiles.height; row++) {
+      for (uint core=0; core<params.tile.numCores; core++) {
+        ComponentID id(col, row, core);
+        running_[id] = 0;
+        runningSince_[id] = currentCycle();
+      }
+    }
+  }
+}
+
+void Threads::reset() {
+  for (uint thread=0; thread<numThreads; thread++) {
+    instructions_[thread].clear();
+    cycles_[thread].clear();
+    for (uint reason=0; reason<Stalls::NUM_STALL_REASONS; reason++)
+      stallCycles_[thread][reason].clear();
+  }
+  switches_.clear();
+
+  for (auto it=runningSince_.begin(); it!=runningSince_.end(); ++it)
+    it->second = currentCycle();
+}
+
+void Threads::start() {
+  if (collectingStats())
+    return;
+
+  // Don't count any time before logging started.
+  for (auto it=runningSince_.begin(); it!=runningSince_.end(); ++it)
+    it->second = currentCycle();
+}
+
+void Threads::stop() {
+  if (!collectingStats())
+    return;
+
+  for (auto it=running_.begin(); it!=running_.end(); ++it)
+    flush(it->first);
+}
+
+void Threads::switched(const ComponentID& core, ThreadIndex from, ThreadIndex to) {
+  if (collectingStats()) {
+    flush(core);
+    switches_.increment(core);
+  }
+
+  running_[core] = to;
+  runningSince_[core] = currentCycle();
+}
+
+void Threads::executed(const Core& core, const DecodedInst& inst, bool executed) {
+  if (!Instrumentation::collectingStats()) return;
+
+  if (executed)
+    instructions_[inst.thread()].increment(core.id);
+}
+
+void Threads::stalled(const ComponentID& core, uint reason, cycle_count_t cycles) {
+  if (!Instrumentation::collectingStats()) return;
+
+  // Memories are also tracked by Stalls.
+  auto it = running_.find(core);
+  if (it == running_.end())
+    return;
+
+  stallCycles_[it->second][reason].increment(core, cycles);
+}
+
+void Threads::flush(const ComponentID& core) {
+  cycle_count_t now = currentCycle();
+  cycles_[running_[core]].increment(core, now - runningSince_[core]);
+  runningSince_[core] = now;
+}
+
+void Threads::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
+  stop();
+
+  for (auto it=running_.begin(); it!=running_.end(); ++it) {
+    ComponentID id = it->first;
+    if (switches_[id] == 0)
+      continue;
+
+    os << "<threads core=\"" << id << "\">\n"
+       << xmlNode("switches", switches_[id]) << "\n";
+
+    for (uint thread=0; thread<numThreads; thread++) {
+      os << "\t<thread id=\"" << thread << "\">\n"
+         << xmlNode("instructions", instructions_[thread][id], "\t\t") << "\n"
+         << xmlNode("cycles", cycles_[thread][id], "\t\t") << "\n"
+         << xmlNode("instruction_stall", stallCycles_[thread][Stalls::STALL_INSTRUCTIONS][id], "\t\t") << "\n"
+         << xmlNode("memory_data_stall", stallCycles_[thread][Stalls::STALL_MEMORY_DATA][id], "\t\t") << "\n"
+         << xmlNode("core_data_stall", stallCycles_[thread][Stalls::STALL_CORE_DATA][id], "\t\t") << "\n"
+         << xmlNode("bypass_stall", stallCycles_[thread][Stalls::STALL_FORWARDING][id], "\t\t") << "\n"
+         << xmlNode("fetch_stall", stallCycles_[thread][Stalls::STALL_FETCH][id], "\t\t") << "\n"
+         << xmlNode("output_stall", stallCycles_[thread][Stalls::STALL_OUTPUT][id], "\t\t") << "\n"
+         << "\t" << xmlEnd("thread") << "\n";
+    }
+
+    os << xmlEnd("threads") << "\n";
+  }
+}
+
+void Threads::printSummary(const chip_parameters_t& params) {
+  if (switches_.numEvents() == 0)
+    return;
+
+  stop();
+
+  using std::clog;
+
+  clog << "Hardware threads:" << endl;
+  clog << "  Core\t\tThread\tInsts\tCycles\tStalled (inst|mem|core|fwd|fetch|out)" << endl;
+
+  for (auto it=running_.begin(); it!=running_.end(); ++it) {
+    ComponentID id = it->first;
+    if (switches_[id] == 0)
+      continue;
+
+    for (uint thread=0; thread<numThreads; thread++) {
+      std::vector<CounterMap<ComponentID>>& stalls = stallCycles_[thread];
+      count_t totalStalled = 0;
+      for (uint reason=0; reason<Stalls::NUM_STALL_REASONS; reason++)
+        if (reason != Stalls::IDLE && reason != Stalls::STALL_ANY)
+          totalStalled += stalls[reason][id];
+
+      clog << "  " << id << "\t" << thread << "\t" <<
+        instructions_[thread][id] << "\t" <<
+        cycles_[thread][id] << "\t" <<
+        percentage(totalStalled, cycles_[thread][id]) << "\t(" <<
+        percentage(stalls[Stalls::STALL_INSTRUCTIONS][id], totalStalled) << "|" <<
+        percentage(stalls[Stalls::STALL_MEMORY_DATA][id], totalStalled) << "|" <<
+        percentage(stalls[Stalls::STALL_CORE_DATA][id], totalStalled) << "|" <<
+        percentage(stalls[Stalls::STALL_FORWARDING][id], totalStalled) << "|" <<
+        percentage(stalls[Stalls::STALL_FETCH][id], totalStalled) << "|" <<
+        percentage(stalls[Stalls::STALL_OUTPUT][id], totalStalled) << ")" << endl;
+    }
+
+    clog << "    Thread switches: " << switches_[id] << endl;
+  }
+}
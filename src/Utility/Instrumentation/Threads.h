@@ -0,0 +1,72 @@
+/*
+ * Threads.h
+ *
+ * Activity of each hardware thread within each core: instructions executed,
+ * cycles spent holding the core, and cycles spent stalled while holding it.
+ *
+ * Only cores which switched threads at least once are reported.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_INSTRUMENTATION_THREADS_H_
+#define SRC_UTILITY_INSTRUMENTATION_THREADS_H_
+
+#include <map>
+#include <vector>
+#include "InstrumentationBase.h"
+#include "CounterMap.h"
+
+class Core;
+class DecodedInst;
+
+namespace Instrumentation {
+
+  class Threads : public InstrumentationBase {
+
+  public:
+
+    static void init(const chip_parameters_t& params);
+    static void reset();
+    static void start();
+    static void stop();
+
+    // The core stopped running thread `from` and started running thread `to`.
+    static void switched(const ComponentID& core, ThreadIndex from, ThreadIndex to);
+
+    // An instruction finished on the core.
+    static void executed(const Core& core, const DecodedInst& inst, bool executed);
+
+    // The core was stalled for `cycles` cycles for the given reason (see
+    // Stalls::StallReason). Attributed to the thread running at the time.
+    static void stalled(const ComponentID& core, uint reason, cycle_count_t cycles);
+
+    static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
+    static void printSummary(const chip_parameters_t& params);
+
+  private:
+
+    // Add the cycles since the last switch to the running thread's total.
+    static void flush(const ComponentID& core);
+
+    static uint numThreads;
+
+    // Indexed by thread, then by core.
+    static std::vector<CounterMap<ComponentID>> instructions_;
+    static std::vector<CounterMap<ComponentID>> cycles_;
+
+    // Indexed by thread, then by stall reason, then by core.
+    static std::vector<std::vector<CounterMap<ComponentID>>> stallCycles_;
+
+    static CounterMap<ComponentID> switches_;
+
+    // The thread each core is running, and when it started running it.
+    static std::map<ComponentID, ThreadIndex> running_;
+    static std::map<ComponentID, cycle_count_t> runningSince_;
+
+  };
+
+}
+
+#endif /* SRC_UTILITY_INSTRUMENTATION_THREADS_H_ */
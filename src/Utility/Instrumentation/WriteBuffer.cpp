@@ -0,0 +1,95 @@
+/*
+ * WriteBuffer.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "WriteBuffer.h"
+
+#include "../Instrumentation.h"
+#include "../Parameters.h"
+
+using namespace Instrumentation;
+
+count_t WriteBuffer::numStores_;
+count_t WriteBuffer::numCoalesced_;
+count_t WriteBuffer::numLoads_;
+count_t WriteBuffer::numForwarded_;
+count_t WriteBuffer::numDrains_;
+count_t WriteBuffer::numOpportunisticDrains_;
+count_t WriteBuffer::occupancySum_;
+count_t WriteBuffer::maxOccupancy_;
+
+void WriteBuffer::reset() {
+  numStores_ = 0;
+  numCoalesced_ = 0;
+  numLoads_ = 0;
+  numForwarded_ = 0;
+  numDrains_ = 0;
+  numOpportunisticDrains_ = 0;
+  occupancySum_ = 0;
+  maxOccupancy_ = 0;
+}
+
+void WriteBuffer::store(bool coalesced, uint occupancy) {
+  if (!Instrumentation::collectingStats()) return;
+
+  numStores_++;
+  if (coalesced)
+    numCoalesced_++;
+
+  occupancySum_ += occupancy;
+  if (occupancy > maxOccupancy_)
+    maxOccupancy_ = occupancy;
+}
+
+void WriteBuffer::load(bool forwarded) {
+  if (!Instrumentation::collectingStats()) return;
+
+  numLoads_++;
+  if (forwarded)
+    numForwarded_++;
+}
+
+void WriteBuffer::drain(bool opportunistic) {
+  if (!Instrumentation::collectingStats()) return;
+
+  numDrains_++;
+  if (opportunistic)
+    numOpportunisticDrains_++;
+}
+
+count_t WriteBuffer::numStores()    {return numStores_;}
+count_t WriteBuffer::numCoalesced() {return numCoalesced_;}
+count_t WriteBuffer::numForwarded() {return numForwarded_;}
+
+void WriteBuffer::dumpEventCounts(std::ostream& os, const chip_parameters_t& params) {
+  os << "<write_buffer entries=\"" << params.tile.memory.writeBuffer << "\">\n"
+     << xmlNode("store", numStores_)                       << "\n"
+     << xmlNode("coalesced", numCoalesced_)                << "\n"
+     << xmlNode("load", numLoads_)                         << "\n"
+     << xmlNode("forwarded", numForwarded_)                << "\n"
+     << xmlNode("drain", numDrains_)                       << "\n"
+     << xmlNode("opportunistic_drain", numOpportunisticDrains_) << "\n"
+     << xmlNode("occupancy", occupancySum_)                << "\n"
+     << xmlEnd("write_buffer")                             << "\n";
+}
+
+void WriteBuffer::printSummary(const chip_parameters_t& params) {
+  if (params.tile.memory.writeBuffer == 0)
+    return;
+
+  double averageOccupancy = (numStores_ == 0) ? 0.0
+                          : (double)occupancySum_ / numStores_;
+
+  std::clog <<
+    "Write buffers:\n" <<
+    "  Stores buffered:   " << numStores_ << "\n" <<
+    "    Coalesced:       " << numCoalesced_ << " (" << percentage(numCoalesced_, numStores_) << ")\n" <<
+    "  Occupancy:         " << averageOccupancy << " lines average, " << maxOccupancy_ << " max\n" <<
+    "  Loads to buffered lines: " << numLoads_ << "\n" <<
+    "    Forwarded:       " << numForwarded_ << " (" << percentage(numForwarded_, numLoads_) << ")\n" <<
+    "  Lines drained:     " << numDrains_ << "\n" <<
+    "    Opportunistic:   " << numOpportunisticDrains_ << " (" << percentage(numOpportunisticDrains_, numDrains_) << ")" << endl;
+}
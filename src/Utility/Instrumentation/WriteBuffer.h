@@ -0,0 +1,54 @@
+/*
+ * WriteBuffer.h
+ *
+ * Activity in the memory banks' write buffers.
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_INSTRUMENTATION_WRITEBUFFER_H_
+#define SRC_UTILITY_INSTRUMENTATION_WRITEBUFFER_H_
+
+#include "InstrumentationBase.h"
+
+namespace Instrumentation {
+
+  class WriteBuffer : public InstrumentationBase {
+
+  public:
+
+    static void reset();
+
+    // A store was added to a write buffer. `occupancy` is the number of lines
+    // buffered once the store has been added.
+    static void store(bool coalesced, uint occupancy);
+
+    // A load accessed a line with buffered data. Either all of its data was
+    // found in the buffer, or the line had to be drained first.
+    static void load(bool forwarded);
+
+    // A line was written from a write buffer into the cache. Opportunistic
+    // drains use cycles where the bank would otherwise be idle.
+    static void drain(bool opportunistic);
+
+    static count_t numStores();
+    static count_t numCoalesced();
+    static count_t numForwarded();
+
+    static void dumpEventCounts(std::ostream& os, const chip_parameters_t& params);
+    static void printSummary(const chip_parameters_t& params);
+
+  private:
+
+    static count_t numStores_, numCoalesced_, numLoads_, numForwarded_,
+                   numDrains_, numOpportunisticDrains_;
+
+    // Occupancy is sampled each time a store arrives.
+    static count_t occupancySum_, maxOccupancy_;
+
+  };
+
+}
+
+#endif /* SRC_UTILITY_INSTRUMENTATION_WRITEBUFFER_H_ */
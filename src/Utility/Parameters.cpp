@@ -103,14 +103,41 @@ GETTER_SETTER(IPKFIFOSize,              tile.core.ipkFIFO.size);
 GETTER_SETTER(IPKCacheSize,             tile.core.cache.size);
 GETTER_SETTER(IPKCacheNumTags,          tile.core.cache.numTags);
 GETTER_SETTER(MaxIPKSize,               tile.core.cache.maxIPKSize);
+GETTER_SETTER(IPKFetchQueueSize,        tile.core.cache.fetchQueueSize);
+GETTER_SETTER(IPKPrefetchEntries,       tile.core.cache.prefetchEntries);
+GETTER_SETTER(IPKCacheWays,             tile.core.cache.ways);
+GETTER_SETTER(IPKCacheReplacement,      tile.core.cache.replacement);
+GETTER_SETTER(CoreThreads,              tile.core.threads);
+GETTER_SETTER(ALULatency,               tile.core.alu.latency);
+GETTER_SETTER(ALUInterval,              tile.core.alu.interval);
+GETTER_SETTER(ShifterLatency,           tile.core.shifter.latency);
+GETTER_SETTER(ShifterInterval,          tile.core.shifter.interval);
+GETTER_SETTER(MultiplierLatency,        tile.core.multiplier.latency);
+GETTER_SETTER(MultiplierInterval,       tile.core.multiplier.interval);
 GETTER_SETTER(ChannelMapTableSize,      tile.core.channelMapTable.size);
+GETTER_SETTER(BankHash,                 tile.core.channelMapTable.bankHash);
+GETTER_SETTER(BankPermutation,          tile.core.channelMapTable.bankPermutation);
 GETTER_SETTER(DirectorySize,            tile.directory.size);
+GETTER_SETTER(L2TagDirectory,           tile.l2.tagDirectory);
+GETTER_SETTER(L2Allocation,             tile.l2.allocation);
+GETTER_SETTER(DMABuffers,               tile.dma.buffers);
 GETTER_SETTER(MemoryBankLatency,        tile.memory.latency);
 GETTER_SETTER(MemoryBankSize,           tile.memory.size);
 GETTER_SETTER(MemoryHitUnderMiss,       tile.memory.hitUnderMiss);
+GETTER_SETTER(MemorySetHash,            tile.memory.setHash);
+GETTER_SETTER(MemorySetPermutation,     tile.memory.setPermutation);
+GETTER_SETTER(MemoryWriteBuffer,        tile.memory.writeBuffer);
+GETTER_SETTER(MemoryReservations,       tile.memory.reservations);
 GETTER_SETTER(MainMemoryLatency,        memory.latency);
 GETTER_SETTER(MainMemorySize,           memory.size);
 GETTER_SETTER(MainMemoryBandwidth,      memory.bandwidth);
+GETTER_SETTER(MainMemoryCoherence,      memory.coherence);
+GETTER_SETTER(MainMemoryReservations,   memory.reservations);
+GETTER_SETTER(MainMemoryInterleaving,   memory.interleaving);
+GETTER_SETTER(LLCSize,                  memory.llc.size);
+GETTER_SETTER(LLCAssociativity,         memory.llc.associativity);
+GETTER_SETTER(LLCReplacement,           memory.llc.replacement);
+GETTER_SETTER(LLCLatency,               memory.llc.latency);
 GETTER_SETTER(CoreNumInputChannels,     tile.core.numInputChannels);
 GETTER_SETTER(CoreInputFIFOSize,        tile.core.inputFIFO.size);
 GETTER_SETTER(CoreOutputFIFOSize,       tile.core.outputFIFO.size);
@@ -198,18 +225,82 @@ void initialiseParameters() {
                getIPKCacheNumTags, setIPKCacheNumTags, 16);
   abbreviations["ipk-cache-tags"] = "core-ipk-cache-num-tags";
 
+  addParameter("core-ipk-cache-ways", "IPK cache associativity",
+               "0 = fully-associative, filled in FIFO order. Otherwise, the cache is\n\tsplit into blocks of max-ipk-size instructions, each holding one\n\tpacket, and this is the number of blocks per set. The number of tags is\n\tthen the number of blocks.",
+               getIPKCacheWays, setIPKCacheWays, 0);
+
+  addParameter("core-ipk-cache-replacement", "IPK cache replacement policy",
+               "Set-associative IPK cache only. 0 = LRU, 1 = tree pseudo-LRU.",
+               getIPKCacheReplacement, setIPKCacheReplacement, 0);
+
   addParameter("max-ipk-size", "Maximum IPK size",
                "Maximum instruction packet size.",
                getMaxIPKSize, setMaxIPKSize, 8); // Default = cache line size?
 
+  addParameter("core-ipk-fetch-queue", "IPK fetch queue size",
+               "Number of instruction packet fetches a core can have waiting to be\n\tserved before its decode stage stalls.",
+               getIPKFetchQueueSize, setIPKFetchQueueSize, 1);
+
+  addParameter("core-ipk-prefetch-entries", "IPK prefetcher entries",
+               "Number of packets whose successors are remembered by the next-packet\n\tprefetcher. Must be a power of two. 0 disables prefetching. Prefetch\n\taccuracy and stall cycles saved are only reported when this is non-zero.",
+               getIPKPrefetchEntries, setIPKPrefetchEntries, 0);
+
+  addParameter("core-threads", "Hardware threads",
+               "Number of hardware thread contexts in each core. Each thread has its\n\town registers and predicate, and the core switches to another thread\n\twhen the current one stalls waiting for a network input. With more\n\tthan one thread, core-ipk-fetch-queue is raised to at least 2.",
+               getCoreThreads, setCoreThreads, 1);
+
+  addParameter("core-alu-latency", "ALU latency",
+               "Cycles taken by logic, comparison and addition operations.",
+               getALULatency, setALULatency, 1);
+
+  addParameter("core-alu-interval", "ALU initiation interval",
+               "Minimum cycles between starting logic, comparison and addition\n\toperations. A unit whose interval is less than its latency is\n\tpipelined: later instructions may execute while it works, and only\n\tthose which need its result wait for it.",
+               getALUInterval, setALUInterval, 1);
+
+  addParameter("core-shift-latency", "Shifter latency",
+               "Cycles taken by shift and count-leading-zeros operations.",
+               getShifterLatency, setShifterLatency, 1);
+
+  addParameter("core-shift-interval", "Shifter initiation interval",
+               "Minimum cycles between starting shift and count-leading-zeros\n\toperations. Pipelined if less than the latency.",
+               getShifterInterval, setShifterInterval, 1);
+
+  addParameter("core-multiply-latency", "Multiplier latency",
+               "Cycles taken by multiplications.",
+               getMultiplierLatency, setMultiplierLatency, 2);
+
+  addParameter("core-multiply-interval", "Multiplier initiation interval",
+               "Minimum cycles between starting multiplications. Pipelined if less\n\tthan the latency.",
+               getMultiplierInterval, setMultiplierInterval, 2);
+
   addParameter("core-channel-map-table-size", "Channel map table size",
                "Number of entries in the core's channel map table.",
                getChannelMapTableSize, setChannelMapTableSize, 15); // 1 channel reserved
 
+  addParameter("memory-group-bank-hash", "Memory group bank hash",
+               "How addresses are spread across the banks of a memory group.\n\t0 = low line address bits, 1 = XOR-fold, 2 = prime modulo,\n\t3 = bit permutation, 4 = group XOR (same as 0 for banks).",
+               getBankHash, setBankHash, 0);
+
+  addParameter("memory-group-bank-permutation", "Memory group bank permutation",
+               "Bank hash 3 only. Nibble i holds the line address bit used as bit i of\n\tthe bank index.",
+               getBankPermutation, setBankPermutation, 0x210);
+
   addParameter("directory-size", "Directory size",
                "Number of entries in the L1->L2 directory mapping.",
                getDirectorySize, setDirectorySize, 16);
 
+  addParameter("l2-tag-directory", "L2 tag directory",
+               "Whether each tile keeps a copy of its banks' tags, so requests from\n\tother tiles go to one bank instead of being broadcast to all.",
+               getL2TagDirectory, setL2TagDirectory, 0);
+
+  addParameter("l2-allocation", "L2 allocation policy",
+               "Which bank allocates a line which misses in a tile's L2.\n\t0 = pseudo-random, 1 = address-interleaved (memory-group-bank-hash),\n\t2 = least-recently-allocated, 3 = least-loaded, 4 = affinity with requesting tile.",
+               getL2Allocation, setL2Allocation, 0);
+
+  addParameter("dma-buffers", "DMA engine buffers",
+               "Number of cache lines each tile's DMA engine can have in flight at once.\n\tBanks and buffers together may not exceed 16.",
+               getDMABuffers, setDMABuffers, 4);
+
   addParameter("memory-bank-latency", "Memory bank latency",
                "Latency (in cycles) of the on-tile memory banks.",
                getMemoryBankLatency, setMemoryBankLatency, 3);
@@ -223,6 +314,22 @@ void initialiseParameters() {
                getMemoryHitUnderMiss, setMemoryHitUnderMiss, 1);
   abbreviations["hit-under-miss"] = "memory-bank-hit-under-miss";
 
+  addParameter("memory-bank-set-hash", "Memory bank set hash",
+               "How cache lines are mapped to positions within a memory bank.\n\tValues as for memory-group-bank-hash. 4 = line address bits above the\n\tbank bits, XORed with the bank bits.",
+               getMemorySetHash, setMemorySetHash, 4);
+
+  addParameter("memory-bank-set-permutation", "Memory bank set permutation",
+               "Set hash 3 only. Nibble i holds the line address bit used as bit i of\n\tthe cache line index. Index bits above bit 7 are not permuted.",
+               getMemorySetPermutation, setMemorySetPermutation, 0xA9876543);
+
+  addParameter("memory-bank-write-buffer", "Memory bank write buffer",
+               "Number of cache lines of stores each memory bank can hold before\n\twriting them to the cache. 0 disables the write buffer.",
+               getMemoryWriteBuffer, setMemoryWriteBuffer, 0);
+
+  addParameter("memory-bank-reservations", "Memory bank reservations",
+               "Maximum number of load-linked reservations each memory bank can hold.\n\tEach requester holds at most one. 0 = no limit.",
+               getMemoryReservations, setMemoryReservations, 0);
+
   addParameter("main-memory-latency", "Main memory latency", "",
                getMainMemoryLatency, setMainMemoryLatency, 20);
 
@@ -231,9 +338,35 @@ void initialiseParameters() {
                getMainMemorySize, setMainMemorySize, 256 * 1024 * 1024);
 
   addParameter("main-memory-bandwidth", "Main memory bandwidth",
-               "Off-chip memory bandwidth in words per cycle. Upper bound is the number\n\tof memory controllers.",
+               "Off-chip memory bandwidth in words per cycle. Upper bound is the number\n\tof memory controllers. With interleaving, this limits each channel\n\tseparately.",
                getMainMemoryBandwidth, setMainMemoryBandwidth, 1);
 
+  addParameter("main-memory-coherence", "Main memory coherence protocol",
+               "Hardware coherence between tiles' caches for data backed by main memory.\n\t0 = none (software-managed), 1 = MSI directory, 2 = MESI directory.",
+               getMainMemoryCoherence, setMainMemoryCoherence, 0);
+
+  addParameter("main-memory-reservations", "Main memory reservations",
+               "Maximum number of load-linked reservations main memory can hold, for\n\tatomic operations performed at the memory controllers. 0 = no limit.",
+               getMainMemoryReservations, setMainMemoryReservations, 0);
+
+  addParameter("main-memory-interleaving", "Main memory interleaving",
+               "How addresses are divided between memory channels, one per memory\n\tcontroller. 0 = none (each tile uses its nearest controller),\n\t1 = cache line, 2 = page, 3 = XOR-hashed cache line.",
+               getMainMemoryInterleaving, setMainMemoryInterleaving, 0);
+
+  addParameter("llc-size", "Last-level cache size",
+               "Size in bytes of the cache slice at each memory controller. 0 disables\n\tthe last-level cache.",
+               getLLCSize, setLLCSize, 0);
+
+  addParameter("llc-associativity", "Last-level cache associativity", "",
+               getLLCAssociativity, setLLCAssociativity, 8);
+
+  addParameter("llc-replacement", "Last-level cache replacement policy",
+               "0 = LRU, 1 = FIFO, 2 = pseudo-random.",
+               getLLCReplacement, setLLCReplacement, 0);
+
+  addParameter("llc-latency", "Last-level cache latency", "",
+               getLLCLatency, setLLCLatency, 10);
+
   addParameter("core-num-input-channels", "Core number of input channels",
                "Total number of input channels, including both instruction and data\n\tinputs.",
                getCoreNumInputChannels, setCoreNumInputChannels, 8);
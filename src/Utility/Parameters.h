@@ -60,8 +60,16 @@ typedef struct {
   size_t size;      // Measured in words
 } scratchpad_parameters_t;
 
+typedef struct {
+  uint   latency;   // Cycles from issue until the result can be used
+  uint   interval;  // Cycles between issuing operations. Pipelined if less
+                    // than latency, otherwise holds the execute stage
+} functional_unit_parameters_t;
+
 typedef struct {
   size_t size;      // Measured in entries (number of output channels)
+  uint   bankHash;  // Choice of bank within a memory group. See AddressHash.
+  uint   bankPermutation; // Bit selection for bankHash = 3
 } channel_map_table_parameters_t;
 
 typedef struct {
@@ -74,14 +82,22 @@ typedef struct {
   bandwidth_t bandwidth; // Measured in flits/cycle. For writing only.
   size_t numTags;
   size_t maxIPKSize;// Maximum number of instructions in a packet
+  size_t fetchQueueSize;  // Fetch requests which can wait to be served
+  size_t prefetchEntries; // Packets tracked by the prefetcher (0 = disabled)
+  size_t ways;      // 0 = fully-associative FIFO, else set-associative
+  uint   replacement; // Set-associative only: 0 = LRU, 1 = tree pseudo-LRU
 } cache_parameters_t;
 
 typedef struct {
   size_t numInputChannels; // Includes both instructions and data
+  size_t threads;          // Hardware thread contexts
 
   cache_parameters_t              cache;
   register_file_parameters_t      registerFile;
   scratchpad_parameters_t         scratchpad;
+  functional_unit_parameters_t    alu;        // Logic, comparison, add
+  functional_unit_parameters_t    shifter;    // Shifts, count leading zeros
+  functional_unit_parameters_t    multiplier;
   channel_map_table_parameters_t  channelMapTable;
   fifo_parameters_t               ipkFIFO;
   fifo_parameters_t               inputFIFO;
@@ -96,6 +112,10 @@ typedef struct {
   uint   latency;       // Total core -> memory -> core latency, in cycles
   bool   hitUnderMiss;  // Is the bank able to serve a new request while waiting
                         // for data for a different request?
+  size_t writeBuffer;   // Measured in cache lines. 0 = no write buffer
+  uint   setHash;       // Choice of cache line for an address. See AddressHash.
+  uint   setPermutation;// Bit selection for setHash = 3
+  uint   reservations;  // Maximum load-linked reservations. 0 = one per requester
 
   fifo_parameters_t inputFIFO;
   fifo_parameters_t outputFIFO;
@@ -107,6 +127,18 @@ typedef struct {
   size_t size;      // Measured in entries
 } directory_parameters_t;
 
+typedef struct {
+  bool   tagDirectory;  // Send remote requests straight to the bank holding
+                        // the line, rather than broadcasting to all banks
+  uint   allocation;    // Bank to allocate missing lines in: 0 = random,
+                        // 1 = address-interleaved, 2 = least-recently-
+                        // allocated, 3 = least-loaded, 4 = requester affinity
+} l2_parameters_t;
+
+typedef struct {
+  uint   buffers;       // Cache lines which can be fetched at once
+} dma_parameters_t;
+
 typedef struct {
   fifo_parameters_t fifo;
 } router_parameters_t;
@@ -118,18 +150,32 @@ typedef struct {
   core_parameters_t core;
   memory_bank_parameters_t memory;
   directory_parameters_t directory;
+  l2_parameters_t l2;
+  dma_parameters_t dma;
 
   size_t mcastNetInputs() const;
   size_t mcastNetOutputs() const;
   size_t totalComponents() const;
 } tile_parameters_t;
 
+typedef struct {
+  size_t size;          // Measured in bytes. 0 = no last-level cache
+  uint   associativity;
+  uint   replacement;   // 0 = LRU, 1 = FIFO, 2 = pseudo-random
+  uint   latency;       // Cycles between receiving a request and sending a response
+} last_level_cache_parameters_t;
+
 // Some duplication between this and memory_bank_parameters_t. Merge?
 typedef struct {
   size_t size;          // Measured in bytes
   size_t cacheLineSize; // Measured in bytes
   uint   latency;       // Cycles between receiving a request and sending a response
   uint   bandwidth;     // Measured in words per cycle
+  uint   coherence;     // 0 = software-managed, 1 = MSI, 2 = MESI
+  uint   reservations;  // Maximum load-linked reservations. 0 = one per requester
+  uint   interleaving;  // 0 = nearest controller, 1 = line, 2 = page, 3 = XOR-hashed lines
+
+  last_level_cache_parameters_t llc; // One slice at each memory controller
 
   size_t log2CacheLineSize() const;
 } main_memory_parameters_t;
@@ -202,7 +202,8 @@ void CodeLoader::loadFromReader(FileReader* reader, Chip& chip) {
       appLoaderInitialized = true;
 
     chip.storeData(blocks[i]);
-    delete &(blocks[i].payload());
+    if (blocks[i].hasPayload())
+      delete &(blocks[i].payload());
   }
 
   delete reader;
@@ -13,6 +13,18 @@ vector<Word>& DataBlock::payload() const {
   return *data_;
 }
 
+const uint32_t* DataBlock::rawData() const {
+  return raw_;
+}
+
+size_t DataBlock::rawSize() const {
+  return rawSize_;
+}
+
+bool DataBlock::hasPayload() const {
+  return data_ != NULL;
+}
+
 ComponentID DataBlock::component() const {
   return component_;
 }
@@ -25,11 +37,32 @@ bool DataBlock::readOnly() const {
   return readOnly_;
 }
 
-DataBlock::DataBlock(vector<Word>* data, const ComponentID& component, int position, bool readOnly) :
+bool DataBlock::executable() const {
+  return executable_;
+}
+
+DataBlock::DataBlock(vector<Word>* data, const ComponentID& component,
+                     int position, bool readOnly, bool executable) :
   data_(data),
+  raw_(NULL),
+  rawSize_(0),
+  component_(component),
+  position_(position),
+  readOnly_(readOnly),
+  executable_(executable) {
+
+}
+
+DataBlock::DataBlock(const uint32_t* data, size_t words,
+                     const ComponentID& component, int position, bool readOnly,
+                     bool executable) :
+  data_(NULL),
+  raw_(data),
+  rawSize_(words),
   component_(component),
   position_(position),
-  readOnly_(readOnly) {
+  readOnly_(readOnly),
+  executable_(executable) {
 
 }
 
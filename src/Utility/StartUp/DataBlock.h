@@ -11,6 +11,7 @@
 #ifndef DATABLOCK_H_
 #define DATABLOCK_H_
 
+#include <inttypes.h>
 #include <vector>
 
 #include "../../Datatype/Identifier.h"
@@ -26,6 +27,13 @@ public:
   // The data to be stored.
   vector<Word>& payload() const;
 
+  // Some readers (e.g. ELF) provide a view of raw words which is owned by the
+  // reader instead of a payload vector. This avoids building an intermediate
+  // copy of large programs. rawData() is NULL if the block has a payload.
+  const uint32_t* rawData() const;
+  size_t rawSize() const;
+  bool hasPayload() const;
+
   // The component (core or memory) to store the data in. A null ComponentID
   // signifies the background memory.
   ComponentID component() const;
@@ -36,15 +44,24 @@ public:
   // Marks whether this data may be changed by the program.
   bool readOnly() const;
 
-  DataBlock(vector<Word>* data, const ComponentID& component, int position, bool readOnly);
+  // Marks whether this data may contain instructions.
+  bool executable() const;
+
+  DataBlock(vector<Word>* data, const ComponentID& component, int position,
+            bool readOnly, bool executable=true);
+  DataBlock(const uint32_t* data, size_t words, const ComponentID& component,
+            int position, bool readOnly, bool executable=true);
   virtual ~DataBlock();
 
 private:
 
   vector<Word>* data_;
+  const uint32_t* raw_;
+  size_t rawSize_;
   ComponentID component_;
   int position_;
   bool readOnly_;
+  bool executable_;
 
 };
 
@@ -9,7 +9,12 @@
  *      Author: db434
  */
 
+#include <fcntl.h>
+#include <string.h>
 #include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "ELFFileReader.h"
 #include "../Debugger.h"
@@ -19,92 +24,147 @@
 #include "../../Datatype/Instruction.h"
 #include "../../Tile/Core/Core.h"
 
-vector<DataBlock>& ELFFileReader::extractData(int& mainPos) {
-  std::ifstream file(filename_.c_str());
+using std::cerr;
+using std::endl;
 
-  Elf32_Ehdr fileHeader;
-  Elf32_Shdr sectionHeader;
+vector<DataBlock>& ELFFileReader::extractData(int& mainPos) {
+  mapFile();
 
-  file.seekg(0, file.beg);
-  readFileHeader(file, fileHeader);
+  const Elf32_Ehdr& fileHeader = *(const Elf32_Ehdr*)mapping;
 
-  int numHeaders = fileHeader.e_shnum;
-  for (int i=0; i<numHeaders; i++) {
-    readSectionHeader(file, i, sectionHeader);
-    processSection(file, sectionHeader);
+  if (fileHeader.e_phnum > 0) {
+    for (int i=0; i<fileHeader.e_phnum; i++) {
+      Elf32_Off offset = fileHeader.e_phoff + fileHeader.e_phentsize*i;
+      assert(offset + sizeof(Elf32_Phdr) <= mappingSize);
+      processSegment(*(const Elf32_Phdr*)(mapping + offset));
+    }
+  }
+  else {
+    for (int i=0; i<fileHeader.e_shnum; i++) {
+      Elf32_Off offset = fileHeader.e_shoff + fileHeader.e_shentsize*i;
+      assert(offset + sizeof(Elf32_Shdr) <= mappingSize);
+      processSection(*(const Elf32_Shdr*)(mapping + offset));
+    }
   }
-
-  file.close();
 
   return dataToLoad;
 }
 
-void ELFFileReader::readFileHeader(std::ifstream& file, Elf32_Ehdr& fileHeader) const {
-  file.seekg(0, file.beg);
-  file.read((char*)&fileHeader, sizeof(Elf32_Ehdr));
-}
+void ELFFileReader::mapFile() {
+  if (mapping != NULL)
+    return;
 
-void ELFFileReader::readSectionHeader(std::ifstream& file, int sectionNumber, Elf32_Shdr& sectionHeader) const {
-  Elf32_Ehdr fileHeader;
-  readFileHeader(file, fileHeader);
-  int numSections = fileHeader.e_shnum;
+  int fd = open(filename_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    cerr << "Error: unable to open ELF file " << filename_ << endl;
+    throw std::exception();
+  }
 
-  assert(sectionNumber <= numSections);
-  assert(sectionNumber >= 0);
+  struct stat fileInfo;
+  if (fstat(fd, &fileInfo) < 0) {
+    close(fd);
+    cerr << "Error: unable to read size of ELF file " << filename_ << endl;
+    throw std::exception();
+  }
+
+  if ((size_t)fileInfo.st_size < sizeof(Elf32_Ehdr)) {
+    close(fd);
+    cerr << "Error: " << filename_ << " is too small to be an ELF file" << endl;
+    throw std::exception();
+  }
+
+  void* address = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
 
-  uint offset = fileHeader.e_shoff + fileHeader.e_shentsize*sectionNumber;
-  file.seekg(offset, file.beg);
-  file.read((char*)&sectionHeader, sizeof(Elf32_Shdr));
+  if (address == MAP_FAILED) {
+    cerr << "Error: unable to map ELF file " << filename_ << endl;
+    throw std::exception();
+  }
+
+  mapping = (const char*)address;
+  mappingSize = fileInfo.st_size;
 }
 
-void ELFFileReader::processSection(std::ifstream& file, Elf32_Shdr& sectionHeader) {
+void ELFFileReader::processSegment(const Elf32_Phdr& programHeader) {
+  // Only loadable segments with data in the file are of interest. Any
+  // remaining part of the segment (p_memsz > p_filesz) is zero-initialised,
+  // and main memory is already zeroed.
+  if (programHeader.p_type != PT_LOAD || programHeader.p_filesz == 0)
+    return;
+
+  addBlock(programHeader.p_offset, programHeader.p_filesz, programHeader.p_vaddr,
+           !(programHeader.p_flags & PF_W), programHeader.p_flags & PF_X);
+}
+
+void ELFFileReader::processSection(const Elf32_Shdr& sectionHeader) {
   // We are only interested in sections to be loaded into memory.
   if ((sectionHeader.sh_flags & SHF_ALLOC) &&   // Alloc = put in memory
       (sectionHeader.sh_type != SHT_NOBITS)) {  // No bits = data not in ELF
+    addBlock(sectionHeader.sh_offset, sectionHeader.sh_size, sectionHeader.sh_addr,
+             !(sectionHeader.sh_flags & SHF_WRITE),
+             sectionHeader.sh_flags & SHF_EXECINSTR);
+  }
+}
 
-    int size = sectionHeader.sh_size;
-    int position = sectionHeader.sh_addr;
-    int offset = sectionHeader.sh_offset;
-
-    // Seek to the start of the segment.
-    file.seekg(offset, file.beg);
+void ELFFileReader::addBlock(Elf32_Off offset, Elf32_Word size,
+                             Elf32_Addr position, bool readOnly,
+                             bool executable) {
+  assert(offset + size <= mappingSize);
 
-    vector<Word>* data = new vector<Word>();
+  const uint32_t* data = (const uint32_t*)(mapping + offset);
+  size_t words = size / BYTES_PER_WORD;
+  size_t tailBytes = size % BYTES_PER_WORD;
 
-    if (sectionHeader.sh_flags & SHF_EXECINSTR) { // Executable section
-      for (int i=0; i<size; i+=BYTES_PER_WORD) {
-        Instruction inst = nextWord(file);
-        data->push_back(inst);
+  if (executable && Debugger::mode == Debugger::DEBUGGER) {
+    for (size_t i=0; i<words; i++)
+      printInstruction(Instruction(Word(data[i])), position + i*BYTES_PER_WORD);
+  }
 
-        if (Debugger::mode == Debugger::DEBUGGER)
-          printInstruction(inst, position+i);
-      }
-    }
-    else {
-      for (int i=0; i<size; i+=BYTES_PER_WORD) {
-        Word w = nextWord(file);
-        data->push_back(w);
-      }
+  // Any partial word at the end must not be read straight from the mapping:
+  // the bytes after it belong to something else (or the end of the file).
+  uint32_t tail = 0;
+  if (tailBytes > 0)
+    memcpy(&tail, data + words, tailBytes);
+
+  if (componentID_ == ComponentID(2,0,0)) {
+    // Put this data into a particular position in memory. The block refers
+    // directly to the mapped file, so nothing is copied until the data
+    // reaches its destination.
+    if (words > 0)
+      dataToLoad.push_back(DataBlock(data, words, componentID_, position,
+                                     readOnly, executable));
+
+    if (tailBytes > 0) {
+      vector<Word>* last = new vector<Word>(1, Word(tail));
+      dataToLoad.push_back(DataBlock(last, componentID_,
+                                     position + words*BYTES_PER_WORD,
+                                     readOnly, executable));
     }
-
-    bool readOnly = !(sectionHeader.sh_flags & SHF_WRITE);
-
-    // Put these instructions into a particular position in memory.
-    dataToLoad.push_back(DataBlock(data, componentID_, position, readOnly));
   }
-}
-
-Word ELFFileReader::nextWord(std::ifstream& file) const {
-  uint32_t result;
-  file.read((char*)&result, 4);
-  return Word(result);
+  else {
+    // Only main memory accepts raw blocks. Cores and other components are
+    // given a copy of the data.
+    vector<Word>* payload = new vector<Word>(data, data + words);
+    if (tailBytes > 0)
+      payload->push_back(Word(tail));
+
+    dataToLoad.push_back(DataBlock(payload, componentID_, position, readOnly,
+                                   executable));
+  }
 }
 
 ELFFileReader::ELFFileReader(const std::string& filename, const ComponentID& memory,
                              const ComponentID& core, const MemoryAddr location) :
     FileReader(filename, memory, location),
-    core_(core) {
+    core_(core),
+    mapping(NULL),
+    mappingSize(0) {
 
   // Do nothing
 
 }
+
+ELFFileReader::~ELFFileReader() {
+  if (mapping != NULL)
+    munmap((void*)mapping, mappingSize);
+}
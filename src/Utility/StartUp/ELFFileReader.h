@@ -27,21 +27,33 @@ public:
   ELFFileReader(const std::string& filename, const ComponentID& memory,
                 const ComponentID& core, const MemoryAddr location);
 
-  virtual ~ELFFileReader() {}
+  virtual ~ELFFileReader();
 
 private:
 
-  // Get the next word from the file.
-  Word nextWord(std::ifstream& file) const;
+  // Map the whole file into the host's address space. The mapping lives until
+  // this reader is destroyed, so the DataBlocks produced can point into it.
+  void mapFile();
 
-  void readFileHeader(std::ifstream& file, Elf32_Ehdr& fileHeader) const;
-  void readSectionHeader(std::ifstream& file, int sectionNumber, Elf32_Shdr& sectionHeader) const;
-  void processSection(std::ifstream& file, Elf32_Shdr& sectionHeader);
+  // Load everything described by the program headers (PT_LOAD segments).
+  void processSegment(const Elf32_Phdr& programHeader);
+
+  // Fall back to section headers for files without program headers (e.g.
+  // unlinked object files).
+  void processSection(const Elf32_Shdr& sectionHeader);
+
+  // Add a block of data from the file to the list of things to load.
+  void addBlock(Elf32_Off offset, Elf32_Word size, Elf32_Addr position,
+                bool readOnly, bool executable);
 
   // The core which will execute this program needs to be given a small loader
   // program.
   const ComponentID core_;
 
+  // Contents of the file.
+  const char* mapping;
+  size_t      mappingSize;
+
 };
 
 #endif /* ELFFILEREADER_H_ */
@@ -0,0 +1,230 @@
+/*
+ * MemoryTrace.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#include "MemoryTrace.h"
+#include "../Instrumentation.h"
+#include "../Logging.h"
+
+#include <algorithm>
+
+using std::endl;
+
+// The final byte of the magic string is the format version. Bump it whenever
+// the record layout or the flattened metadata changes.
+// Version 2: Flit metadata's returnChannel widened to 4 bits.
+static const char traceMagic[8] = {'L','O','K','I','M','E','M','2'};
+static const size_t recordBytes = 24;
+
+bool                                     MemoryTrace::capturing_ = false;
+bool                                     MemoryTrace::replaying_ = false;
+std::ofstream*                           MemoryTrace::log = NULL;
+std::map<uint, MemoryTrace::CoreState>   MemoryTrace::cores;
+std::map<uint, vector<MemoryTrace::Record>> MemoryTrace::streams;
+
+bool MemoryTrace::Record::isHead() const {
+  MemoryOpcode op = memoryMetadata().opcode;
+  return (op != PAYLOAD) && (op != PAYLOAD_EOP);
+}
+
+void MemoryTrace::startCapture(const string& filename) {
+  log = new std::ofstream(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!log->good()) {
+    LOKI_ERROR << "unable to open memory trace file " << filename << endl;
+    delete log;
+    log = NULL;
+    return;
+  }
+
+  log->write(traceMagic, sizeof(traceMagic));
+  capturing_ = true;
+}
+
+void MemoryTrace::endTrace() {
+  if (!capturing_)
+    return;
+
+  log->close();
+  delete log;
+  log = NULL;
+
+  capturing_ = false;
+  cores.clear();
+}
+
+bool MemoryTrace::capturing() {
+  return capturing_;
+}
+
+void MemoryTrace::requestArrived(const ComponentID& bank, const Flit<Word>& flit) {
+  if (!capturing_)
+    return;
+
+  // In the core-to-memory network, the channel of a flit is the position of the
+  // core which sent it.
+  ComponentID requester(bank.tile, flit.channelID().channel);
+  CoreState& core = cores[key(requester)];
+  cycle_count_t now = Instrumentation::currentCycle();
+
+  Record record;
+  record.cycle = now;
+  record.payload = flit.payload().toUInt();
+  record.metadata = flit.getRawMetadata();
+  record.tileX = bank.tile.x;
+  record.tileY = bank.tile.y;
+  record.core = requester.position;
+  record.bank = bank.position;
+  record.dependence = 0;
+  record.delay = 0;
+
+  if (record.isHead()) {
+    core.requests++;
+
+    cycle_count_t ready = core.lastRequest;
+    count_t distance = core.requests - core.lastCompleted;
+    if (core.lastCompleted > 0 && distance <= 0xFFFF) {
+      record.dependence = distance;
+      ready = std::max(ready, core.lastCompletion);
+    }
+    record.delay = std::min<cycle_count_t>(now - ready, 0xFFFF);
+
+    core.lastRequest = now;
+
+    MemoryMetadata metadata = record.memoryMetadata();
+    if (expectsResponse(metadata.opcode))
+      core.outstanding[metadata.returnChannel].push_back(core.requests);
+  }
+
+  writeRecord(record);
+}
+
+void MemoryTrace::responseSent(const Flit<Word>& flit) {
+  if (!capturing_ || !flit.getMetadata().endOfPacket)
+    return;
+
+  CoreState& core = cores[key(flit.channelID().component)];
+  std::deque<count_t>& waiting = core.outstanding[flit.channelID().channel];
+
+  // Responses to a single channel are returned in order.
+  if (waiting.empty())
+    return;
+
+  core.lastCompleted = waiting.front();
+  core.lastCompletion = Instrumentation::currentCycle();
+  waiting.pop_front();
+}
+
+void MemoryTrace::loadReplay(const string& filename) {
+  std::ifstream input(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!input.good()) {
+    LOKI_ERROR << "unable to open memory trace file " << filename << endl;
+    return;
+  }
+
+  char magic[sizeof(traceMagic)];
+  input.read(magic, sizeof(magic));
+  if (!input.good() || !std::equal(magic, magic + sizeof(magic) - 1, traceMagic)) {
+    LOKI_ERROR << filename << " is not a memory trace" << endl;
+    return;
+  }
+  else if (magic[sizeof(magic) - 1] != traceMagic[sizeof(traceMagic) - 1]) {
+    LOKI_ERROR << filename << " uses memory trace format version "
+        << magic[sizeof(magic) - 1] << ", but only version "
+        << traceMagic[sizeof(traceMagic) - 1] << " is supported" << endl;
+    return;
+  }
+
+  count_t numRecords = 0;
+  Record record;
+  while (readRecord(input, record)) {
+    ComponentID core(record.tileX, record.tileY, record.core);
+    streams[key(core)].push_back(record);
+    numRecords++;
+  }
+
+  if (numRecords == 0)
+    LOKI_WARN << "memory trace " << filename << " is empty" << endl;
+
+  replaying_ = true;
+}
+
+bool MemoryTrace::replaying() {
+  return replaying_;
+}
+
+const vector<MemoryTrace::Record>& MemoryTrace::replayStream(const ComponentID& core) {
+  return streams[key(core)];
+}
+
+bool MemoryTrace::expectsResponse(MemoryOpcode opcode) {
+  switch (opcode) {
+    case LOAD_W:
+    case LOAD_LINKED:
+    case LOAD_HW:
+    case LOAD_B:
+    case FETCH_LINE:
+    case IPK_READ:
+    case STORE_CONDITIONAL:
+    case LOAD_AND_ADD:
+    case LOAD_AND_OR:
+    case LOAD_AND_AND:
+    case LOAD_AND_XOR:
+    case EXCHANGE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+uint MemoryTrace::key(const ComponentID& core) {
+  return (core.tile.x << 16) | (core.tile.y << 8) | core.position;
+}
+
+void MemoryTrace::writeRecord(const Record& record) {
+  uint8_t buffer[recordBytes];
+
+  for (uint i=0; i<8; i++)
+    buffer[i] = (record.cycle >> (i*8)) & 0xFF;
+  for (uint i=0; i<4; i++) {
+    buffer[8+i] = (record.payload >> (i*8)) & 0xFF;
+    buffer[12+i] = (record.metadata >> (i*8)) & 0xFF;
+  }
+  buffer[16] = record.tileX;
+  buffer[17] = record.tileY;
+  buffer[18] = record.core;
+  buffer[19] = record.bank;
+  for (uint i=0; i<2; i++) {
+    buffer[20+i] = (record.dependence >> (i*8)) & 0xFF;
+    buffer[22+i] = (record.delay >> (i*8)) & 0xFF;
+  }
+
+  log->write(reinterpret_cast<const char*>(buffer), recordBytes);
+}
+
+bool MemoryTrace::readRecord(std::istream& is, Record& record) {
+  uint8_t buffer[recordBytes];
+  is.read(reinterpret_cast<char*>(buffer), recordBytes);
+  if ((size_t)is.gcount() != recordBytes)
+    return false;
+
+  record.cycle = 0;
+  for (uint i=0; i<8; i++)
+    record.cycle |= (cycle_count_t)buffer[i] << (i*8);
+  record.payload = 0;
+  record.metadata = 0;
+  for (uint i=0; i<4; i++) {
+    record.payload |= (uint32_t)buffer[8+i] << (i*8);
+    record.metadata |= (uint32_t)buffer[12+i] << (i*8);
+  }
+  record.tileX = buffer[16];
+  record.tileY = buffer[17];
+  record.core = buffer[18];
+  record.bank = buffer[19];
+  record.dependence = buffer[20] | (buffer[21] << 8);
+  record.delay = buffer[22] | (buffer[23] << 8);
+
+  return true;
+}
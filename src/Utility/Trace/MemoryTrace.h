@@ -0,0 +1,134 @@
+/*
+ * MemoryTrace.h
+ *
+ * Capture and replay of all traffic from cores to their local memory banks.
+ *
+ * A binary trace holds one fixed-size record for every flit which enters a
+ * memory bank's input queue from a core. Head flits also record which earlier
+ * request (if any) the core was waiting for before it sent this one, and how
+ * long after that it waited. This allows a replay to preserve the dependencies
+ * between requests even when memory latencies change.
+ *
+ * A request's dependence is the most recent request from the same core whose
+ * response had completed by the time the new request arrived. This is a
+ * conservative approximation of the true data dependencies in the program.
+ *
+ * File format: an 8 byte magic string whose final character is the format
+ * version, followed by 24 byte little-endian records:
+ *   cycle       (8 bytes) cycle on which the flit arrived at memory
+ *   payload     (4 bytes) address (head flit) or data (payload flit)
+ *   metadata    (4 bytes) flattened MemoryMetadata, including the opcode
+ *   tile x, y   (1 byte each)
+ *   core        (1 byte)  position of requesting core in its tile
+ *   bank        (1 byte)  position of memory bank in its tile
+ *   dependence  (2 bytes) number of requests back to the one this request
+ *                         waited for, or 0 for none
+ *   delay       (2 bytes) cycles between the later of the dependence
+ *                         completing and the previous request, and this one
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: db434
+ */
+
+#ifndef SRC_UTILITY_TRACE_MEMORYTRACE_H_
+#define SRC_UTILITY_TRACE_MEMORYTRACE_H_
+
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "../../Datatype/Flit.h"
+#include "../../Datatype/Identifier.h"
+#include "../../Datatype/Word.h"
+#include "../../Types.h"
+
+using std::string;
+using std::vector;
+
+class MemoryTrace {
+
+public:
+
+  // One flit sent from a core to a memory bank.
+  struct Record {
+    cycle_count_t cycle;
+    uint32_t      payload;
+    uint32_t      metadata;
+    uint8_t       tileX;
+    uint8_t       tileY;
+    uint8_t       core;
+    uint8_t       bank;
+    uint16_t      dependence;
+    uint16_t      delay;
+
+    MemoryMetadata memoryMetadata() const {return MemoryMetadata(metadata);}
+    bool           isHead() const;
+  };
+
+private:
+
+  // Information needed to work out the dependencies of each core's requests.
+  struct CoreState {
+    count_t       requests;       // Number of head flits sent so far
+    cycle_count_t lastRequest;    // Arrival time of the latest request
+    count_t       lastCompleted;  // Latest request to receive its response
+    cycle_count_t lastCompletion; // Time at which that response completed
+
+    // Requests still waiting for responses, indexed by return channel.
+    std::map<ChannelIndex, std::deque<count_t>> outstanding;
+  };
+
+public:
+
+  // Open the named file and start recording all core-to-memory flits.
+  static void startCapture(const string& filename);
+
+  // Tidy up when execution has finished.
+  static void endTrace();
+
+  // Returns whether requestArrived and responseSent should be called.
+  static bool capturing();
+
+  // Record that a flit from a core arrived at the given memory bank.
+  static void requestArrived(const ComponentID& bank, const Flit<Word>& flit);
+
+  // Record that a memory bank sent a flit back to a core.
+  static void responseSent(const Flit<Word>& flit);
+
+  // Read the named trace so it can be replayed.
+  static void loadReplay(const string& filename);
+
+  // Returns whether cores are to be replaced by trace injectors.
+  static bool replaying();
+
+  // All flits sent by the given core in the replayed trace, in order.
+  static const vector<Record>& replayStream(const ComponentID& core);
+
+  // Returns whether a request with this opcode will receive a response from
+  // memory. Only these requests can form dependencies.
+  static bool expectsResponse(MemoryOpcode opcode);
+
+private:
+
+  static uint key(const ComponentID& core);
+
+  static void writeRecord(const Record& record);
+  static bool readRecord(std::istream& is, Record& record);
+
+private:
+
+  static bool capturing_;
+  static bool replaying_;
+
+  // The stream to write all records to.
+  static std::ofstream* log;
+
+  static std::map<uint, CoreState> cores;
+
+  // Flits to be replayed by each core.
+  static std::map<uint, vector<Record>> streams;
+
+};
+
+#endif /* SRC_UTILITY_TRACE_MEMORYTRACE_H_ */
@@ -11,6 +11,9 @@ bool WARN_INCOHERENCE = false;
 // address.
 bool WARN_READ_ONLY = true;
 
+// Warn when fetching instructions from a page marked no-execute.
+bool WARN_NO_EXECUTE = true;
+
 // Memory addresses which aren't aligned to a word/half-word boundary are
 // automatically rounded down by the memory bank.
 bool WARN_UNALIGNED = true;
@@ -19,6 +19,9 @@ extern bool WARN_INCOHERENCE;
 // address.
 extern bool WARN_READ_ONLY;
 
+// Warn when fetching instructions from a page marked no-execute.
+extern bool WARN_NO_EXECUTE;
+
 // Memory addresses which aren't aligned to a word/half-word boundary are
 // automatically rounded down by the memory bank.
 extern bool WARN_UNALIGNED;
@@ -41,12 +44,15 @@ inline void setWarning(const string& option) {
   if (name == "all") {
     WARN_INCOHERENCE = setting;
     WARN_READ_ONLY = setting;
+    WARN_NO_EXECUTE = setting;
     WARN_UNALIGNED = setting;
   }
   else if (name == "incoherence")
     WARN_INCOHERENCE = setting;
   else if (name == "read-only")
     WARN_READ_ONLY = setting;
+  else if (name == "no-execute")
+    WARN_NO_EXECUTE = setting;
   else if (name == "unaligned-memory")
     WARN_UNALIGNED = setting;
   else